@@ -73,6 +73,7 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
 #if DRIVE_SYSTEM!=3
     Printer::maxZJerk = MAX_ZJERK;
 #endif
+    Printer::junctionDeviation = JUNCTION_DEVIATION;
 #ifdef RAMP_ACCELERATION
     Printer::maxAccelerationMMPerSquareSecond[X_AXIS] = MAX_ACCELERATION_UNITS_PER_SQ_SECOND_X;
     Printer::maxAccelerationMMPerSquareSecond[Y_AXIS] = MAX_ACCELERATION_UNITS_PER_SQ_SECOND_Y;
@@ -319,6 +320,7 @@ void EEPROM::storeDataIntoEEPROM(uint8_t corrupted)
 #if DRIVE_SYSTEM!=3
     HAL::eprSetFloat(EPR_MAX_ZJERK,Printer::maxZJerk);
 #endif
+    HAL::eprSetFloat(EPR_JUNCTION_DEVIATION,Printer::junctionDeviation);
 #ifdef RAMP_ACCELERATION
     HAL::eprSetFloat(EPR_X_MAX_ACCEL,Printer::maxAccelerationMMPerSquareSecond[0]);
     HAL::eprSetFloat(EPR_Y_MAX_ACCEL,Printer::maxAccelerationMMPerSquareSecond[1]);
@@ -474,6 +476,7 @@ void EEPROM::readDataFromEEPROM()
 #if DRIVE_SYSTEM!=3
     Printer::maxZJerk = HAL::eprGetFloat(EPR_MAX_ZJERK);
 #endif
+    Printer::junctionDeviation = HAL::eprGetFloat(EPR_JUNCTION_DEVIATION);
 #ifdef RAMP_ACCELERATION
     Printer::maxAccelerationMMPerSquareSecond[0] = HAL::eprGetFloat(EPR_X_MAX_ACCEL);
     Printer::maxAccelerationMMPerSquareSecond[1] = HAL::eprGetFloat(EPR_Y_MAX_ACCEL);
@@ -592,6 +595,10 @@ void EEPROM::readDataFromEEPROM()
             HAL::eprSetFloat(EPR_DELTA_RADIUS_CORR_C,DELTA_RADIUS_CORRECTION_C);
         }
 #endif
+        if(version<7) {
+            HAL::eprSetFloat(EPR_JUNCTION_DEVIATION,JUNCTION_DEVIATION);
+            Printer::junctionDeviation = JUNCTION_DEVIATION;
+        }
         storeDataIntoEEPROM(false); // Store new fields for changed version
     }
     Printer::updateDerivedParameter();
@@ -684,6 +691,7 @@ void EEPROM::writeSettings()
 #if DRIVE_SYSTEM!=3
     writeFloat(EPR_MAX_ZJERK,Com::tEPRMaxZJerk);
 #endif
+    writeFloat(EPR_JUNCTION_DEVIATION,Com::tEPRJunctionDeviation);
     writeFloat(EPR_X_HOME_OFFSET,Com::tEPRXHomePos);
     writeFloat(EPR_Y_HOME_OFFSET,Com::tEPRYHomePos);
     writeFloat(EPR_Z_HOME_OFFSET,Com::tEPRZHomePos);
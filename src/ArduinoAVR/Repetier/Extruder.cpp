@@ -368,8 +368,12 @@ void Extruder::selectExtruderById(uint8_t extruderId)
         maxdist-= Extruder::current->maxStartFeedrate*Extruder::current->maxStartFeedrate*0.5/Extruder::current->maxAcceleration;
         //Printer::extruderAccelerateDelay = (uint8_t)constrain(ceil(maxdist*Extruder::current->stepsPerMM/(Printer::minExtruderSpeed-Printer::maxExtruderSpeed)),1,255);
     }
+#if FEATURE_BRESENHAM_ADVANCE
+    Printer::extruderLastDirection = 0; // direction pin of the new extruder is not known
+#else
     float fmax=((float)HAL::maxExtruderTimerFrequency()/((float)Printer::maxExtruderSpeed*Printer::axisStepsPerMM[E_AXIS])); // Limit feedrate to interrupt speed
     if(fmax<Printer::maxFeedrate[E_AXIS]) Printer::maxFeedrate[E_AXIS] = fmax;
+#endif
 #endif
     Extruder::current->tempControl.updateTempControlVars();
     float cx,cy,cz;
@@ -224,7 +224,7 @@ long HAL::CPUDivU2(unsigned int divisor)
 
 void HAL::setupTimer()
 {
-#if defined(USE_ADVANCE)
+#if defined(USE_ADVANCE) && !FEATURE_BRESENHAM_ADVANCE
     EXTRUDER_TCCR = 0; // need Normal not fastPWM set by arduino init
     EXTRUDER_TIMSK |= (1<<EXTRUDER_OCIE); // Activate compa interrupt on timer 0
 #endif
@@ -299,6 +299,60 @@ void HAL::resetHardware()
     resetFunc();
 }
 
+#if FEATURE_ENDSTOP_INTERRUPTS
+static void endstopInterrupt()
+{
+    Printer::updateEndstops();
+}
+
+/** Calls Printer::updateEndstops on every change of the pin. Uses the pin change interrupt of the
+pin or, if it has none, its external interrupt. Returns false if the pin can raise neither. */
+bool HAL::attachEndstopInterrupt(uint8_t pin)
+{
+#ifdef digitalPinToPCICR
+    if(digitalPinToPCICR(pin) != NULL)
+    {
+        *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+        *digitalPinToPCICR(pin) |= _BV(digitalPinToPCICRbit(pin));
+        return true;
+    }
+#endif
+#ifdef digitalPinToInterrupt
+    if(digitalPinToInterrupt(pin) != NOT_AN_INTERRUPT)
+    {
+        attachInterrupt(digitalPinToInterrupt(pin),endstopInterrupt,CHANGE);
+        return true;
+    }
+#endif
+    return false;
+}
+
+#ifdef PCINT0_vect
+ISR(PCINT0_vect)
+{
+    Printer::updateEndstops();
+}
+#endif
+#ifdef PCINT1_vect
+ISR(PCINT1_vect)
+{
+    Printer::updateEndstops();
+}
+#endif
+#ifdef PCINT2_vect
+ISR(PCINT2_vect)
+{
+    Printer::updateEndstops();
+}
+#endif
+#ifdef PCINT3_vect
+ISR(PCINT3_vect)
+{
+    Printer::updateEndstops();
+}
+#endif
+#endif // FEATURE_ENDSTOP_INTERRUPTS
+
 void HAL::analogStart()
 {
 #if ANALOG_INPUTS>0
@@ -678,10 +732,29 @@ ISR(TIMER1_COMPA_vect)
         :[ex]"=&d"(doExit):[ocr]"i" (_SFR_MEM_ADDR(OCR1A)):"r22","r23" );
     if(doExit) return;
     insideTimer1 = 1;
+#if FEATURE_ISR_PROFILER
+    // CTC mode resets TCNT1 at the compare match, so it holds the latency here and counts on until setTimer
+    uint16_t profileStart = TCNT1;
+#endif
     OCR1A = 61000;
     if(PrintLine::hasLines())
     {
+#if FEATURE_ISR_PROFILER
+#if FEATURE_STEP_BUFFER
+        unsigned long delay = PrintLine::executeStepEvents();
+#else
+        unsigned long delay = PrintLine::bresenhamStep();
+#endif
+        uint16_t profileEnd = TCNT1;
+        if(delay < 65280 && delay < (unsigned long)profileEnd + 100) // setTimer has to move the compare
+            Commands::stepperProfile.late++;
+        Commands::stepperProfile.add(profileEnd - profileStart,profileStart);
+        setTimer(delay);
+#elif FEATURE_STEP_BUFFER
+        setTimer(PrintLine::executeStepEvents());
+#else
         setTimer(PrintLine::bresenhamStep());
+#endif
     }
     else
     {
@@ -705,7 +778,12 @@ ISR(TIMER1_COMPA_vect)
         }
         else waitRelax--;
         stepperWait = 0; // Importent becaus of optimization in asm at begin
-        OCR1A = 65500; // Wait for next move
+#if FEATURE_BRESENHAM_ADVANCE
+        unsigned int advanceWait = PrintLine::idleAdvanceStep();
+        if(advanceWait) setTimer(advanceWait);
+        else
+#endif
+            OCR1A = 65500; // Wait for next move
     }
     DEBUG_MEMORY;
     insideTimer1 = 0;
@@ -719,6 +797,10 @@ ISR(PWM_TIMER_VECTOR)
     static uint8_t pwm_count = 0;
     static uint8_t pwm_pos_set[NUM_EXTRUDER+3];
     static uint8_t pwm_cooler_pos_set[NUM_EXTRUDER];
+#if FEATURE_ISR_PROFILER
+    uint16_t profileStart = TCNT1;
+    uint8_t profileLatency = PWM_TCNT - PWM_OCR; // in timer 0 ticks of 64 cycles
+#endif
     PWM_OCR += 64;
     if(pwm_count==0)
     {
@@ -860,8 +942,14 @@ ISR(PWM_TIMER_VECTOR)
 
     UI_FAST; // Short timed user interface action
     pwm_count++;
+#if FEATURE_ISR_PROFILER
+    uint16_t profileEnd = TCNT1;
+    uint16_t profileTicks = profileEnd - profileStart;
+    if(profileEnd < profileStart) profileTicks += OCR1A + 1; // timer 1 reached its compare value and restarted
+    Commands::pwmProfile.add(profileTicks,(uint32_t)profileLatency << 6);
+#endif
 }
-#if defined(USE_ADVANCE)
+#if defined(USE_ADVANCE) && !FEATURE_BRESENHAM_ADVANCE
 
 /** \brief Timer routine for extruder stepper.
 
@@ -75,6 +75,19 @@ All known arduino boards use 64. This value is needed for the extruder timing. *
 #endif
 #if CPU_ARCH==ARCH_AVR
 #include "fastio.h"
+/* Step port for FEATURE_STEP_PORT_MASKS: the port of Y_STEP_PIN if Y and Z share a port without X,
+   otherwise the port of X_STEP_PIN. All comparisons are constant, so STEP_PORT_MASK compiles to
+   the pin mask or 0 for pins on other ports. */
+#define _STEP_PIN_PORT(IO) DIO ## IO ## _WPORT
+#define STEP_PIN_PORT(IO) _STEP_PIN_PORT(IO)
+#define _STEP_PIN_MASK(IO) MASK(DIO ## IO ## _PIN)
+#define STEP_PIN_MASK(IO) _STEP_PIN_MASK(IO)
+#define STEP_PORT (&STEP_PIN_PORT(Y_STEP_PIN) == &STEP_PIN_PORT(Z_STEP_PIN) && &STEP_PIN_PORT(Y_STEP_PIN) != &STEP_PIN_PORT(X_STEP_PIN) ? \
+                   STEP_PIN_PORT(Y_STEP_PIN) : STEP_PIN_PORT(X_STEP_PIN))
+#define STEP_PORT_MASK(IO) (&STEP_PIN_PORT(IO) == &STEP_PORT ? STEP_PIN_MASK(IO) : 0)
+#define STEP_PORT_SET(mask) STEP_PORT |= (mask)
+#define STEP_PORT_CLEAR(mask) STEP_PORT &= ~(mask)
+typedef uint8_t step_port_t;
 #else
 #define	READ(IO)  digitalRead(IO)
 #define	WRITE(IO, v)  digitalWrite(IO, v)
@@ -85,6 +98,8 @@ All known arduino boards use 64. This value is needed for the extruder timing. *
 #define BEGIN_INTERRUPT_PROTECTED {uint8_t sreg=SREG;__asm volatile( "cli" ::: "memory" );
 #define END_INTERRUPT_PROTECTED SREG=sreg;}
 #define ESCAPE_INTERRUPT_PROTECTED SREG=sreg;
+// FEATURE_ISR_PROFILER counts timer 1 ticks, which run at cpu clock
+#define ISR_PROFILER_TICKS_PER_US (F_CPU/1000000)
 
 #define EEPROM_OFFSET               0
 #define SECONDS_TO_TICKS(s) (unsigned long)(s*(float)F_CPU)
@@ -106,8 +121,6 @@ typedef unsigned int speed_t;
 typedef unsigned long ticks_t;
 typedef unsigned long millis_t;
 
-#define FAST_INTEGER_SQRT
-
 #ifndef EXTERNALSERIAL
 // Implement serial communication for one stream only!
 /*
@@ -511,6 +524,10 @@ public:
     {
         return millis();
     }
+    static inline unsigned long timeInMicroseconds()
+    {
+        return micros();
+    }
     static inline char readFlashByte(PGM_P ptr)
     {
         return pgm_read_byte(ptr);
@@ -535,10 +552,22 @@ public:
     {
         RFSERIAL.flush();
     }
+    /** Bytes that can be written without waiting for the UART. */
+    static inline int serialOutputUnused()
+    {
+#ifndef EXTERNALSERIAL
+        return RFSERIAL.outputUnused()-1; // a full ring buffer keeps one entry free
+#else
+        return 255; // unknown
+#endif
+    }
     static void setupTimer();
     static void showStartReason();
     static int getFreeRam();
     static void resetHardware();
+#if FEATURE_ENDSTOP_INTERRUPTS
+    static bool attachEndstopInterrupt(uint8_t pin);
+#endif
 
     // SPI related functions
     static void spiBegin()
@@ -678,6 +707,7 @@ private:
 #define EXTRUDER_OCIE OCIE2A
 #define PWM_TIMER_VECTOR TIMER2_COMPB_vect
 #define PWM_OCR OCR2B
+#define PWM_TCNT TCNT2
 #define PWM_TCCR TCCR2B
 #define PWM_TIMSK TIMSK2
 #define PWM_OCIE OCIE2B
@@ -689,6 +719,7 @@ private:
 #define EXTRUDER_OCIE OCIE0A
 #define PWM_TIMER_VECTOR TIMER0_COMPB_vect
 #define PWM_OCR OCR0B
+#define PWM_TCNT TCNT0
 #define PWM_TCCR TCCR0A
 #define PWM_TIMSK TIMSK0
 #define PWM_OCIE OCIE0B
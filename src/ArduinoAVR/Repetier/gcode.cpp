@@ -27,7 +27,26 @@
 #define FEATURE_CHECKSUM_FORCED false
 #endif
 
+#if FEATURE_PROTOCOL_V3
+#if PROTOCOL_V3_FRAME_SIZE > 255
+#error PROTOCOL_V3_FRAME_SIZE must not exceed 255 bytes
+#endif
+#define BINARY_FRAME_MARKER 0x2080 // bit 7 and Ext, no other bits
+#endif
+
+#if FEATURE_COMPACT_COMMAND_BUFFER
+#if GCODE_RING_SIZE > 256
+#error GCODE_RING_SIZE must not exceed 256 bytes
+#endif
+uint8_t  GCode::commandRing[GCODE_RING_SIZE]; ///< Buffered commands with only the parameters they have.
+uint16_t GCode::commandRingUsed=0; ///< Bytes used in commandRing.
+GCode    GCode::commandReceived; ///< Command the parser fills.
+GCode    GCode::commandExecuted; ///< Decoded oldest command of commandRing.
+bool     GCode::commandDecoded=false; ///< commandExecuted holds the oldest command.
+uint16_t GCode::commandRecordMean=COMPACT_COMMAND_MAX_SIZE<<4; ///< Mean size of the stored records in 1/16 bytes, rounded up.
+#else
 GCode    GCode::commandsBuffered[GCODE_BUFFER_SIZE]; ///< Buffer for received commands.
+#endif
 uint8_t  GCode::bufferReadIndex=0; ///< Read position in gcode_buffer.
 uint8_t  GCode::bufferWriteIndex=0; ///< Write position in gcode_buffer.
 uint8_t  GCode::commandReceiving[MAX_CMD_SIZE]; ///< Current received command.
@@ -43,6 +62,9 @@ int8_t   GCode::waitingForResend=-1; ///< Waiting for line to be resend. -1 = no
 volatile uint8_t GCode::bufferLength=0; ///< Number of commands stored in gcode_buffer
 millis_t GCode::timeOfLastDataPacket=0; ///< Time, when we got the last data packet. Used to detect missing uint8_ts.
 uint8_t  GCode::formatErrors=0;
+#if FEATURE_PROTOCOL_V3
+uint8_t  GCode::freeBuffersReported=255; ///< Free command buffers sent with the last frame ok, 255 = host does not use frames.
+#endif
 
 /** \page Repetier-protocol
 
@@ -63,6 +85,9 @@ all implemented features.
   uses Fletchers checksum, which overcomes these shortcommings.
 - The new protocol send data in binary format. This reduces the data size to less then 50% and
   it speeds up decoding the command. No slow conversion from string to floats are needed.
+- With FEATURE_PROTOCOL_V3 several binary commands can be sent in one frame with one checksum.
+  Frames are acknowledged together and the host may send more frames before the ok arrives,
+  as long as the free command buffers reported with the ok are not exceeded. See GCode::parseFrame.
 
 */
 
@@ -137,7 +162,7 @@ void GCode::requestResend()
     else
         waitingForResend = 14;
     Com::println();
-    Com::printFLN(Com::tResend,lastLineNumber+1);
+    Com::printFLN(Com::tResend,(unsigned long)(lastLineNumber+1));
     Com::printFLN(Com::tOk);
 }
 /**
@@ -175,8 +200,8 @@ void GCode::checkAndPushCommand()
             {
                 if(Printer::debugErrors())
                 {
-                    Com::printF(Com::tExpectedLine,lastLineNumber+1);
-                    Com::printFLN(Com::tGot,actLineNumber);
+                    Com::printF(Com::tExpectedLine,(unsigned long)(lastLineNumber+1));
+                    Com::printFLN(Com::tGot,(unsigned long)actLineNumber);
                 }
                 requestResend(); // Line missing, force resend
             }
@@ -184,7 +209,7 @@ void GCode::checkAndPushCommand()
             {
                 --waitingForResend;
                 commandsReceivingWritePosition = 0;
-                Com::printFLN(Com::tSkip,actLineNumber);
+                Com::printFLN(Com::tSkip,(unsigned long)actLineNumber);
                 Com::printFLN(Com::tOk);
             }
             return;
@@ -192,17 +217,329 @@ void GCode::checkAndPushCommand()
         lastLineNumber = actLineNumber;
     }
     pushCommand();
-#ifdef ACK_WITH_LINENUMBER
-    Com::printFLN(Com::tOkSpace,actLineNumber);
+#if FEATURE_EXTENDED_OK
+    if(hasN())
+        Com::printF(Com::tOkN,(unsigned long)actLineNumber);
+    else
+        Com::printF(Com::tOk);
+    Com::printF(Com::tSpaceP,(int)(MOVE_CACHE_SIZE-PrintLine::linesCount));
+    Com::printFLN(Com::tSpaceB,(int)announcedCommandBuffers());
+#elif defined(ACK_WITH_LINENUMBER)
+    Com::printFLN(Com::tOkSpace,(unsigned long)actLineNumber);
 #else
     Com::printFLN(Com::tOk);
 #endif
     wasLastCommandReceivedAsBinary = sendAsBinary;
     waitingForResend = -1; // everything is ok.
+#if FEATURE_PROTOCOL_V3
+    freeBuffersReported = 255; // host sends single commands again
+#endif
+}
+#if FEATURE_PROTOCOL_V3
+/** \brief Checks a received version 3 frame and stores its commands.
+
+Frame layout:
+- Bitfield 0x2080 (bit 7 and Ext set, all others cleared)
+- 8 bit number of commands
+- 16 bit line number of the first command
+- 8 bit payload length
+- The commands in binary format without line number and checksum
+- 16 bit fletcher-16 checksum over all bytes before
+
+Commands have consecutive line numbers. A command with a string is only allowed as last command of a
+frame, because its terminator overwrites the checksum. All commands are stored or none, then one
+"ok N<last line> B<free command buffers>" acknowledges the frame. A host must not have more lines in transit
+after the acknowledged line than B. A frame that does not continue with the next expected line, fails the
+checksum or does not fit into the free buffers is answered with a resend request for the next expected line.
+*/
+void GCode::parseFrame()
+{
+    uint8_t count = commandReceiving[2];
+    uint16_t firstLine = *(uint16_t*)(commandReceiving+3);
+    if(!checkFletcher16(commandReceiving,binaryCommandSize-2))
+    {
+        if(Printer::debugErrors())
+        {
+            Com::printErrorFLN(Com::tWrongChecksum);
+        }
+        requestResend();
+        return;
+    }
+    if(((lastLineNumber+1) & 0xffff)!=firstLine)
+    {
+        if(waitingForResend<0)
+        {
+            if(Printer::debugErrors())
+            {
+                Com::printF(Com::tExpectedLine,(unsigned long)(lastLineNumber+1));
+                Com::printFLN(Com::tGot,(unsigned long)firstLine);
+            }
+            requestResend();
+        }
+        return; // sent before our resend request arrived
+    }
+    uint8_t *end = commandReceiving+binaryCommandSize-2;
+    uint8_t *p = commandReceiving+6;
+    uint8_t i;
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    uint16_t bytes = 0; // Size of the records in commandRing
+#endif
+    for(i=0; i<count && p<end; i++)
+    {
+        uint16_t bitfield = *(uint16_t*)p;
+        if((bitfield & 0x2081)!=128 || ((bitfield & 32768) && i+1<count)) break;
+#if FEATURE_COMPACT_COMMAND_BUFFER
+        bytes += compactSize(bitfield | 1,(bitfield & 4096) ? *(uint16_t*)(p+2) : 0);
+#endif
+        p += computeBinarySize((char*)p)-2;
+    }
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    if(count==0 || i<count || p!=end || bytes>GCODE_RING_SIZE-commandRingUsed)
+#else
+    if(count==0 || i<count || p!=end || count>freeCommandBuffers())
+#endif
+    {
+        if(Printer::debugErrors())
+        {
+            Com::printErrorFLN(Com::tFormatError);
+        }
+        requestResend();
+        return;
+    }
+    p = commandReceiving+6;
+    for(i=0; i<count; i++)
+    {
+        GCode *act = receivedCommand();
+        uint8_t size = computeBinarySize((char*)p)-2;
+        act->decodeBinary(p);
+        p += size;
+        act->params |= 1;
+        actLineNumber = act->N = (uint16_t)(firstLine+i);
+        if(act->hasM())
+        {
+            if(act->M==112)   // Emergency kill - freeze printer
+                Commands::emergencyStop();
+            if(act->M==110) continue; // Line numbers are already consecutive
+        }
+        pushCommand();
+    }
+    lastLineNumber = actLineNumber;
+    formatErrors = 0;
+    wasLastCommandReceivedAsBinary = 1;
+    waitingForResend = -1;
+    sendFrameAck();
+}
+/** \brief Acknowledges all lines up to the last received with the number of free command buffers.
+
+Also sent again without a new frame when buffers got free, because a host that used up its window
+waits for it. With FEATURE_EXTENDED_OK the free moves are sent as P like in the extended ok.
+*/
+void GCode::sendFrameAck()
+{
+    freeBuffersReported = announcedCommandBuffers();
+    Com::printF(Com::tOkN,(unsigned long)lastLineNumber);
+#if FEATURE_EXTENDED_OK
+    Com::printF(Com::tSpaceP,(int)(MOVE_CACHE_SIZE-PrintLine::linesCount));
+#endif
+    Com::printFLN(Com::tSpaceB,(int)freeBuffersReported);
+}
+#endif
+#if FEATURE_COMPACT_COMMAND_BUFFER
+/** \brief Writes length, bitfields and the parameters the command has to p.
+
+Returns the length, which is at most COMPACT_COMMAND_MAX_SIZE. A string stays in the receive buffer,
+only the pointer to it is stored.
+*/
+uint8_t GCode::encodeCompact(uint8_t *p)
+{
+    uint8_t *start = p++;
+    *(uint16_t *)p = params;
+    p+=2;
+    *(uint16_t *)p = params2;
+    p+=2;
+    if(hasN())
+    {
+        *(uint16_t *)p = N;
+        p+=2;
+    }
+    if(hasM())
+    {
+        *(uint16_t *)p = M;
+        p+=2;
+    }
+    if(hasG())
+    {
+        *(uint16_t *)p = G;
+        p+=2;
+    }
+    if(hasX())
+    {
+        *(float *)p = X;
+        p+=4;
+    }
+    if(hasY())
+    {
+        *(float *)p = Y;
+        p+=4;
+    }
+    if(hasZ())
+    {
+        *(float *)p = Z;
+        p+=4;
+    }
+    if(hasE())
+    {
+        *(float *)p = E;
+        p+=4;
+    }
+    if(hasF())
+    {
+        *(float *)p = F;
+        p+=4;
+    }
+    if(hasT())
+        *p++ = T;
+    if(hasS())
+    {
+        *(int32_t *)p = S;
+        p+=4;
+    }
+    if(hasP())
+    {
+        *(int32_t *)p = P;
+        p+=4;
+    }
+    if(hasI())
+    {
+        *(float *)p = I;
+        p+=4;
+    }
+    if(hasJ())
+    {
+        *(float *)p = J;
+        p+=4;
+    }
+    if(hasR())
+    {
+        *(float *)p = R;
+        p+=4;
+    }
+    if(hasString())
+    {
+        memcpy(p,&text,sizeof(char*));
+        p+=sizeof(char*);
+    }
+    return (*start = p-start);
+}
+/** \brief Returns the length encodeCompact writes for a command with these bitfields. */
+uint8_t GCode::compactSize(uint16_t params,uint16_t params2)
+{
+    uint8_t size = 5; // length and bitfields
+    if(params & 1) size += 2; // N
+    if(params & 2) size += 2; // M
+    if(params & 4) size += 2; // G
+    if(params & 512) size++; // T
+    for(uint16_t bit=8; bit<=2048; bit<<=1) // X Y Z E F S P
+        if((params & bit) && bit!=128 && bit!=512) size += 4;
+    for(uint8_t bit=1; bit<=4; bit<<=1) // I J R
+        if(params2 & bit) size += 4;
+    if(params & 32768) size += sizeof(char*);
+    return size;
+}
+/** \brief Fills the command from a record written by encodeCompact. */
+void GCode::decodeCompact(uint8_t *p)
+{
+    p++; // length
+    params = *(uint16_t *)p;
+    p+=2;
+    params2 = *(uint16_t *)p;
+    p+=2;
+    if(hasN())
+    {
+        N = *(uint16_t *)p;
+        p+=2;
+    }
+    if(hasM())
+    {
+        M = *(uint16_t *)p;
+        p+=2;
+    }
+    if(hasG())
+    {
+        G = *(uint16_t *)p;
+        p+=2;
+    }
+    if(hasX())
+    {
+        X = *(float *)p;
+        p+=4;
+    }
+    if(hasY())
+    {
+        Y = *(float *)p;
+        p+=4;
+    }
+    if(hasZ())
+    {
+        Z = *(float *)p;
+        p+=4;
+    }
+    if(hasE())
+    {
+        E = *(float *)p;
+        p+=4;
+    }
+    if(hasF())
+    {
+        F = *(float *)p;
+        p+=4;
+    }
+    if(hasT())
+        T = *p++;
+    if(hasS())
+    {
+        S = *(int32_t *)p;
+        p+=4;
+    }
+    if(hasP())
+    {
+        P = *(int32_t *)p;
+        p+=4;
+    }
+    if(hasI())
+    {
+        I = *(float *)p;
+        p+=4;
+    }
+    if(hasJ())
+    {
+        J = *(float *)p;
+        p+=4;
+    }
+    if(hasR())
+    {
+        R = *(float *)p;
+        p+=4;
+    }
+    if(hasString())
+        memcpy(&text,p,sizeof(char*));
 }
+#endif
 void GCode::pushCommand()
 {
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    uint8_t record[COMPACT_COMMAND_MAX_SIZE];
+    uint8_t length = commandReceived.encodeCompact(record);
+    for(uint8_t i=0; i<length; i++)
+    {
+        commandRing[bufferWriteIndex] = record[i];
+        if(++bufferWriteIndex == GCODE_RING_SIZE) bufferWriteIndex = 0;
+    }
+    commandRingUsed += length;
+    commandRecordMean = (commandRecordMean*7+((uint16_t)length<<4)+7)>>3;
+#else
     bufferWriteIndex = (bufferWriteIndex+1) % GCODE_BUFFER_SIZE;
+#endif
     bufferLength++;
 #ifndef ECHO_ON_EXECUTE
     echoCommand();
@@ -211,11 +548,29 @@ void GCode::pushCommand()
 /**
   Get the next buffered command. Returns 0 if no more commands are buffered. For each
   returned command, the gcode_command_finished() function must be called.
+  With FEATURE_COMPACT_COMMAND_BUFFER the command is decoded on the first call.
 */
 GCode *GCode::peekCurrentCommand()
 {
     if(bufferLength==0) return NULL; // No more data
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    if(!commandDecoded)
+    {
+        uint8_t record[COMPACT_COMMAND_MAX_SIZE];
+        uint8_t pos = bufferReadIndex;
+        uint8_t length = commandRing[pos];
+        for(uint8_t i=0; i<length; i++)
+        {
+            record[i] = commandRing[pos];
+            if(++pos == GCODE_RING_SIZE) pos = 0;
+        }
+        commandExecuted.decodeCompact(record);
+        commandDecoded = true;
+    }
+    return &commandExecuted;
+#else
     return &commandsBuffered[bufferReadIndex];
+#endif
 }
 /** \brief Removes the last returned command from cache. */
 void GCode::popCurrentCommand()
@@ -224,7 +579,14 @@ void GCode::popCurrentCommand()
 #ifdef ECHO_ON_EXECUTE
     echoCommand();
 #endif
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    uint8_t length = commandRing[bufferReadIndex];
+    bufferReadIndex = (bufferReadIndex+length) % GCODE_RING_SIZE;
+    commandRingUsed -= length;
+    commandDecoded = false;
+#else
     if(++bufferReadIndex == GCODE_BUFFER_SIZE) bufferReadIndex = 0;
+#endif
     bufferLength--;
 }
 
@@ -232,6 +594,14 @@ void GCode::echoCommand()
 {
     if(Printer::debugEcho())
     {
+#if FEATURE_OUTPUT_QUEUE
+        if(!hasString())
+        {
+            Commands::queueEcho(this);
+            return;
+        }
+        Commands::sendOutputQueue(true); // keeps the order, the string is not stored
+#endif
         Com::printF(Com::tEcho);
         printCommand();
     }
@@ -293,7 +663,7 @@ It must be called frequently to empty the incoming buffer.
 */
 void GCode::readFromSerial()
 {
-    if(bufferLength>=GCODE_BUFFER_SIZE) return; // all buffers full
+    if(freeCommandBuffers()==0) return; // all buffers full
     if(waitUntilAllCommandsAreParsed && bufferLength) return;
     waitUntilAllCommandsAreParsed=false;
     millis_t time = HAL::timeInMilliseconds();
@@ -304,6 +674,10 @@ void GCode::readFromSerial()
             requestResend(); // Something is wrong, a started line was not continued in the last second
             timeOfLastDataPacket = time;
         }
+#if FEATURE_PROTOCOL_V3
+        else if(commandsReceivingWritePosition == 0 && freeBuffersReported+ANNOUNCED_BUFFERS_STEP <= announcedCommandBuffers())
+            sendFrameAck(); // Window of the host grew by a quarter of the buffers
+#endif
 #ifdef WAITING_IDENTIFIER
         else if(bufferLength == 0 && time-timeOfLastDataPacket>1000)   // Don't do it if buffer is not empty. It may be a slow executing command.
         {
@@ -338,11 +712,32 @@ void GCode::readFromSerial()
         if(sendAsBinary)
         {
             if(commandsReceivingWritePosition < 2 ) continue;
+#if FEATURE_PROTOCOL_V3
+            if(*(uint16_t*)commandReceiving == BINARY_FRAME_MARKER)
+            {
+                if(commandsReceivingWritePosition == 6)
+                {
+                    if(commandReceiving[5] > MAX_CMD_SIZE-8)
+                    {
+                        requestResend();
+                        return;
+                    }
+                    binaryCommandSize = commandReceiving[5]+8;
+                }
+                if(commandsReceivingWritePosition > 6 && commandsReceivingWritePosition == binaryCommandSize)
+                {
+                    parseFrame();
+                    commandsReceivingWritePosition = 0;
+                    return;
+                }
+                continue;
+            }
+#endif
             if(commandsReceivingWritePosition == 5 || commandsReceivingWritePosition == 4)
                 binaryCommandSize = computeBinarySize((char*)commandReceiving);
             if(commandsReceivingWritePosition == binaryCommandSize)
             {
-                GCode *act = &commandsBuffered[bufferWriteIndex];
+                GCode *act = receivedCommand();
                 if(act->parseBinary(commandReceiving,true))   // Success
                     act->checkAndPushCommand();
                 else
@@ -364,11 +759,13 @@ void GCode::readFromSerial()
                     commandsReceivingWritePosition = 0;
                     continue;
                 }
-                GCode *act = &commandsBuffered[bufferWriteIndex];
+                GCode *act = receivedCommand();
+                SIM_PROBE_START(PARSER);
                 if(act->parseAscii((char *)commandReceiving,true))   // Success
                     act->checkAndPushCommand();
                 else
                     requestResend();
+                SIM_PROBE_END(PARSER);
                 commandsReceivingWritePosition = 0;
                 return;
             }
@@ -413,7 +810,7 @@ void GCode::readFromSerial()
                 binaryCommandSize = computeBinarySize((char*)commandReceiving);
             if(commandsReceivingWritePosition==binaryCommandSize)
             {
-                GCode *act = &commandsBuffered[bufferWriteIndex];
+                GCode *act = receivedCommand();
                 if(act->parseBinary(commandReceiving,false))   // Success, silently ignore illegal commands
                     pushCommand();
                 commandsReceivingWritePosition = 0;
@@ -436,7 +833,7 @@ void GCode::readFromSerial()
                     commandsReceivingWritePosition = 0;
                     continue;
                 }
-                GCode *act = &commandsBuffered[bufferWriteIndex];
+                GCode *act = receivedCommand();
                 if(act->parseAscii((char *)commandReceiving,false))   // Success
                     pushCommand();
                 commandsReceivingWritePosition = 0;
@@ -462,12 +859,27 @@ void GCode::readFromSerial()
   Returns true if checksum was correct.
 */
 bool GCode::parseBinary(uint8_t *buffer,bool fromSerial)
+{
+    if(!checkFletcher16(buffer,binaryCommandSize-2))
+    {
+        if(Printer::debugErrors())
+        {
+            Com::printErrorFLN(Com::tWrongChecksum);
+        }
+        return false;
+    }
+    decodeBinary(buffer);
+    formatErrors = 0;
+    return true;
+}
+
+/** \brief Tests the fletcher-16 checksum following the first len bytes of buffer. */
+bool GCode::checkFletcher16(uint8_t *buffer,uint8_t len)
 {
     unsigned int sum1=0,sum2=0; // for fletcher-16 checksum
     // first do fletcher-16 checksum tests see
     // http://en.wikipedia.org/wiki/Fletcher's_checksum
     uint8_t *p = buffer;
-    uint8_t len = binaryCommandSize-2;
     while (len)
     {
         uint8_t tlen = len > 21 ? 21 : len;
@@ -483,15 +895,12 @@ bool GCode::parseBinary(uint8_t *buffer,bool fromSerial)
     }
     sum1 -= *p++;
     sum2 -= *p;
-    if(sum1 | sum2)
-    {
-        if(Printer::debugErrors())
-        {
-            Com::printErrorFLN(Com::tWrongChecksum);
-        }
-        return false;
-    }
-    p = buffer;
+    return (sum1 | sum2) == 0;
+}
+
+/** \brief Fills the command from the binary fields starting at p. The checksum must have been tested before. */
+void GCode::decodeBinary(uint8_t *p)
+{
     params = *(unsigned int *)p;
     p+=2;
     uint8_t textlen=16;
@@ -593,120 +1002,204 @@ bool GCode::parseBinary(uint8_t *buffer,bool fromSerial)
         text[textlen] = 0; // Terminate string overwriting checksum
         waitUntilAllCommandsAreParsed=true; // Don't destroy string until executed
     }
-    formatErrors = 0;
-    return true;
+}
+
+const float powersOf10[] PROGMEM = {1.0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10};
+
+/** \brief Converts the number at s with the result of strtod, but much faster.
+
+Numbers with sign, integer and fractional part and at most 9 digits are converted directly.
+If the digits fit into the 24 bit float mantissa, the single division is rounded like
+the conversion by strtod. Everything else, like exponents, more digits or leading spaces, is
+left to strtod.
+*/
+float GCode::parseFloatValue(char *s)
+{
+    char *p = s;
+    bool negative = (*p == '-');
+    if(negative || *p == '+') p++;
+    uint32_t mantissa = 0;
+    uint8_t digits = 0,decimals = 0;
+    while(*p >= '0' && *p <= '9' && digits < 10)
+    {
+        mantissa = mantissa*10+(*p++ - '0');
+        digits++;
+    }
+    if(*p == '.')
+    {
+        p++;
+        while(*p >= '0' && *p <= '9' && digits < 10)
+        {
+            mantissa = mantissa*10+(*p++ - '0');
+            digits++;
+            decimals++;
+        }
+    }
+    if(digits == 0 || digits > 9 || mantissa > 16777216L || (*p >= '0' && *p <= '9')
+            || *p == 'e' || *p == 'E' || *p == 'x' || *p == 'X')
+    {
+        char *endPtr;
+        float f = (strtod(s, &endPtr));
+        if(s == endPtr) setFormatError();
+        return f;
+    }
+    float f = (float)mantissa;
+    if(decimals) f /= pgm_read_float(&powersOf10[decimals]);
+    return negative ? -f : f;
+}
+
+/** \brief Converts the number at s like strtol with base 10. */
+long GCode::parseLongValue(char *s)
+{
+    char *p = s;
+    bool negative = (*p == '-');
+    if(negative || *p == '+') p++;
+    uint32_t value = 0;
+    uint8_t digits = 0;
+    while(*p >= '0' && *p <= '9' && digits < 10)
+    {
+        value = value*10+(*p++ - '0');
+        digits++;
+    }
+    if(digits == 0 || digits > 9)
+    {
+        char *endPtr;
+        long l = (strtol(s, &endPtr, 10));
+        if(s == endPtr) setFormatError();
+        return l;
+    }
+    return negative ? -(long)value : (long)value;
 }
 
 /**
   Converts a ascii GCode line into a GCode structure.
+
+  Letters, values and checksum are read in one pass up to the checksum. Like with a search for
+  each letter, only the first occurrence of a letter counts.
 */
 bool GCode::parseAscii(char *line,bool fromSerial)
 {
-    bool has_checksum = false;
-    char *pos;
+    char *pos = line;
+    char *checksumPos = NULL;
+    uint8_t checksum = 0;
+    char c;
     params = 0;
     params2 = 0;
-    if((pos = strchr(line,'N'))!=0)   // Line number detected
-    {
-        actLineNumber = parseLongValue(++pos);
-        params |=1;
-        N = actLineNumber & 0xffff;
-    }
-    if((pos = strchr(line,'M'))!=0)   // M command
-    {
-        M = parseLongValue(++pos) & 0xffff;
-        params |= 2;
-        if(M>255) params |= 4096;
-    }
-    if(hasM() && (M == 23 || M == 28 || M == 29 || M == 30 || M == 32 || M == 117))
+    while((c = *pos) != 0 && !hasString())
     {
-        // after M command we got a filename for sd card management
-        char *sp = line;
-        while(*sp!='M') sp++; // Search M command
-        while(*sp!=' ') sp++; // search next whitespace
-        while(*sp==' ') sp++; // skip leading whitespaces
-        text = sp;
-        while(*sp)
+        if(c == '*')
         {
-            if(M != 117 && (*sp==' ' || *sp=='*')) break; // end of filename reached
-            sp++;
+            checksumPos = pos;
+            break;
         }
-        *sp = 0; // Removes checksum, but we don't care. Could also be part of the string.
-        waitUntilAllCommandsAreParsed = true; // don't risk string be deleted
-        params |= 32768;
-    }
-    else
-    {
-        if((pos = strchr(line,'G'))!=0)   // G command
+        checksum ^= c;
+        pos++;
+        switch(c)
         {
-            G = parseLongValue(++pos) & 0xffff;
+        case 'N':
+            if(hasN()) break;
+            actLineNumber = parseLongValue(pos);
+            params |=1;
+            N = actLineNumber & 0xffff;
+            break;
+        case 'M':
+            if(hasM()) break;
+            M = parseLongValue(pos) & 0xffff;
+            params |= 2;
+            if(M>255) params |= 4096;
+            if(M == 23 || M == 28 || M == 29 || M == 30 || M == 32 || M == 117)
+            {
+                // after M command we got a filename for sd card management
+                params &= 3; // letters before M are not part of the command
+                params2 &= 32768;
+                char *sp = pos;
+                while(*sp!=' ') sp++; // search next whitespace
+                while(*sp==' ') sp++; // skip leading whitespaces
+                text = sp;
+                while(*sp)
+                {
+                    if(M != 117 && (*sp==' ' || *sp=='*')) break; // end of filename reached
+                    sp++;
+                }
+                *sp = 0; // Removes checksum, but we don't care. Could also be part of the string.
+                waitUntilAllCommandsAreParsed = true; // don't risk string be deleted
+                params |= 32768;
+                if((checksumPos = strchr(line,'*'))!=0)
+                {
+                    checksum = 0;
+                    for(sp = line; sp!=checksumPos; sp++) checksum ^= *sp;
+                }
+            }
+            break;
+        case 'G':
+            if(hasG()) break;
+            G = parseLongValue(pos) & 0xffff;
             params |= 4;
             if(G>255) params |= 4096;
-        }
-        if((pos = strchr(line,'X'))!=0)
-        {
-            X = parseFloatValue(++pos);
+            break;
+        case 'X':
+            if(hasX()) break;
+            X = parseFloatValue(pos);
             params |= 8;
-        }
-        if((pos = strchr(line,'Y'))!=0)
-        {
-            Y = parseFloatValue(++pos);
+            break;
+        case 'Y':
+            if(hasY()) break;
+            Y = parseFloatValue(pos);
             params |= 16;
-        }
-        if((pos = strchr(line,'Z'))!=0)
-        {
-            Z = parseFloatValue(++pos);
+            break;
+        case 'Z':
+            if(hasZ()) break;
+            Z = parseFloatValue(pos);
             params |= 32;
-        }
-        if((pos = strchr(line,'E'))!=0)
-        {
-            E = parseFloatValue(++pos);
+            break;
+        case 'E':
+            if(hasE()) break;
+            E = parseFloatValue(pos);
             params |= 64;
-        }
-        if((pos = strchr(line,'F'))!=0)
-        {
-            F = parseFloatValue(++pos);
+            break;
+        case 'F':
+            if(hasF()) break;
+            F = parseFloatValue(pos);
             params |= 256;
-        }
-        if((pos = strchr(line,'T'))!=0)   // M command
-        {
-            T = parseLongValue(++pos) & 0xff;
+            break;
+        case 'T':
+            if(hasT()) break;
+            T = parseLongValue(pos) & 0xff;
             params |= 512;
-        }
-        if((pos = strchr(line,'S'))!=0)   // M command
-        {
-            S = parseLongValue(++pos);
+            break;
+        case 'S':
+            if(hasS()) break;
+            S = parseLongValue(pos);
             params |= 1024;
-        }
-        if((pos = strchr(line,'P'))!=0)   // M command
-        {
-            P = parseLongValue(++pos);
+            break;
+        case 'P':
+            if(hasP()) break;
+            P = parseLongValue(pos);
             params |= 2048;
-        }
-        if((pos = strchr(line,'I'))!=0)
-        {
-            I = parseFloatValue(++pos);
+            break;
+        case 'I':
+            if(hasI()) break;
+            I = parseFloatValue(pos);
             params2 |= 1;
             params |= 4096; // Needs V2 for saving
-        }
-        if((pos = strchr(line,'J'))!=0)
-        {
-            J = parseFloatValue(++pos);
+            break;
+        case 'J':
+            if(hasJ()) break;
+            J = parseFloatValue(pos);
             params2 |= 2;
             params |= 4096; // Needs V2 for saving
-        }
-        if((pos = strchr(line,'R'))!=0)
-        {
-            R = parseFloatValue(++pos);
+            break;
+        case 'R':
+            if(hasR()) break;
+            R = parseFloatValue(pos);
             params2 |= 4;
             params |= 4096; // Needs V2 for saving
+            break;
         }
     }
-    if((pos = strchr(line,'*'))!=0)   // checksum
+    if(checksumPos)   // checksum
     {
-        uint8_t checksum_given = parseLongValue(pos+1);
-        uint8_t checksum = 0;
-        while(line!=pos) checksum ^= *line++;
+        uint8_t checksum_given = parseLongValue(checksumPos+1);
 #if FEATURE_CHECKSUM_FORCED
         Printer::flag0 |= PRINTER_FLAG0_FORCE_CHECKSUM;
 #endif
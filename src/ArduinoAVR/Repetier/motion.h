@@ -50,6 +50,9 @@
 #define FLAG_JOIN_WAIT_EXTRUDER_UP 64
 /** Wait for the extruder to finish it's down movement */
 #define FLAG_JOIN_WAIT_EXTRUDER_DOWN 128
+/** Ramp phases for the speed update interrupt */
+#define SPEED_UPDATE_ACCELERATE 0
+#define SPEED_UPDATE_DECELERATE 1
 // Printing related data
 #if NONLINEAR_SYSTEM
 // Allow the delta cache to store segments for every line in line cache. Beware this gets big ... fast.
@@ -155,54 +158,176 @@ typedef struct
         dir |= 1<<axis;
     }
 } DeltaSegment;
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+#define DELTA_SEGMENT_SOFT_ENDSTOP 8
+/** Tower steps a segment may exceed the longer of the first and last segment of its line. */
+#define DELTA_SEGMENT_STEP_MARGIN 2
+#endif
 extern uint8_t lastMoveID;
 #endif
+#if FEATURE_STEP_BUFFER
+#define STEP_EVENT_X 1
+#define STEP_EVENT_Y 2
+#define STEP_EVENT_Z 4
+#define STEP_EVENT_E 8
+/** Poll interval of the stepper interrupt, while the step buffer is empty. */
+#define STEP_EVENT_POLL_TICKS (F_CPU/20000)
+/** \brief Step pulses of one timer call, computed ahead by PrintLine::fillStepBuffer. */
+typedef struct
+{
+    ticks_t ticks;                  ///< Timer ticks between the previous and this event
+    uint8_t steps;                  ///< Axes to step, combination of STEP_EVENT_X..STEP_EVENT_E
+    uint8_t dirs;                   ///< Axes moving in positive direction, same bits as steps
+} StepEvent;
+#endif
+#if FEATURE_S_CURVE_ACCELERATION
+/** \brief Precomputed S-curve of an acceleration or deceleration ramp.
+
+The ramp is split into three phases: acceleration rises linearly during jerkTime,
+stays at fPeak and falls linearly during the last jerkTime. All times are in units
+of 256 timer ticks, so speedChange can be evaluated with 16 bit multiplications.
+*/
+typedef struct
+{
+    unsigned long fPeak;            ///< Peak acceleration, same scale as PrintLine::fAcceleration
+    uint16_t rampTime;              ///< Duration of the ramp
+    uint16_t jerkTime;              ///< Duration of each jerk phase, 0 = constant acceleration
+    uint16_t jerkFactor;            ///< 32768/jerkTime
+    speed_t deltaV;                 ///< Speed change over the ramp in steps/s
+    /** Returns the speed change in steps/s reached timer ticks after the ramp start. */
+    inline speed_t speedChange(long timer)
+    {
+        if(jerkTime == 0) // Ramp too long for an S-curve, use constant acceleration
+        {
+            speed_t v = HAL::ComputeV(timer,fPeak);
+            return (v > deltaV ? deltaV : v);
+        }
+        if(timer >= ((long)rampTime << 8)) return deltaV;
+        uint16_t t = timer >> 8;
+        if(t < jerkTime) // acceleration rises
+            return HAL::mulu6xu16shift16(HAL::ComputeV(timer,fPeak),t * jerkFactor);
+        uint16_t r = rampTime - t;
+        if(r < jerkTime) // acceleration falls
+        {
+            speed_t v = HAL::mulu6xu16shift16(HAL::ComputeV((long)r << 8,fPeak),r * jerkFactor);
+            return (v > deltaV ? 0 : deltaV - v);
+        }
+        speed_t v = HAL::ComputeV(((long)t << 8) - ((long)jerkTime << 7),fPeak);
+        return (v > deltaV ? deltaV : v);
+    }
+} SCurveRamp;
+#endif
+/** \brief Path planner data of a move.
+
+The stepper interrupt never reads these values, so they are kept out of PrintLine.
+Only the last PLANNER_CACHE_SIZE moves in the cache have a planner record, older moves
+are not changed by the path planner any more. RAM usage: 12*4 = 48 Byte
+*/
+class PlannerLine
+{
+public:
+    float speedX;                   ///< Speed in x direction at fullInterval in mm/s
+    float speedY;                   ///< Speed in y direction at fullInterval in mm/s
+    float speedZ;                   ///< Speed in z direction at fullInterval in mm/s
+    float speedE;                   ///< Speed in E direction at fullInterval in mm/s
+    float fullSpeed;                ///< Desired speed mm/s
+    float invFullSpeed;             ///< 1.0/fullSpeed for fatser computation
+    float accelerationDistance2;    ///< Real 2.0*distance*acceleration mm²/s²
+    float maxJunctionSpeed2;        ///< Squared max. junction speed between this and next segment mm²/s²
+    float startSpeed2;              ///< Squared starting speed mm²/s²
+    float endSpeed2;                ///< Squared exit speed mm²/s²
+    float minSpeed2;                ///< Squared safe speed mm²/s²
+    unsigned long accelerationPrim; ///< Acceleration along primary axis
+#if NONLINEAR_SYSTEM
+    uint8_t moveID;					///< ID used to identify moves which are all part of the same line
+#endif
+};
+
 class UIDisplay;
-class PrintLine   // RAM usage: 24*4+15 = 113 Byte
+/** \brief Move data used by the stepper interrupt.
+
+RAM usage without delta segments: 8*4+17 = 49 Byte. The planner data is stored in PlannerLine.
+*/
+class PrintLine
 {
     friend class UIDisplay;
+    friend class Simulation; // the host simulation checks the ramps
 #if CPU_ARCH==ARCH_ARM
     static volatile bool nlFlag;
 #endif
 public:
     static uint8_t linesPos; // Position for executing line movement
     static PrintLine lines[];
+    static PlannerLine plannerLines[];
     static uint8_t linesWritePos; // Position where we write the next cached line move
+    static long error[4];           ///< Error calculation for Bresenham algorithm of the current line
+    static long queuedTicks;        ///< Execution time of all queued moves at full speed
+    static long minQueuedTicks;     ///< Lowest time left in the queue when a move was added, reset by M234
+    static unsigned int underruns;  ///< Moves finding the queue empty although they came within 250 ms, reset by M234
+    static long plannerTicks;       ///< Estimated time to add a move, follows increases at once and decreases slowly
+    static long arrivalTicks;       ///< Mean time between new moves while the queue is low
+    static unsigned long lastMoveMicros; ///< Time the last move was added, 0 after waiting for an empty queue
+#if FEATURE_STEP_BUFFER
+    static StepEvent stepEvents[STEP_BUFFER_SIZE];
+    static volatile uint8_t stepEventsRead;  ///< Next event for the stepper interrupt
+    static volatile uint8_t stepEventsWrite; ///< Next free event
+    static uint8_t stepEventSteps;           ///< Steps collected for the next event
+    static uint8_t stepEventDirs;            ///< Directions set by bresenhamStep
+    static uint8_t stepEventPinDirs;         ///< Directions of the direction pins
+    static ticks_t stepEventTicks;           ///< Ticks since the last stored event
+    static ticks_t stepEventIdle;            ///< Ticks the stepper interrupt waited for an event
+    static volatile uint8_t stepBufferFilling;
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+    static DeltaSegment deltaSegments[DELTA_SEGMENT_BUFFER_SIZE];
+    static uint8_t deltaSegmentLine[DELTA_SEGMENT_BUFFER_SIZE]; ///< Line of each buffered segment
+    static volatile uint8_t deltaSegmentsRead;  ///< Segment used by the stepper interrupt
+    static volatile uint8_t deltaSegmentsWrite; ///< Next free segment
+    static uint8_t deltaSegmentPos;             ///< Line of the next segment to compute
+    static uint8_t deltaSegmentsLeft;           ///< Segments left to compute in this line, 0 = line not started
+    static uint8_t deltaSegmentFlags;
+    static long deltaSegmentMaxSteps;           ///< Most tower steps in one segment of this line
+    static long deltaSegmentCartesian[3];       ///< Cartesian end of the last computed segment
+    static long deltaSegmentEnd[3];             ///< Cartesian end of the line
+    static long deltaSegmentTower[3];           ///< Tower positions at the end of the last computed segment
+    static volatile uint8_t deltaSegmentSequence; ///< Changes with every stored segment and restart
+    static volatile uint8_t deltaSegmentFilling;
+#endif
+#if FEATURE_DEFERRED_SPEED_UPDATE
+    static volatile uint8_t speedUpdateRequest; ///< Changes with every requested speed update
+    static uint8_t speedUpdateMode;             ///< SPEED_UPDATE_ACCELERATE or SPEED_UPDATE_DECELERATE
+#endif
     uint8_t joinFlags;
     volatile uint8_t flags;
 private:
     uint8_t primaryAxis;
     long timeInTicks;
-    uint8_t halfStep;                  ///< 4 = disabled, 1 = halfstep, 2 = fulstep
+    uint8_t stepSmoothing;             ///< Bresenham runs with 2^stepSmoothing times the rate of the primary axis
+    uint8_t smoothingPhase;            ///< Counts the timer calls of one primary step down to 0
     uint8_t dir;                       ///< Direction of movement. 1 = X+, 2 = Y+, 4= Z+, values can be combined.
     long delta[4];                  ///< Steps we want to move.
-    long error[4];                  ///< Error calculation for Bresenham algorithm
-    float speedX;                   ///< Speed in x direction at fullInterval in mm/s
-    float speedY;                   ///< Speed in y direction at fullInterval in mm/s
-    float speedZ;                   ///< Speed in z direction at fullInterval in mm/s
-    float speedE;                   ///< Speed in E direction at fullInterval in mm/s
-    float fullSpeed;                ///< Desired speed mm/s
-    float invFullSpeed;             ///< 1.0/fullSpeed for fatser computation
-    float accelerationDistance2;             ///< Real 2.0*distanceÜacceleration mm²/s²
-    float maxJunctionSpeed;         ///< Max. junction speed between this and next segment
-    float startSpeed;               ///< Staring speed in mm/s
-    float endSpeed;                 ///< Exit speed in mm/s
-    float minSpeed;
-    float distance;
 #if NONLINEAR_SYSTEM
     uint8_t numDeltaSegments;		///< Number of delta segments left in line. Decremented by stepper timer.
-    uint8_t moveID;					///< ID used to identify moves which are all part of the same line
     long numPrimaryStepPerSegment;	///< Number of primary bresenham axis steps in each delta segment
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+    uint8_t segmentFlags;           ///< Positive cartesian X/Y/Z in bits 0-2, DELTA_SEGMENT_SOFT_ENDSTOP
+    long segmentStart[3];           ///< Cartesian start of the line in steps
+    long segmentTowerStart[3];      ///< Tower positions at the start of the line in steps
+#else
     DeltaSegment segments[MAX_DELTA_SEGMENTS_PER_LINE];
+#endif
 #endif
     ticks_t fullInterval;     ///< interval at full speed in ticks/step.
     unsigned int accelSteps;        ///< How much steps does it take, to reach the plateau.
     unsigned int decelSteps;        ///< How much steps does it take, to reach the end speed.
-    unsigned long accelerationPrim; ///< Acceleration along primary axis
     unsigned long fAcceleration;    ///< accelerationPrim*262144/F_CPU
     speed_t vMax;              ///< Maximum reached speed in steps/s.
     speed_t vStart;            ///< Starting speed in steps/s.
     speed_t vEnd;              ///< End speed in steps/s
+#if FEATURE_S_CURVE_ACCELERATION
+    SCurveRamp accelRamp;           ///< Shape of the acceleration ramp
+    SCurveRamp decelRamp;           ///< Shape of the deceleration ramp
+#endif
 #ifdef USE_ADVANCE
 #ifdef ENABLE_QUADRATIC_ADVANCE
     long advanceRate;               ///< Advance steps at full speed
@@ -219,6 +344,10 @@ public:
     long stepsRemaining;            ///< Remaining steps, until move is finished
     static PrintLine *cur;
     static volatile uint8_t linesCount; // Number of lines cached 0 = nothing to do
+    inline PlannerLine *getPlannerLine()
+    {
+        return &plannerLines[(uint8_t)(this - lines) % PLANNER_CACHE_SIZE];
+    }
     inline bool areParameterUpToDate()
     {
         return joinFlags & FLAG_JOIN_STEPPARAMS_COMPUTED;
@@ -287,12 +416,13 @@ public:
     {
         return flags & FLAG_NOMINAL;
     }
-    inline bool setNominalMove()
+    inline void setNominalMove()
     {
         flags |= FLAG_NOMINAL;
     }
     inline void checkEndstops()
     {
+        if(!Printer::isEndstopCheckNeeded()) return;
         if(isCheckEndstops())
         {
             if(isXNegativeMove() && Printer::isXMinEndstopHit())
@@ -427,8 +557,14 @@ public:
     }
     inline static void resetPathPlanner()
     {
+        BEGIN_INTERRUPT_PROTECTED
         linesCount = 0;
         linesPos = linesWritePos;
+        queuedTicks = 0;
+        END_INTERRUPT_PROTECTED
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+        restartDeltaSegments();
+#endif
     }
     inline void updateAdvanceSteps(unsigned int v,uint8_t max_loops,bool accelerate)
     {
@@ -438,38 +574,54 @@ public:
         long advanceTarget = Printer::advanceExecuted;
         if(accelerate)
         {
+#if FEATURE_BRESENHAM_ADVANCE
+            advanceTarget += advanceRate * max_loops;
+#else
             for(uint8_t loop = 0; loop<max_loops; loop++) advanceTarget += advanceRate;
+#endif
             if(advanceTarget>advanceFull)
                 advanceTarget = advanceFull;
         }
         else
         {
+#if FEATURE_BRESENHAM_ADVANCE
+            advanceTarget -= advanceRate * max_loops;
+#else
             for(uint8_t loop = 0; loop<max_loops; loop++) advanceTarget -= advanceRate;
+#endif
             if(advanceTarget<advanceEnd)
                 advanceTarget = advanceEnd;
         }
         long h = HAL::mulu16xu16to32(v,advanceL);
         int tred = ((advanceTarget + h) >> 16);
+#if !FEATURE_BRESENHAM_ADVANCE // the stepper interrupt is the only user of extruderStepsNeeded then
         HAL::forbidInterrupts();
+#endif
         Printer::extruderStepsNeeded += tred-Printer::advanceStepsSet;
         if(tred>0 && Printer::advanceStepsSet<=0)
             Printer::extruderStepsNeeded += Extruder::current->advanceBacklash;
         else if(tred<0 && Printer::advanceStepsSet>=0)
             Printer::extruderStepsNeeded -= Extruder::current->advanceBacklash;
         Printer::advanceStepsSet = tred;
+#if !FEATURE_BRESENHAM_ADVANCE
         HAL::allowInterrupts();
+#endif
         Printer::advanceExecuted = advanceTarget;
 #else
         int tred = HAL::mulu6xu16shift16(v,advanceL);
+#if !FEATURE_BRESENHAM_ADVANCE
         HAL::forbidInterrupts();
+#endif
         Printer::extruderStepsNeeded += tred - Printer::advanceStepsSet;
         if(tred>0 && Printer::advanceStepsSet<=0)
             Printer::extruderStepsNeeded += (Extruder::current->advanceBacklash << 1);
         else if(tred<0 && Printer::advanceStepsSet>=0)
             Printer::extruderStepsNeeded -= (Extruder::current->advanceBacklash << 1);
         Printer::advanceStepsSet = tred;
+#if !FEATURE_BRESENHAM_ADVANCE
         HAL::allowInterrupts();
 #endif
+#endif
 #endif
     }
     inline bool moveDecelerating()
@@ -491,16 +643,23 @@ public:
     }
     inline bool isFullstepping()
     {
-        return halfStep == 4;
+        return stepSmoothing == 0;
+    }
+    /** Returns the mask of the smoothing phase, also the phase of the first timer call of a primary step. */
+    inline uint8_t smoothingMask()
+    {
+        return (1 << stepSmoothing) - 1;
     }
-    inline bool startXStep()
+    inline void startXStep()
     {
         ANALYZER_ON(ANALYZER_CH6);
-#if DRIVE_SYSTEM==0 || !defined(XY_GANTRY)
+#if FEATURE_STEP_BUFFER
+        stepEventSteps |= STEP_EVENT_X;
+#elif DRIVE_SYSTEM==0 || !defined(XY_GANTRY)
         ANALYZER_ON(ANALYZER_CH2);
-        WRITE(X_STEP_PIN,HIGH);
+        START_STEP_PIN(X_STEP_PIN);
 #if FEATURE_TWO_XSTEPPER
-        WRITE(X2_STEP_PIN,HIGH);
+        START_STEP_PIN(X2_STEP_PIN);
 #endif
 #else
 #if DRIVE_SYSTEM==1
@@ -533,14 +692,16 @@ public:
 #endif
 
     }
-    inline bool startYStep()
+    inline void startYStep()
     {
         ANALYZER_ON(ANALYZER_CH7);
-#if DRIVE_SYSTEM==0 || !defined(XY_GANTRY)
+#if FEATURE_STEP_BUFFER
+        stepEventSteps |= STEP_EVENT_Y;
+#elif DRIVE_SYSTEM==0 || !defined(XY_GANTRY)
         ANALYZER_ON(ANALYZER_CH3);
-        WRITE(Y_STEP_PIN,HIGH);
+        START_STEP_PIN(Y_STEP_PIN);
 #if FEATURE_TWO_YSTEPPER
-        WRITE(Y2_STEP_PIN,HIGH);
+        START_STEP_PIN(Y2_STEP_PIN);
 #endif
 #else
 #if DRIVE_SYSTEM==1
@@ -574,14 +735,147 @@ public:
     }
     inline void startZStep()
     {
-        WRITE(Z_STEP_PIN,HIGH);
+#if FEATURE_STEP_BUFFER
+        stepEventSteps |= STEP_EVENT_Z;
+#else
+        START_STEP_PIN(Z_STEP_PIN);
 #if FEATURE_TWO_ZSTEPPER
-        WRITE(Z2_STEP_PIN,HIGH);
+        START_STEP_PIN(Z2_STEP_PIN);
+#endif
+#endif
+    }
+    static inline void startEStep()
+    {
+#if FEATURE_STEP_BUFFER
+        stepEventSteps |= STEP_EVENT_E;
+#elif FEATURE_STEP_PORT_MASKS && NUM_EXTRUDER==1
+        START_STEP_PIN(EXT0_STEP_PIN);
+#else
+        Extruder::step();
 #endif
     }
+#if FEATURE_BRESENHAM_ADVANCE
+    /** Starts one of the extruder steps needed by Bresenham and advance together with the steps of the
+        other axes. A direction change uses the call instead of a step, so the driver sees it in time. */
+    static inline void startAdvanceStep()
+    {
+        if(Printer::extruderStepsNeeded > 0)
+        {
+            if(Printer::extruderLastDirection != 1)
+            {
+                Extruder::setDirection(true);
+                Printer::extruderLastDirection = 1;
+                return;
+            }
+        }
+        else if(Printer::extruderStepsNeeded < 0)
+        {
+            if(Printer::extruderLastDirection != -1)
+            {
+                Extruder::setDirection(false);
+                Printer::extruderLastDirection = -1;
+                return;
+            }
+        }
+        else return;
+        startEStep();
+        Printer::extruderStepsNeeded -= Printer::extruderLastDirection;
+    }
+    /** Executes the advance steps left after the last move, one per call of the idle stepper interrupt.
+        Returns the ticks to the next call or 0 if no steps are left. */
+    static inline unsigned int idleAdvanceStep()
+    {
+        if(!Printer::extruderStepsNeeded || !Printer::isAdvanceActivated()) return 0;
+        startAdvanceStep();
+        Printer::writeStepPort();
+        Printer::insertStepperHighDelay();
+        Extruder::unstep();
+        return (unsigned int)Printer::maxExtruderSpeed * TIMER0_PRESCALE; // maximum extruder feedrate
+    }
+#endif
+#if FEATURE_STEP_BUFFER
+    // Directions are stored in the step event and set by executeStepEvents
+    static inline void setDirection(uint8_t axisBit,bool positive)
+    {
+        stepEventDirs = (positive ? stepEventDirs | axisBit : stepEventDirs & ~axisBit);
+    }
+    static inline void setXDirection(bool positive)
+    {
+        setDirection(STEP_EVENT_X,positive);
+    }
+    static inline void setYDirection(bool positive)
+    {
+        setDirection(STEP_EVENT_Y,positive);
+    }
+    static inline void setZDirection(bool positive)
+    {
+        setDirection(STEP_EVENT_Z,positive);
+    }
+    static inline void setEDirection(bool positive)
+    {
+        setDirection(STEP_EVENT_E,positive);
+    }
+    /** Stores the steps collected by bresenhamStep as next event. Calls without steps only add their time. */
+    static inline void pushStepEvent()
+    {
+        if(!stepEventSteps) return;
+        StepEvent *ev = &stepEvents[stepEventsWrite];
+        ev->ticks = stepEventTicks;
+        ev->steps = stepEventSteps;
+        ev->dirs = stepEventDirs;
+        stepEventTicks = 0;
+        stepEventSteps = 0;
+        stepEventsWrite = (stepEventsWrite + 1) & (STEP_BUFFER_SIZE - 1);
+    }
+    static inline uint8_t stepEventsQueued()
+    {
+        return (stepEventsWrite - stepEventsRead) & (STEP_BUFFER_SIZE - 1);
+    }
+    static void fillStepBuffer();
+    static long executeStepEvents();
+#else
+    static inline void setXDirection(bool positive)
+    {
+        Printer::setXDirection(positive);
+    }
+    static inline void setYDirection(bool positive)
+    {
+        Printer::setYDirection(positive);
+    }
+    static inline void setZDirection(bool positive)
+    {
+        Printer::setZDirection(positive);
+    }
+    static inline void setEDirection(bool positive)
+    {
+        Extruder::setDirection(positive);
+    }
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+    inline uint16_t prepareDeltaSegments(uint8_t softEndstop);
+    static bool computeDeltaSegment();
+    static DeltaSegment *nextDeltaSegment(bool first);
+    static void releaseDeltaSegments();
+    static inline uint8_t deltaSegmentsQueued()
+    {
+        return deltaSegmentsWrite - deltaSegmentsRead;
+    }
+    /** Drops the buffered segments, the next segment is computed for the line at linesPos. */
+    static inline void restartDeltaSegments()
+    {
+        deltaSegmentsRead = deltaSegmentsWrite;
+        deltaSegmentPos = linesPos;
+        deltaSegmentsLeft = 0;
+        deltaSegmentSequence++;
+    }
+    static void fillDeltaSegments();
+#endif
     void updateStepsParameter();
-    inline float safeSpeed();
-    void calculateMove(float axis_diff[],uint8_t pathOptimize);
+#if FEATURE_S_CURVE_ACCELERATION
+    float computeSCurveRamp(SCurveRamp &ramp,speed_t deltaV,float accel,float jerk,float maxTime);
+#endif
+    inline float safeSpeed(PlannerLine *pl);
+    void calculateMove(float axis_diff[],uint8_t pathOptimize,float distance);
     void logLine();
     inline long getWaitTicks()
     {
@@ -591,10 +885,15 @@ public:
     {
         timeInTicks = wait;
     }
+    static long queuedTicksLeft();
 
     static inline bool hasLines()
     {
+#if FEATURE_STEP_BUFFER
+        return linesCount || stepEventsRead != stepEventsWrite;
+#else
         return linesCount;
+#endif
     }
     static inline void setCurrentLine()
     {
@@ -605,6 +904,7 @@ public:
     }
     static inline void removeCurrentLineForbidInterrupt()
     {
+        queuedTicks -= lines[linesPos].timeInTicks;
         linesPos++;
         if(linesPos>=MOVE_CACHE_SIZE) linesPos=0;
         cur = NULL;
@@ -612,28 +912,65 @@ public:
         nlFlag = false;
 #endif
         HAL::forbidInterrupts();
-        --linesCount;
+        if(--linesCount == 0) queuedTicks = 0; // Resync, in case moves were dropped
     }
     static inline void pushLine()
     {
+        long ticks = lines[linesWritePos].timeInTicks;
         linesWritePos++;
         if(linesWritePos>=MOVE_CACHE_SIZE) linesWritePos = 0;
         BEGIN_INTERRUPT_PROTECTED
         linesCount++;
+        queuedTicks += ticks;
         END_INTERRUPT_PROTECTED
     }
     static PrintLine *getNextWriteLine()
     {
+#if PLANNER_CACHE_SIZE < MOVE_CACHE_SIZE
+        // The new move takes over the planner record of the move PLANNER_CACHE_SIZE before it. The planner
+        // leaves no move with outdated parameters, but make sure a still queued one gets them from its own record.
+        PrintLine *old = &lines[(linesWritePos + MOVE_CACHE_SIZE - PLANNER_CACHE_SIZE) % MOVE_CACHE_SIZE];
+        bool outdated;
+        BEGIN_INTERRUPT_PROTECTED
+        outdated = linesCount >= PLANNER_CACHE_SIZE && !old->areParameterUpToDate();
+        if(outdated) old->block();
+        END_INTERRUPT_PROTECTED
+        if(outdated)
+        {
+            old->updateStepsParameter();
+            old->unblock();
+        }
+#endif
         return &lines[linesWritePos];
     }
     static inline void computeMaxJunctionSpeed(PrintLine *previous,PrintLine *current);
     static long bresenhamStep();
+#if FEATURE_DEFERRED_SPEED_UPDATE
+    /** Lets the speed update interrupt compute the speed of the ramp phase found by the stepper interrupt. */
+    static inline void requestSpeedUpdate(uint8_t mode)
+    {
+        speedUpdateMode = mode;
+        speedUpdateRequest++;
+        HAL::triggerSpeedUpdate();
+    }
+    static void deferredSpeedUpdate();
+#endif
     static void waitForXFreeLines(uint8_t b=1);
     static inline void forwardPlanner(uint8_t p);
-    static inline void backwardPlanner(uint8_t p,uint8_t last);
+    static inline uint8_t backwardPlanner(uint8_t p,uint8_t last);
     static void updateTrapezoids();
     static uint8_t insertWaitMovesIfNeeded(uint8_t pathOptimize, uint8_t waitExtraLines);
     static void queueCartesianMove(uint8_t check_endstops,uint8_t pathOptimize);
+#if FEATURE_MOVE_MERGING
+    static uint8_t mergeCount;              ///< Moves joined in the pending move, 0 = no pending move
+    static long mergeStart[4];              ///< Start of the pending move in steps
+    static float mergeJoints[MOVE_MERGE_MAX_SEGMENTS - 1][3]; ///< Corners inside the pending move in mm
+    static long mergeE;                     ///< Extruder steps of the pending move
+    static float mergeLength;               ///< Length of the pending move in mm
+    static float mergeFeedrate;
+    static void queueMergedMove();
+    static void flushMergedMove();
+#endif
     static void moveRelativeDistanceInSteps(long x,long y,long z,long e,float feedrate,bool waitEnd,bool check_endstop);
 #if ARC_SUPPORT
     static void arc(float *position, float *target, float *offset, float radius, uint8_t isclockwise);
@@ -649,7 +986,9 @@ public:
 #if NONLINEAR_SYSTEM
     static void queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint8_t softEndstop);
     static inline void queueEMove(long e_diff,uint8_t check_endstops,uint8_t pathOptimize);
+#if !FEATURE_DELTA_SEGMENTS_ON_THE_FLY
     inline uint16_t calculateDeltaSubSegments(uint8_t softEndstop);
+#endif
     static inline void calculateDirectionAndDelta(long difference[], uint8_t *dir, long delta[]);
     static inline uint8_t calculateDistance(float axis_diff[], uint8_t dir, float *distance);
 #ifdef SOFTWARE_LEVELING && DRIVE_SYSTEM==3
@@ -24,6 +24,25 @@
 const int sensitive_pins[] PROGMEM = SENSITIVE_PINS; // Sensitive pin list for M42
 int Commands::lowestRAMValue=MAX_RAM;
 int Commands::lowestRAMValueSend=MAX_RAM;
+#if FEATURE_ISR_PROFILER
+IsrProfile Commands::stepperProfile;
+IsrProfile Commands::pwmProfile;
+unsigned long Commands::isrProfileStart;
+#endif
+#if FEATURE_OUTPUT_QUEUE
+#if OUTPUT_QUEUE_SIZE<2
+#error OUTPUT_QUEUE_SIZE must be at least 2
+#endif
+OutputRecord Commands::outputQueue[OUTPUT_QUEUE_SIZE];
+uint8_t Commands::outputQueueRead = 0;
+uint8_t Commands::outputQueueLength = 0;
+unsigned int Commands::outputDropped = 0;
+#endif
+#if FEATURE_AUTO_REPORT
+uint16_t Commands::autoReportInterval[2] = {0,0};
+uint16_t Commands::autoReportTicks[2] = {0,0};
+uint8_t Commands::autoReportBinary = 0;
+#endif
 
 void Commands::commandLoop()
 {
@@ -61,9 +80,22 @@ void Commands::commandLoop()
 
 void Commands::checkForPeriodicalActions()
 {
+    SIM_POLL;
+#if FEATURE_OUTPUT_QUEUE
+    if(outputQueueLength || outputDropped) sendOutputQueue(false);
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+    PrintLine::fillDeltaSegments();
+#endif
+#if FEATURE_STEP_BUFFER
+    PrintLine::fillStepBuffer();
+#endif
     if(!executePeriodical) return;
     executePeriodical=0;
     Extruder::manageTemperatures();
+#if FEATURE_AUTO_REPORT
+    autoReport();
+#endif
     if(--counter250ms==0)
     {
         if(manageMonitor<=1+NUM_EXTRUDER)
@@ -81,16 +113,23 @@ void Commands::checkForPeriodicalActions()
 */
 void Commands::waitUntilEndOfAllMoves()
 {
+#if FEATURE_MOVE_MERGING
+    PrintLine::flushMergedMove();
+#endif
     while(PrintLine::hasLines())
     {
         GCode::readFromSerial();
         Commands::checkForPeriodicalActions();
         UI_MEDIUM;
     }
+    PrintLine::lastMoveMicros = 0; // the empty queue is wanted, no underrun
 }
 void Commands::waitUntilEndOfAllBuffers()
 {
-    GCode *code;
+    GCode *code = NULL;
+#if FEATURE_MOVE_MERGING
+    PrintLine::flushMergedMove();
+#endif
     while(PrintLine::hasLines() || (code = GCode::peekCurrentCommand()) != NULL)
     {
         GCode::readFromSerial();
@@ -116,21 +155,32 @@ void Commands::waitUntilEndOfAllBuffers()
 #endif
                 Commands::executeGCode(code);
             code->popCurrentCommand();
-        }        Commands::checkForPeriodicalActions();
+            code = NULL; // peeked again once the moves are done
+        }
+        Commands::checkForPeriodicalActions();
         UI_MEDIUM;
     }
 }
+/** Position in the units of the current coordinate system, like M114 reports it. */
+void Commands::currentPosition(float pos[4])
+{
+    Printer::realPosition(pos[X_AXIS],pos[Y_AXIS],pos[Z_AXIS]);
+    pos[X_AXIS] += Printer::coordinateOffset[X_AXIS];
+    pos[Y_AXIS] += Printer::coordinateOffset[Y_AXIS];
+    pos[Z_AXIS] += Printer::coordinateOffset[Z_AXIS];
+    pos[E_AXIS] = Printer::currentPositionSteps[E_AXIS]*Printer::invAxisStepsPerMM[E_AXIS];
+    if(Printer::unitIsInches)
+        for(uint8_t i=0; i<4; i++)
+            pos[i] *= 0.03937;
+}
 void Commands::printCurrentPosition()
 {
-    float x,y,z;
-    Printer::realPosition(x,y,z);
-    x += Printer::coordinateOffset[X_AXIS];
-    y += Printer::coordinateOffset[Y_AXIS];
-    z += Printer::coordinateOffset[Z_AXIS];
-    Com::printF(Com::tXColon,x*(Printer::unitIsInches?0.03937:1),2);
-    Com::printF(Com::tSpaceYColon,y*(Printer::unitIsInches?0.03937:1),2);
-    Com::printF(Com::tSpaceZColon,z*(Printer::unitIsInches?0.03937:1),2);
-    Com::printFLN(Com::tSpaceEColon,Printer::currentPositionSteps[3]*Printer::invAxisStepsPerMM[3]*(Printer::unitIsInches?0.03937:1),2);
+    float pos[4];
+    currentPosition(pos);
+    Com::printF(Com::tXColon,pos[X_AXIS],2);
+    Com::printF(Com::tSpaceYColon,pos[Y_AXIS],2);
+    Com::printF(Com::tSpaceZColon,pos[Z_AXIS],2);
+    Com::printFLN(Com::tSpaceEColon,pos[E_AXIS],2);
     //Com::printF(PSTR("OffX:"),Printer::offsetX); // to debug offset handling
     //Com::printFLN(PSTR(" OffY:"),Printer::offsetY);
 }
@@ -172,6 +222,167 @@ void Commands::printTemperatures(bool showRaw)
 #endif
     Com::println();
 }
+/** \brief Sends the temperatures, with FEATURE_OUTPUT_QUEUE as soon as the output buffer has room.
+
+A report still waiting is not repeated, it shows the temperatures of the time it is sent.
+*/
+void Commands::reportTemperatures(bool showRaw)
+{
+#if FEATURE_OUTPUT_QUEUE
+    uint8_t pos = outputQueueRead;
+    for(uint8_t i=0; i<outputQueueLength; i++)
+    {
+        if(outputQueue[pos].type == OUTPUT_TEMPERATURES)
+        {
+            outputQueue[pos].showRaw |= showRaw;
+            sendOutputQueue(false);
+            return;
+        }
+        if(++pos == OUTPUT_QUEUE_SIZE) pos = 0;
+    }
+    // Echo lines leave the last record free, so one report always fits
+    OutputRecord &r = outputQueue[pos];
+    r.type = OUTPUT_TEMPERATURES;
+    r.showRaw = showRaw;
+    outputQueueLength++;
+    sendOutputQueue(false);
+#else
+    printTemperatures(showRaw);
+#endif
+}
+#if FEATURE_OUTPUT_QUEUE
+/** \brief Queues the echo of a command without string or drops it, if the queue is full. */
+void Commands::queueEcho(GCode *code)
+{
+    sendOutputQueue(false);
+    if(outputQueueLength >= OUTPUT_QUEUE_SIZE-1)
+    {
+        outputDropped++;
+        return;
+    }
+    uint8_t pos = outputQueueRead+outputQueueLength;
+    if(pos >= OUTPUT_QUEUE_SIZE) pos -= OUTPUT_QUEUE_SIZE;
+    OutputRecord &r = outputQueue[pos];
+    r.type = OUTPUT_ECHO;
+    r.code = *code;
+    outputQueueLength++;
+    sendOutputQueue(false);
+}
+/** Upper estimate of the line a record is formatted to, limited to an empty output buffer. */
+uint8_t Commands::outputLineLength(OutputRecord &r)
+{
+    uint8_t length;
+    if(r.type == OUTPUT_TEMPERATURES)
+    {
+        length = 36+(NUM_EXTRUDER>1 ? 28*NUM_EXTRUDER : 0);
+        if(r.showRaw) length += 11*(NUM_EXTRUDER+1);
+    }
+    else
+    {
+        GCode &c = r.code;
+        length = 7+(c.hasM() ? 6 : 0)+(c.hasG() ? 6 : 0)+(c.hasT() ? 5 : 0); // Echo: and line end
+        uint8_t values = c.hasX()+c.hasY()+c.hasZ()+c.hasE()+c.hasF()+c.hasS()+c.hasP()+c.hasI()+c.hasJ()+c.hasR();
+        length += 13*values;
+    }
+    return length > OUTPUT_MAX_LINE ? OUTPUT_MAX_LINE : length;
+}
+/** \brief Formats queued messages as long as the output buffer has room for their lines.
+
+With wait all messages are sent, even if the firmware has to wait for the UART.
+*/
+void Commands::sendOutputQueue(bool wait)
+{
+    while(outputQueueLength)
+    {
+        OutputRecord &r = outputQueue[outputQueueRead];
+        if(!wait && HAL::serialOutputUnused() < outputLineLength(r)) return;
+        if(r.type == OUTPUT_TEMPERATURES)
+            printTemperatures(r.showRaw);
+        else
+        {
+            Com::printF(Com::tEcho);
+            r.code.printCommand();
+        }
+        if(++outputQueueRead == OUTPUT_QUEUE_SIZE) outputQueueRead = 0;
+        outputQueueLength--;
+    }
+    if(outputDropped && (wait || HAL::serialOutputUnused() >= 32))
+    {
+        Com::printInfoF(Com::tEchoLinesDropped);
+        Com::print((unsigned long)outputDropped);
+        Com::println();
+        outputDropped = 0;
+    }
+}
+#endif
+#if FEATURE_AUTO_REPORT
+/** \brief Sets the interval of a report from S in seconds and its format from P, P1 = binary. */
+void Commands::setAutoReport(uint8_t type,GCode *com)
+{
+    long seconds = com->getS(0);
+    if(seconds < 0) seconds = 0;
+    if(seconds > 3600) seconds = 3600;
+    autoReportInterval[type] = seconds*10;
+    autoReportTicks[type] = 0;
+    if(com->getP(0))
+        autoReportBinary |= 1<<type;
+    else
+        autoReportBinary &= ~(1<<type);
+}
+/** \brief Sends the reports set by M154 and M155 when their interval is over. Called every 100 ms. */
+void Commands::autoReport()
+{
+    for(uint8_t type=0; type<2; type++)
+    {
+        if(!autoReportInterval[type] || ++autoReportTicks[type] < autoReportInterval[type]) continue;
+        autoReportTicks[type] = 0;
+        if(autoReportBinary & (1<<type))
+            sendBinaryReport(type);
+        else if(type == AUTO_REPORT_TEMPERATURES)
+            reportTemperatures();
+        else
+            printCurrentPosition();
+    }
+}
+/** \brief Writes a report as binary record, see FEATURE_AUTO_REPORT in Configuration.h for the format. */
+void Commands::sendBinaryReport(uint8_t type)
+{
+    uint8_t data[4+(NUM_TEMPERATURE_LOOPS*5>16 ? NUM_TEMPERATURE_LOOPS*5 : 16)];
+    uint8_t *p = data+2;
+    if(type == AUTO_REPORT_TEMPERATURES)
+    {
+        for(uint8_t i=0; i<NUM_TEMPERATURE_LOOPS; i++)
+        {
+            TemperatureController *act = tempController[i];
+            int16_t temp = act->currentTemperatureC*10.0f;
+            memcpy(p,&temp,2);
+            temp = act->targetTemperatureC*10.0f;
+            memcpy(p+2,&temp,2);
+            p[4] = pwm_pos[act->pwmIndex];
+            p += 5;
+        }
+    }
+    else
+    {
+        float pos[4];
+        currentPosition(pos);
+        memcpy(p,pos,16);
+        p += 16;
+    }
+    data[0] = 0x81+type;
+    data[1] = p-data-2;
+    unsigned int sum1=0,sum2=0;
+    for(uint8_t *q=data; q<p; q++)
+    {
+        sum1 = (sum1+*q) % 255;
+        sum2 = (sum2+sum1) % 255;
+    }
+    *p++ = sum1;
+    *p++ = sum2;
+    for(uint8_t *q=data; q<p; q++)
+        HAL::serialWriteByte(*q);
+}
+#endif
 void Commands::changeFeedrateMultiply(int factor)
 {
     if(factor<25) factor=25;
@@ -421,6 +632,9 @@ void Commands::executeGCode(GCode *com)
             return;
         }
     }
+#endif
+#if FEATURE_MOVE_MERGING
+    if(!com->hasG() || com->G > 1) PrintLine::flushMergedMove(); // Commands see all moves queued
 #endif
     if(com->hasG())
     {
@@ -429,7 +643,9 @@ void Commands::executeGCode(GCode *com)
         case 0: // G0 -> G1
         case 1: // G1
             if(Printer::setDestinationStepsFromGCode(com)) // For X Y Z E F
-#if NONLINEAR_SYSTEM
+#if FEATURE_MOVE_MERGING
+                PrintLine::queueMergedMove();
+#elif NONLINEAR_SYSTEM
                 PrintLine::queueDeltaMove(ALWAYS_CHECK_ENDSTOPS, true, true);
 #else
                 PrintLine::queueCartesianMove(ALWAYS_CHECK_ENDSTOPS,true);
@@ -906,7 +1122,7 @@ void Commands::executeGCode(GCode *com)
             if (com->hasS()) Extruder::setHeatedBedTemperature(com->S,com->hasF() && com->F>0);
             break;
         case 105: // M105  get temperature. Always returns the current temperature, doesn't wait until move stopped
-            printTemperatures(com->hasX());
+            reportTemperatures(com->hasX());
             break;
         case 109: // M109 - Wait for extruder heater to reach target.
 #if NUM_EXTRUDER>0
@@ -934,7 +1150,7 @@ void Commands::executeGCode(GCode *com)
                 currentTime = HAL::timeInMilliseconds();
                 if( (currentTime - printedTime) > 1000 )   //Print Temp Reading every 1 second while heating up.
                 {
-                    printTemperatures();
+                    reportTemperatures();
                     printedTime = currentTime;
                 }
                 Commands::checkForPeriodicalActions();
@@ -983,7 +1199,7 @@ void Commands::executeGCode(GCode *com)
             {
                 if( (HAL::timeInMilliseconds()-codenum) > 1000 )   //Print Temp Reading every 1 second while heating up.
                 {
-                    printTemperatures();
+                    reportTemperatures();
                     codenum = HAL::timeInMilliseconds();
                 }
                 Commands::checkForPeriodicalActions();
@@ -998,11 +1214,12 @@ void Commands::executeGCode(GCode *com)
             {
                 bool allReached = false;
                 codenum = HAL::timeInMilliseconds();
+                PrintLine::lastMoveMicros = 0; // the queue may run empty while heating, no underrun
                 while(!allReached) {
                     allReached = true;
                     if( (HAL::timeInMilliseconds()-codenum) > 1000 )   //Print Temp Reading every 1 second while heating up.
                     {
-                        printTemperatures();
+                        reportTemperatures();
                         codenum = HAL::timeInMilliseconds();
                     }
                     Commands::checkForPeriodicalActions();
@@ -1125,6 +1342,14 @@ void Commands::executeGCode(GCode *com)
         case 114: // M114
             printCurrentPosition();
             break;
+#if FEATURE_AUTO_REPORT
+        case 154: // M154 S<seconds> P<1 = binary> Report position automatically, S0 stops
+            setAutoReport(AUTO_REPORT_POSITION,com);
+            break;
+        case 155: // M155 S<seconds> P<1 = binary> Report temperatures automatically, S0 stops
+            setAutoReport(AUTO_REPORT_TEMPERATURES,com);
+            break;
+#endif
         case 117: // M117 message to lcd
             if(com->hasString())
             {
@@ -1216,7 +1441,7 @@ void Commands::executeGCode(GCode *com)
         case 206: // M206 T[type] P[pos] [Sint(long] [Xfloat]  Set eeprom value
             EEPROM::update(com);
             break;
-        case 207: // M207 X<XY jerk> Z<Z Jerk>
+        case 207: // M207 X<XY jerk> Z<Z Jerk> J<junction deviation>
             if(com->hasX())
                 Printer::maxJerk = com->X;
             if(com->hasE())
@@ -1224,14 +1449,17 @@ void Commands::executeGCode(GCode *com)
                 Extruder::current->maxStartFeedrate = com->E;
                 Extruder::selectExtruderById(Extruder::current->id);
             }
+            if(com->hasJ())
+                Printer::junctionDeviation = RMath::max(0.0f,com->J);
 #if DRIVE_SYSTEM!=3
             if(com->hasZ())
                 Printer::maxZJerk = com->Z;
             Com::printF(Com::tJerkColon,Printer::maxJerk);
-            Com::printFLN(Com::tZJerkColon,Printer::maxZJerk);
+            Com::printF(Com::tZJerkColon,Printer::maxZJerk);
 #else
-            Com::printFLN(Com::tJerkColon,Printer::maxJerk);
+            Com::printF(Com::tJerkColon,Printer::maxJerk);
 #endif
+            Com::printFLN(Com::tJunctionDeviationColon,Printer::junctionDeviation,3);
             break;
         case 220: // M220 S<Feedrate multiplier in percent>
             changeFeedrateMultiply(com->getS(100));
@@ -1260,6 +1488,20 @@ void Commands::executeGCode(GCode *com)
             maxadv2=0;
             maxadvspeed=0;
             break;
+#endif
+        case 234: // M234 Read and reset queue statistics
+            Com::printF(Com::tUnderrunsColon,(int)PrintLine::underruns);
+            Com::printF(Com::tMinQueueTimeColon,PrintLine::minQueuedTicks == 0x7fffffff ? 0 : PrintLine::minQueuedTicks / (F_CPU / 1000));
+            Com::printFLN(Com::tPlannerTimeColon,PrintLine::plannerTicks / (F_CPU / 1000000));
+            PrintLine::underruns = 0;
+            PrintLine::minQueuedTicks = 0x7fffffff;
+            break;
+#if FEATURE_ISR_PROFILER
+        case 235: // M235 Report interrupt profile, S1 resets it afterwards
+            Commands::reportIsrProfile();
+            if(com->hasS() && com->S)
+                Commands::resetIsrProfile();
+            break;
 #endif
 #ifdef USE_ADVANCE
         case 233:
@@ -1486,3 +1728,57 @@ void Commands::writeLowestFreeRAM()
     }
 
 }
+
+#if FEATURE_ISR_PROFILER
+void IsrProfile::reset()
+{
+    calls = late = maxTicks = maxLatency = 0;
+    minTicks = 0xffffffff;
+    sumTicks = sumLatency = 0;
+    for(uint8_t i=0; i<ISR_PROFILE_BUCKETS; i++)
+        histogram[i] = 0;
+}
+
+void IsrProfile::report(FSTRINGPARAM(name),unsigned long elapsedMs)
+{
+    IsrProfile p;
+    BEGIN_INTERRUPT_PROTECTED
+    p = *this;
+    END_INTERRUPT_PROTECTED
+    float scale = (p.calls ? 1.0f / (float)ISR_PROFILER_TICKS_PER_US : 0.0f); // ticks to us, 0 without calls
+    Com::printF(name);
+    Com::printF(Com::tCallsColon,(unsigned long)p.calls);
+    Com::printF(Com::tLateColon,(unsigned long)p.late);
+    Com::printF(Com::tMinUsColon,(float)p.minTicks * scale);
+    Com::printF(Com::tMeanUsColon,p.calls ? (float)p.sumTicks * scale / (float)p.calls : 0.0f);
+    Com::printF(Com::tMaxUsColon,(float)p.maxTicks * scale);
+    Com::printF(Com::tLatencyUsColon,p.calls ? (float)p.sumLatency * scale / (float)p.calls : 0.0f);
+    Com::printF(Com::tSlash,(float)p.maxLatency * scale);
+    // busy ticks / (elapsedMs * 1000 * ticks per us) in percent
+    Com::printFLN(Com::tCpuPercentColon,elapsedMs ? (float)p.sumTicks * 0.1f / ((float)elapsedMs * (float)ISR_PROFILER_TICKS_PER_US) : 0.0f);
+    Com::printF(name);
+    Com::printF(Com::tIsrHistogramColon);
+    for(uint8_t i=0; i<ISR_PROFILE_BUCKETS; i++)
+    {
+        if(i) Com::printF(Com::tSlash);
+        Com::print((unsigned long)p.histogram[i]);
+    }
+    Com::println();
+}
+
+void Commands::reportIsrProfile()
+{
+    unsigned long elapsed = HAL::timeInMilliseconds() - isrProfileStart;
+    stepperProfile.report(Com::tStepperIsr,elapsed);
+    pwmProfile.report(Com::tPwmIsr,elapsed);
+}
+
+void Commands::resetIsrProfile()
+{
+    BEGIN_INTERRUPT_PROTECTED
+    stepperProfile.reset();
+    pwmProfile.reset();
+    END_INTERRUPT_PROTECTED
+    isrProfileStart = HAL::timeInMilliseconds();
+}
+#endif // FEATURE_ISR_PROFILER
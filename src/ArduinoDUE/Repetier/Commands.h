@@ -24,6 +24,61 @@
 #ifndef COMMANDS_H_INCLUDED
 #define COMMANDS_H_INCLUDED
 
+#if FEATURE_ISR_PROFILER
+#define ISR_PROFILE_BUCKETS 8
+/** Duration statistics of one interrupt routine in ISR_PROFILER_TICKS_PER_US ticks.
+Filled by the routine itself, read and reset with interrupts disabled. */
+class IsrProfile
+{
+public:
+    uint32_t calls;
+    uint32_t late;         ///< Calls that set their next call to a time already passed
+    uint32_t minTicks;
+    uint32_t maxTicks;
+    uint32_t maxLatency;   ///< Longest time from timer compare to the start of the routine
+    uint64_t sumTicks;
+    uint64_t sumLatency;
+    uint32_t histogram[ISR_PROFILE_BUCKETS]; ///< Calls shorter than 8,16,32 ... 512 us, the last bucket counts all longer calls
+    inline void add(uint32_t ticks,uint32_t latency)
+    {
+        calls++;
+        sumTicks += ticks;
+        sumLatency += latency;
+        if(ticks < minTicks) minTicks = ticks;
+        if(ticks > maxTicks) maxTicks = ticks;
+        if(latency > maxLatency) maxLatency = latency;
+        uint32_t units = ticks / (8 * ISR_PROFILER_TICKS_PER_US);
+        uint8_t bucket = 0;
+        while(units && bucket < ISR_PROFILE_BUCKETS - 1)
+        {
+            units >>= 1;
+            bucket++;
+        }
+        histogram[bucket]++;
+    }
+    void reset();
+    void report(FSTRINGPARAM(name),unsigned long elapsedMs);
+};
+#endif
+
+#if FEATURE_OUTPUT_QUEUE
+#define OUTPUT_ECHO 0
+#define OUTPUT_TEMPERATURES 1
+#define OUTPUT_MAX_LINE 63 // free bytes of an empty AVR serial output buffer
+/** Low priority message waiting until the serial output buffer has room for its line. */
+struct OutputRecord
+{
+    uint8_t type;  ///< OUTPUT_ECHO or OUTPUT_TEMPERATURES
+    bool showRaw;  ///< Temperatures with raw sensor values
+    GCode code;    ///< Echoed command, never with a string
+};
+#endif
+
+#if FEATURE_AUTO_REPORT
+#define AUTO_REPORT_TEMPERATURES 0
+#define AUTO_REPORT_POSITION 1
+#endif
+
 class Commands
 {
 public:
@@ -34,6 +89,14 @@ public:
     static void waitUntilEndOfAllBuffers();
     static void printCurrentPosition();
     static void printTemperatures(bool showRaw = false);
+    static void reportTemperatures(bool showRaw = false);
+#if FEATURE_OUTPUT_QUEUE
+    static void queueEcho(GCode *code);
+    static void sendOutputQueue(bool wait);
+#endif
+#if FEATURE_AUTO_REPORT
+    static void setAutoReport(uint8_t type,GCode *com);
+#endif
     static void setFanSpeed(int speed,bool wait); /// Set fan speed 0..255
     static void changeFeedrateMultiply(int factorInPercent);
     static void changeFlowateMultiply(int factorInPercent);
@@ -41,7 +104,31 @@ public:
     static void emergencyStop();
     static void checkFreeMemory();
     static void writeLowestFreeRAM();
+#if FEATURE_ISR_PROFILER
+    static IsrProfile stepperProfile;
+    static IsrProfile pwmProfile;
+    static void reportIsrProfile();
+    static void resetIsrProfile();
+#endif
 private:
+#if FEATURE_ISR_PROFILER
+    static unsigned long isrProfileStart; ///< Time of the last reset in milliseconds
+#endif
+#if FEATURE_OUTPUT_QUEUE
+    static OutputRecord outputQueue[OUTPUT_QUEUE_SIZE];
+    static uint8_t outputQueueRead;
+    static uint8_t outputQueueLength;
+    static unsigned int outputDropped; ///< Echo lines dropped since the last Info line
+    static uint8_t outputLineLength(OutputRecord &r);
+#endif
+#if FEATURE_AUTO_REPORT
+    static uint16_t autoReportInterval[2]; ///< In 100 ms, 0 = off, indexed by AUTO_REPORT_TEMPERATURES and AUTO_REPORT_POSITION
+    static uint16_t autoReportTicks[2];
+    static uint8_t autoReportBinary;       ///< Bit set for each report sent as binary record
+    static void autoReport();
+    static void sendBinaryReport(uint8_t type);
+#endif
+    static void currentPosition(float pos[4]);
     static int lowestRAMValue;
     static int lowestRAMValueSend;
 };
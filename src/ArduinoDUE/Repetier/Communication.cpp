@@ -21,13 +21,28 @@
 
 #include "Repetier.h"
 
+#if FEATURE_PROTOCOL_V3
+#define REPETIER_PROTOCOL_VERSION "3"
+#else
+#define REPETIER_PROTOCOL_VERSION "2"
+#endif
+#if FEATURE_EXTENDED_OK
+#define EXTENDED_OK_CAPABILITY " EXTENDED_OK:1"
+#else
+#define EXTENDED_OK_CAPABILITY ""
+#endif
+#if FEATURE_AUTO_REPORT
+#define AUTO_REPORT_CAPABILITY " AUTOREPORT:1"
+#else
+#define AUTO_REPORT_CAPABILITY ""
+#endif
 #if DRIVE_SYSTEM==3
-FSTRINGVALUE(Com::tFirmware,"FIRMWARE_NAME:Repetier_" REPETIER_VERSION " FIRMWARE_URL:https://github.com/repetier/Repetier-Firmware/ PROTOCOL_VERSION:1.0 MACHINE_TYPE:Delta EXTRUDER_COUNT:" XSTR(NUM_EXTRUDER) " REPETIER_PROTOCOL:2")
+FSTRINGVALUE(Com::tFirmware,"FIRMWARE_NAME:Repetier_" REPETIER_VERSION " FIRMWARE_URL:https://github.com/repetier/Repetier-Firmware/ PROTOCOL_VERSION:1.0 MACHINE_TYPE:Delta EXTRUDER_COUNT:" XSTR(NUM_EXTRUDER) " REPETIER_PROTOCOL:" REPETIER_PROTOCOL_VERSION EXTENDED_OK_CAPABILITY AUTO_REPORT_CAPABILITY)
 #else
 #if DRIVE_SYSTEM==0
-FSTRINGVALUE(Com::tFirmware,"FIRMWARE_NAME:Repetier_" REPETIER_VERSION " FIRMWARE_URL:https://github.com/repetier/Repetier-Firmware/ PROTOCOL_VERSION:1.0 MACHINE_TYPE:Mendel EXTRUDER_COUNT:" XSTR(NUM_EXTRUDER) " REPETIER_PROTOCOL:2")
+FSTRINGVALUE(Com::tFirmware,"FIRMWARE_NAME:Repetier_" REPETIER_VERSION " FIRMWARE_URL:https://github.com/repetier/Repetier-Firmware/ PROTOCOL_VERSION:1.0 MACHINE_TYPE:Mendel EXTRUDER_COUNT:" XSTR(NUM_EXTRUDER) " REPETIER_PROTOCOL:" REPETIER_PROTOCOL_VERSION EXTENDED_OK_CAPABILITY AUTO_REPORT_CAPABILITY)
 #else
-FSTRINGVALUE(Com::tFirmware,"FIRMWARE_NAME:Repetier_" REPETIER_VERSION " FIRMWARE_URL:https://github.com/repetier/Repetier-Firmware/ PROTOCOL_VERSION:1.0 MACHINE_TYPE:Core_XY EXTRUDER_COUNT:" XSTR(NUM_EXTRUDER) " REPETIER_PROTOCOL:2")
+FSTRINGVALUE(Com::tFirmware,"FIRMWARE_NAME:Repetier_" REPETIER_VERSION " FIRMWARE_URL:https://github.com/repetier/Repetier-Firmware/ PROTOCOL_VERSION:1.0 MACHINE_TYPE:Core_XY EXTRUDER_COUNT:" XSTR(NUM_EXTRUDER) " REPETIER_PROTOCOL:" REPETIER_PROTOCOL_VERSION EXTENDED_OK_CAPABILITY AUTO_REPORT_CAPABILITY)
 #endif
 #endif
 FSTRINGVALUE(Com::tDebug,"Debug:");
@@ -40,7 +55,17 @@ FSTRINGVALUE(Com::tInfo,"Info:")
 FSTRINGVALUE(Com::tWarning,"Warning:")
 FSTRINGVALUE(Com::tResend,"Resend:")
 FSTRINGVALUE(Com::tEcho,"Echo:")
+#if FEATURE_OUTPUT_QUEUE
+FSTRINGVALUE(Com::tEchoLinesDropped,"Echo lines dropped:")
+#endif
 FSTRINGVALUE(Com::tOkSpace,"ok ")
+#if FEATURE_PROTOCOL_V3 || FEATURE_EXTENDED_OK
+FSTRINGVALUE(Com::tOkN,"ok N")
+FSTRINGVALUE(Com::tSpaceB," B")
+#endif
+#if FEATURE_EXTENDED_OK
+FSTRINGVALUE(Com::tSpaceP," P")
+#endif
 FSTRINGVALUE(Com::tWrongChecksum,"Wrong checksum")
 FSTRINGVALUE(Com::tMissingChecksum,"Missing checksum")
 FSTRINGVALUE(Com::tFormatError,"Format error")
@@ -111,7 +136,23 @@ FSTRINGVALUE(Com::tZMinColon,"z_min:")
 FSTRINGVALUE(Com::tZMaxColon,"z_max:")
 FSTRINGVALUE(Com::tJerkColon,"Jerk:")
 FSTRINGVALUE(Com::tZJerkColon," ZJerk:")
+FSTRINGVALUE(Com::tJunctionDeviationColon," Junction deviation:")
 FSTRINGVALUE(Com::tLinearStepsColon," linear steps:")
+FSTRINGVALUE(Com::tUnderrunsColon,"Underruns:")
+FSTRINGVALUE(Com::tMinQueueTimeColon," min queue ms:")
+FSTRINGVALUE(Com::tPlannerTimeColon," planner us:")
+#if FEATURE_ISR_PROFILER
+FSTRINGVALUE(Com::tStepperIsr,"Stepper ISR")
+FSTRINGVALUE(Com::tPwmIsr,"PWM ISR")
+FSTRINGVALUE(Com::tCallsColon," calls:")
+FSTRINGVALUE(Com::tLateColon," late:")
+FSTRINGVALUE(Com::tMinUsColon," min us:")
+FSTRINGVALUE(Com::tMeanUsColon," mean us:")
+FSTRINGVALUE(Com::tMaxUsColon," max us:")
+FSTRINGVALUE(Com::tLatencyUsColon," latency mean/max us:")
+FSTRINGVALUE(Com::tCpuPercentColon," cpu %:")
+FSTRINGVALUE(Com::tIsrHistogramColon," us <8/<16/<32/<64/<128/<256/<512/more:")
+#endif
 FSTRINGVALUE(Com::tQuadraticStepsColon," quadratic steps:")
 FSTRINGVALUE(Com::tCommaSpeedEqual,", speed=")
 FSTRINGVALUE(Com::tEEPROMUpdated,"EEPROM updated")
@@ -219,6 +260,9 @@ FSTRINGVALUE(Com::tAutolevelDisabled,"Autoleveling disabled")
 FSTRINGVALUE(Com::tZProbeFailed,"Z-probe failed")
 FSTRINGVALUE(Com::tZProbeMax,"Z-probe max:")
 FSTRINGVALUE(Com::tZProbePrinterHeight,"Printer height:")
+#if FEATURE_ENDSTOP_INTERRUPTS
+FSTRINGVALUE(Com::tEndstopPolling,"Endstop pin without interrupt, polling endstops")
+#endif
 //FSTRINGVALUE(Com::,"")
 #ifdef WAITING_IDENTIFIER
 FSTRINGVALUE(Com::tWait,WAITING_IDENTIFIER)
@@ -266,6 +310,7 @@ FSTRINGVALUE(Com::tEPRXBacklash,"X backlash [mm]")
 FSTRINGVALUE(Com::tEPRYBacklash,"Y backlash [mm]")
 FSTRINGVALUE(Com::tEPRZBacklash,"Z backlash [mm]")
 FSTRINGVALUE(Com::tEPRMaxJerk,"Max. jerk [mm/s]")
+FSTRINGVALUE(Com::tEPRJunctionDeviation,"Junction deviation [mm], 0 = use jerk")
 #if DRIVE_SYSTEM==3
 FSTRINGVALUE(Com::tEPRZAcceleration,"Acceleration [mm/s^2]")
 FSTRINGVALUE(Com::tEPRZTravelAcceleration,"Travel acceleration [mm/s^2]")
@@ -36,7 +36,17 @@ FSTRINGVAR(tInfo)
 FSTRINGVAR(tWarning)
 FSTRINGVAR(tResend)
 FSTRINGVAR(tEcho)
+#if FEATURE_OUTPUT_QUEUE
+FSTRINGVAR(tEchoLinesDropped)
+#endif
 FSTRINGVAR(tOkSpace)
+#if FEATURE_PROTOCOL_V3 || FEATURE_EXTENDED_OK
+FSTRINGVAR(tOkN)
+FSTRINGVAR(tSpaceB)
+#endif
+#if FEATURE_EXTENDED_OK
+FSTRINGVAR(tSpaceP)
+#endif
 FSTRINGVAR(tWrongChecksum)
 FSTRINGVAR(tMissingChecksum)
 FSTRINGVAR(tFormatError)
@@ -107,7 +117,23 @@ FSTRINGVAR(tZMinColon)
 FSTRINGVAR(tZMaxColon)
 FSTRINGVAR(tJerkColon)
 FSTRINGVAR(tZJerkColon)
+FSTRINGVAR(tJunctionDeviationColon)
 FSTRINGVAR(tLinearStepsColon)
+FSTRINGVAR(tUnderrunsColon)
+FSTRINGVAR(tMinQueueTimeColon)
+FSTRINGVAR(tPlannerTimeColon)
+#if FEATURE_ISR_PROFILER
+FSTRINGVAR(tStepperIsr)
+FSTRINGVAR(tPwmIsr)
+FSTRINGVAR(tCallsColon)
+FSTRINGVAR(tLateColon)
+FSTRINGVAR(tMinUsColon)
+FSTRINGVAR(tMeanUsColon)
+FSTRINGVAR(tMaxUsColon)
+FSTRINGVAR(tLatencyUsColon)
+FSTRINGVAR(tCpuPercentColon)
+FSTRINGVAR(tIsrHistogramColon)
+#endif
 FSTRINGVAR(tQuadraticStepsColon)
 FSTRINGVAR(tCommaSpeedEqual)
 FSTRINGVAR(tLinearLColon)
@@ -215,6 +241,9 @@ FSTRINGVAR(tAutolevelDisabled)
 FSTRINGVAR(tZProbeFailed)
 FSTRINGVAR(tZProbeMax)
 FSTRINGVAR(tZProbePrinterHeight)
+#if FEATURE_ENDSTOP_INTERRUPTS
+FSTRINGVAR(tEndstopPolling)
+#endif
 
 #ifdef WAITING_IDENTIFIER
 FSTRINGVAR(tWait)
@@ -254,6 +283,7 @@ FSTRINGVAR(tEPRPrinterActive)
 FSTRINGVAR(tEPRMaxInactiveTime)
 FSTRINGVAR(tEPRStopAfterInactivty)
 FSTRINGVAR(tEPRMaxJerk)
+FSTRINGVAR(tEPRJunctionDeviation)
 FSTRINGVAR(tEPRXHomePos)
 FSTRINGVAR(tEPRYHomePos)
 FSTRINGVAR(tEPRZHomePos)
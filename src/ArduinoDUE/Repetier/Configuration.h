@@ -654,6 +654,14 @@ on this endstop.
 // can set it on for safety.
 #define ALWAYS_CHECK_ENDSTOPS true
 
+/* With FEATURE_ENDSTOP_INTERRUPTS the endstop and z-probe pins raise a pin change interrupt
+(AVR external or pin change interrupt, PIO interrupt on DUE) that stores which of them are triggered.
+The stepper interrupt then only tests this byte and reads the pins only while one is triggered.
+On AVR not every pin can raise an interrupt, on RAMPS all endstop pins can. If one can not,
+the firmware warns at startup and polls the endstops like without this feature.
+*/
+#define FEATURE_ENDSTOP_INTERRUPTS false
+
 // maximum positions in mm - only fixed numbers!
 // For delta robot Z_MAX_LENGTH is the maximum travel of the towers and should be set to the distance between the hotend
 // and the platform when the printer is at its home position.
@@ -687,6 +695,27 @@ on this endstop.
 #define DELTA_SEGMENTS_PER_SECOND_PRINT 180 // Move accurate setting for print moves
 #define DELTA_SEGMENTS_PER_SECOND_MOVE 70 // Less accurate setting for other moves
 
+/** \brief Choose the number of delta segments from the deviation of the carriage paths instead of the time.
+
+A carriage moves on a curve, while the stepper interrupt moves it linearly between two segment ends. With this
+mode the segment count of a move keeps that deviation below DELTA_SEGMENT_MAX_DEVIATION mm, computed from the
+rod angles at both ends of the move. Near the center, where the carriages move nearly linearly, moves get
+much fewer segments, near the rim more. The segments per second settings are not used then.
+*/
+#define FEATURE_DELTA_ADAPTIVE_SEGMENTS false
+#define DELTA_SEGMENT_MAX_DEVIATION 0.01 // mm, about one step
+
+/** \brief Limit speeds and accelerations by the towers instead of the cartesian axes only.
+
+Near the rim a carriage moves much faster than the effector, so the cartesian limits alone can make
+a tower exceed its feedrate or jerk. With this feature the fastest tower of each line is limited
+to the tower feedrate and acceleration, which delta printers take from the Z axis settings. At the
+join of two moves no tower changes its speed by more than the jerk or exceeds its feedrate, computed
+from the rod angles at the join. This allows to set the real tower limits instead of lowering the
+global ones.
+*/
+#define FEATURE_DELTA_TOWER_LIMITS false
+
 // Delta settings
 #if DRIVE_SYSTEM==3
 /** \brief Delta rod length
@@ -767,6 +796,16 @@ will be allocated for the delta buffer. With defaults 7 * 16 * 22 = 2464 bytes.
 Mega. Used only for nonlinear systems like delta or tuga. */
 #define MAX_DELTA_SEGMENTS_PER_LINE 22
 
+/** \brief Compute delta segments just before the stepper interrupt needs them.
+
+Instead of storing all segments with the line, a queued delta move keeps only its cartesian start, the tower
+positions at the start and the segment count. The tower steps of the next segments are computed from the main
+loop and the pwm timer interrupt into a small ring of DELTA_SEGMENT_BUFFER_SIZE segments. If it runs empty, the stepper interrupt
+computes the segment itself. A line then needs 25 byte instead of 7 byte per segment, so MOVE_CACHE_SIZE
+can be increased with the RAM saved.
+*/
+#define FEATURE_DELTA_SEGMENTS_ON_THE_FLY false
+
 /** After x seconds of inactivity, the stepper motors are disabled.
     Set to 0 to leave them enabled.
     This helps cooling the Stepper motors between two print jobs.
@@ -805,6 +844,16 @@ own weight, so this is nearly never needed. */
 /** Comment this to disable ramp acceleration */
 #define RAMP_ACCELERATION 1
 
+/** If enabled, the acceleration and deceleration ramps use a jerk limited S-curve instead of
+a constant acceleration. The acceleration rises and falls linearly with S_CURVE_JERK [mm/s^3],
+which reduces ringing. The peak acceleration is the configured one, so each ramp takes
+acceleration/jerk longer than the trapezoid and short lines reach a lower speed. Lines too
+short to change their speed within the jerk limit use a higher jerk, never a higher acceleration.
+Typical jerk values are 100000-300000. Needs RAMP_ACCELERATION.
+*/
+#define FEATURE_S_CURVE_ACCELERATION false
+#define S_CURVE_JERK 200000
+
 /** If your stepper needs a longer high signal then given, you can add a delay here.
 The delay is realized as a simple loop wasting time, which is not available for other
 computations. So make it as low as possible. For the most common drivers no delay is needed, as the
@@ -829,11 +878,61 @@ for some printers causing an early stall.
 */
 #define DOUBLE_STEP_DELAY 1 // time in microseconds
 
+/** With the step buffer, the Bresenham and acceleration computations run outside the stepper interrupt.
+They fill a ring of STEP_BUFFER_SIZE step events (axes to step, directions, ticks to wait) from the main loop and a software interrupt
+the pwm timer raises. It runs below the pwm and servo timer, so it does not delay them.
+The stepper interrupt only executes these events, so the pulse timing no longer depends on the
+complexity of the move. Moves checking endstops are only buffered one event ahead, so the feature
+requires ALWAYS_CHECK_ENDSTOPS false. Not usable with USE_ADVANCE and XY gantries.
+STEP_BUFFER_SIZE must be a power of 2 up to 256 and each event needs 8 byte.
+*/
+#define FEATURE_STEP_BUFFER false
+#define STEP_BUFFER_SIZE 128
+
+/** \brief Write the step pins sharing one port with one port access.
+
+The step port is the port of Y_STEP_PIN if Y and Z share a port without X, otherwise the port of X_STEP_PIN.
+The stepper interrupt collects the step pins of one step on that port in a mask and sets and clears them
+with one port write each, so they rise at the same time. Step pins on other ports are still written one
+by one. The masks are computed from pins.h, so this only helps on boards with at least two step pins on
+one port. The extruder is only included with one extruder. On AVR the
+port is written read-modify-write, so no other interrupt may change pins of that port.
+*/
+#define FEATURE_STEP_PORT_MASKS false
+
+/** \brief Measure the stepper and pwm interrupts.
+
+Times every stepper and pwm interrupt with the cycle counter and counts stepper interrupts that could
+not start at the requested time. M235 reports minimum, mean and maximum duration, a histogram of the
+durations, the latency from timer compare to start and the share of cpu time of each interrupt.
+M235 S1 resets the statistics after reporting them. Durations include interrupts running in between.
+*/
+#define FEATURE_ISR_PROFILER false
+
 /** The firmware supports trajectory smoothing. To achieve this, it divides the stepsize by 2, resulting in
 the double computation cost. For slow movements this is not an issue, but for really fast moves this is
 too much. The value specified here is the number of clock cycles between a step on the driving axis.
 If the interval at full speed is below this value, smoothing is disabled for that line.*/
 #define MAX_HALFSTEP_INTERVAL 1999
+/** Slow lines can be smoothed even more. Smoothing level n divides the step size by 2^n, so steps of
+the other axes are spaced more evenly. Level n is used for lines with an interval at full speed of at
+least MAX_HALFSTEP_INTERVAL*2^(n-1), so the stepper interrupt never runs faster than with level 1.
+0 = no smoothing, 1 = only divide by 2 like older versions, maximum is 3.
+Values above 1 are optional. They change the step timing of slow moves and call the stepper interrupt up
+to 4 times as often for them, so check the cpu load with FEATURE_ISR_PROFILER before using them.*/
+#define MAX_STEP_SMOOTHING 1
+
+/** \brief Compute the speed changes of accelerating and decelerating moves in a separate interrupt.
+
+The stepper interrupt only emits the steps and requests the new speed from a software interrupt with a
+priority between the stepper and the pwm interrupt. That interrupt computes the speed, interval and steps per
+timer call and moves the pending compare of the stepper timer to the new interval. So the speed update no
+longer needs its own timer call of a smoothed step and MAX_STEP_SMOOTHING 0 still keeps the stepper interrupt short.
+The ramp calls get shorter, but the extra interrupt costs more time than it saves, so the maximum step rate
+does not rise. Only tested in the simulation, check it with FEATURE_ISR_PROFILER before using it.
+Not usable with FEATURE_STEP_BUFFER and USE_ADVANCE.
+*/
+#define FEATURE_DEFERRED_SPEED_UPDATE false
 
 //// Acceleration settings
 
@@ -875,26 +974,69 @@ Overridden if EEPROM activated.
 #define MAX_JERK 20.0
 #define MAX_ZJERK 0.3
 
+/** \brief Junction deviation in mm for the speed at the join of two segments.
+
+If set to a value greater 0, the join speed is no longer limited by the jerk, but by the angle
+between the segments. The head is allowed to move with the acceleration of the printer on a circle
+touching both segments, whose distance to the corner is the junction deviation:
+
+v = sqrt(acceleration * deviation * sin(angle/2) / (1 - sin(angle/2)))
+
+Straight joins are not limited, reversals stop. On curves split into many small segments this allows
+much higher speeds than the jerk, without exceeding the acceleration. 0.01 - 0.05 are typical values.
+The jerk is still used for the start speed and the extruder jerk is checked in both modes.
+Set to 0 to use the jerk for all joins. Overridden if EEPROM activated.
+*/
+#define JUNCTION_DEVIATION 0
+
 /** \brief Number of moves we can cache in advance.
 
 This number of moves can be cached in advance. If you wan't to cache more, increase this. Especially on
-many very short moves the cache may go empty. The minimum value is 5.
+many very short moves the cache may go empty. The minimum value is 5. Deltas computing their segments on the
+fly need less RAM per move and get the double size.
 */
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY && DRIVE_SYSTEM==3
+#define MOVE_CACHE_SIZE 64
+#else
 #define MOVE_CACHE_SIZE 32
+#endif
+
+/** \brief Number of moves the path planner can still optimize.
+
+The path planner data is only stored for the last PLANNER_CACHE_SIZE moves of the cache, older moves get
+executed as planned. A planner record needs 48 byte, a cached move 49 byte plus 7 byte per delta segment
+(25 byte with FEATURE_DELTA_SEGMENTS_ON_THE_FLY).
+This allows a cartesian printer to use the double MOVE_CACHE_SIZE with the RAM needed for a single planner
+record per move. MOVE_CACHE_SIZE must be a multiple of this value, the minimum value is 4.
+*/
+#define PLANNER_CACHE_SIZE 16
+
+/** \brief Join tiny collinear moves.
+
+Slicers split curved walls into many very short segments. Each of them costs a planner run and a place in the
+move cache. With move merging, consecutive G0/G1 moves with the same feedrate and extrusion per mm are joined
+into one move, as long as all corners stay within MOVE_MERGE_TOLERANCE mm of the joined line.
+At most MOVE_MERGE_MAX_SEGMENTS moves are joined. The last move is held back until the next command arrives
+or the move cache runs low.
+*/
+#define FEATURE_MOVE_MERGING false
+#define MOVE_MERGE_TOLERANCE 0.01
+#define MOVE_MERGE_MAX_SEGMENTS 8
 
 /** \brief Low filled cache size.
 
-If the cache contains less then MOVE_CACHE_LOW segments, the time per segment is limited to LOW_TICKS_PER_MOVE clock cycles.
-If a move would be shorter, the feedrate will be reduced. This should prevent buffer underflows. Set this to 0 if you
-don't care about empty buffers during print.
+If the cache contains less then MOVE_CACHE_LOW segments, the firmware measures how fast new moves arrive
+and reduces the feedrate of moves, that would finish before the next move arrives. This should prevent buffer
+underflows, e.g. from many very short segments. Set this to 0 if you don't care about empty buffers during print.
+M234 reports the number of underruns and the lowest time left in the queue.
 */
 #define MOVE_CACHE_LOW 14
-/** \brief Cycles per move, if move cache is low.
+/** \brief Minimum time in clock cycles the queued moves should last, if move cache is low.
 
-This value must be high enough, that the buffer has time to fill up. The problem only occurs at the beginning of a print or
-if you are printing many very short segments at high speed. Higher delays here allow higher values in PATH_PLANNER_CHECK_SEGMENTS.
+If less time is queued, new moves get slower until the buffer has filled up. The problem only occurs at the beginning
+of a print or if you are printing many very short segments at high speed.
 */
-#define LOW_TICKS_PER_MOVE 250000
+#define LOW_QUEUE_TICKS 500000
 
 // ##########################################################################################
 // ##                           Extruder control                                           ##
@@ -925,6 +1067,17 @@ Uncomment to allow a quadratic advance dependency. Linear is the dominant value,
 to activate the quadratic term. Only adds lots of computations and storage usage. */
 #define ENABLE_QUADRATIC_ADVANCE
 
+/** \brief Execute the advance steps in the stepper interrupt.
+
+Without it, moves with advance hand all extruder steps to the extruder timer interrupt, which executes
+them at the fixed rate of the maximum extruder feedrate. With it, the stepper interrupt executes the
+Bresenham extruder steps and the change of the advance offset computed with each speed update together
+with the steps of the other axes, at most one extruder step per Bresenham step. So the extruder runs at
+v_e + L*a_e in step with the other axes and the extruder timer is not used. Advance steps left after the
+last move are executed by the idle stepper interrupt at the maximum extruder feedrate.
+*/
+#define FEATURE_BRESENHAM_ADVANCE false
+
 
 // ##########################################################################################
 // ##                           Communication configuration                                ##
@@ -969,13 +1122,75 @@ There should be no reason to increase this cache. Commands are nearly immediatel
 execution.
 */
 #define GCODE_BUFFER_SIZE 2
+/** \brief Stores buffered commands compactly.
+
+Without it every buffered command needs the full GCode structure with all parameters (52 bytes on AVR).
+With it, only the parameters a command has are stored in a ring of GCODE_RING_SIZE bytes, e.g. 24 bytes
+for G1 X Y E F with line number, and the command is decoded when it gets executed. New commands are
+read as long as a command with all parameters still fits, so a ring of 256 bytes holds about 10 moves.
+The extended ok and protocol v3 announce as B how many commands of the mean size stored recently fit
+besides that reserve. GCODE_BUFFER_SIZE is not used then. GCODE_RING_SIZE can be at most 256.
+*/
+#define FEATURE_COMPACT_COMMAND_BUFFER false
+#define GCODE_RING_SIZE 256
 /** Appends the linenumber after every ok send, to acknowledge the received command. Uncomment for plain ok ACK if your host has problems with this */
 #define ACK_WITH_LINENUMBER
+/** \brief Extended acknowledgement with free buffers
+
+With this feature every stored command is acknowledged with "ok N<line> P<free moves> B<free command buffers>"
+instead of the plain ok (without N if the line had no line number). A host may send as many further lines
+as B tells without waiting for the next ok, and always one line, so it can keep the command buffer full
+and never overfills it. P is the number of free entries in the move cache. Version 3 frame acks also
+contain P then. Hosts detect the feature by EXTENDED_OK:1 in the M115 response.
+*/
+#define FEATURE_EXTENDED_OK false
 /** Communication errors can swollow part of the ok, which tells the host software to send
 the next command. Not receiving it will cause your printer to stop. Sending this string every
 second, if our queue is empty should prevent this. Comment it, if you don't wan't this feature. */
 #define WAITING_IDENTIFIER "wait"
 
+/** \brief Windowed binary protocol (repetier protocol version 3)
+
+With this feature the firmware also accepts frames containing several binary commands with one
+checksum. A frame is acknowledged with one "ok N<last line> B<free command buffers>" and the host
+may send as many further commands without waiting as B allows, so the connection is not idle while
+an ok is on its way. A wrong frame is answered with the normal Resend:<line> and the host repeats all
+unacknowledged lines from there. The window can never get larger than the free command buffers, so
+increase GCODE_BUFFER_SIZE e.g. to 16 to profit from it. PROTOCOL_V3_FRAME_SIZE is the largest frame in
+bytes (max. 255). It replaces the 96 byte receive buffer if it is larger. Hosts detect the feature by
+REPETIER_PROTOCOL:3 in the M115 response.
+*/
+#define FEATURE_PROTOCOL_V3 false
+#define PROTOCOL_V3_FRAME_SIZE 128
+
+/** \brief Queue for temperature reports and echo
+
+Without it the firmware waits whenever the 64 byte serial output buffer is full, e.g. while echo
+lines or temperature reports are sent, and fills no moves meanwhile. With this feature temperature
+reports and echoed commands are stored as fixed size records and only formatted to text, when the
+output buffer has room for the line. A new temperature report is merged with one still waiting and
+echo lines that find the queue full are dropped, an Info line tells how many. Commands with a string
+are echoed directly after all queued messages. Each record needs about 55 bytes of ram.
+The Due serial driver does not report its free output space, so all messages are sent at once
+like without the queue.
+*/
+#define FEATURE_OUTPUT_QUEUE false
+#define OUTPUT_QUEUE_SIZE 4
+
+/** \brief Automatic temperature and position reports
+
+With this feature M155 S<seconds> sends the temperatures and M154 S<seconds> the position every S seconds
+without a request, S0 stops them. Hosts then need no M105 and M114 polling, which costs a command buffer
+and an ok each time. P1 switches a report to a compact binary record for hosts using the binary protocol:
+- 0x81 for temperatures or 0x82 for the position
+- 8 bit payload length
+- Temperatures: for each extruder and then the heated bed 16 bit current and 16 bit target temperature
+  in 0.1 degC and the 8 bit heater output. Position: X, Y, Z and E as 32 bit floats like M114 reports them.
+- 16 bit fletcher-16 checksum over all bytes before
+Hosts detect the feature by AUTOREPORT:1 in the M115 response.
+*/
+#define FEATURE_AUTO_REPORT false
+
 /** \brief Sets time for echo debug
 
 You can set M111 1 which enables ECHO of commands sent. This define specifies the position,
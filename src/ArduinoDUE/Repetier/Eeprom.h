@@ -20,7 +20,7 @@
 #define _EEPROM_H
 
 // Id to distinguish version changes
-#define EEPROM_PROTOCOL_VERSION 6
+#define EEPROM_PROTOCOL_VERSION 7
 
 /** Where to start with our datablock in memory. Can be moved if you
 have problems with other modules using the eeprom */
@@ -101,6 +101,7 @@ have problems with other modules using the eeprom */
 #define EPR_DELTA_RADIUS_CORR_A   913
 #define EPR_DELTA_RADIUS_CORR_B   917
 #define EPR_DELTA_RADIUS_CORR_C   921
+#define EPR_JUNCTION_DEVIATION    925
 
 #define EEPROM_EXTRUDER_OFFSET 200
 // bytes per extruder needed, leave some space for future development
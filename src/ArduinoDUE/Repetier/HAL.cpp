@@ -47,12 +47,26 @@ HAL::~HAL()
     //dtor
 }
 
-
-long HAL::CPUDivU2(unsigned int divisor)
+uint16_t HAL::integerSqrt(long a)
 {
-    return F_CPU/divisor;
+    // Same rounding as the avr assembler version: nearest integer, 0.5 rounds up
+    unsigned long op = a, res = 0, one = 1UL << 30;
+    while(one > op) one >>= 2;
+    while(one != 0)
+    {
+        if(op >= res + one)
+        {
+            op -= res + one;
+            res += one << 1;
+        }
+        res >>= 1;
+        one >>= 2;
+    }
+    if(op > res) res++;
+    return res;
 }
 
+
 // Set up all timer interrupts 
 void HAL::setupTimer() {
     uint32_t     tc_count, tc_clock;
@@ -62,7 +76,7 @@ void HAL::setupTimer() {
     // set 3 bits for interrupt group priority, 2 bits for sub-priority
     NVIC_SetPriorityGrouping(4);
 
-#if defined(USE_ADVANCE)
+#if defined(USE_ADVANCE) && !FEATURE_BRESENHAM_ADVANCE
     // Timer for extruder control
     pmc_enable_periph_clk(EXTRUDER_TIMER_IRQ);  // enable power to timer
     NVIC_SetPriority((IRQn_Type)EXTRUDER_TIMER_IRQ, NVIC_EncodePriority(4, 1, 1));
@@ -109,6 +123,24 @@ void HAL::setupTimer() {
     TIMER1_TIMER->TC_CHANNEL[TIMER1_TIMER_CHANNEL].TC_IDR = ~TC_IER_CPCS;
     NVIC_EnableIRQ((IRQn_Type)TIMER1_TIMER_IRQ); 
 
+#if FEATURE_DEFERRED_SPEED_UPDATE
+    // Speed updates run below the stepper and above the pwm timer
+    NVIC_SetPriority((IRQn_Type)SPEED_UPDATE_IRQ, NVIC_EncodePriority(4, 2, 1));
+    NVIC_EnableIRQ((IRQn_Type)SPEED_UPDATE_IRQ);
+#endif
+#if FEATURE_STEP_BUFFER
+    // The step buffer is refilled below the pwm and servo timer, so they keep their timing
+    NVIC_SetPriority((IRQn_Type)STEP_BUFFER_IRQ, NVIC_EncodePriority(4, 4, 0));
+    NVIC_EnableIRQ((IRQn_Type)STEP_BUFFER_IRQ);
+#endif
+
+#if FEATURE_ISR_PROFILER
+    // Free running cpu cycle counter for the interrupt profiler
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
     // Servo control
 #if FEATURE_SERVO
 #if SERVO0_PIN>-1
@@ -229,6 +261,18 @@ void HAL::resetHardware() {
     RSTC->RSTC_CR = RSTC_CR_KEY(0xA5) | RSTC_CR_PERRST | RSTC_CR_PROCRST;
 }
 
+#if FEATURE_ENDSTOP_INTERRUPTS
+static void endstopInterrupt() {
+    Printer::updateEndstops();
+}
+
+// Every pin of the SAM3X can raise a PIO interrupt, so this never fails
+bool HAL::attachEndstopInterrupt(uint8_t pin) {
+    attachInterrupt(pin, endstopInterrupt, CHANGE);
+    return true;
+}
+#endif
+
 
 #ifndef DUE_SOFTWARE_SPI
    // hardware SPI
@@ -685,6 +729,36 @@ inline void setTimer(unsigned long delay)
     TC_Start(TIMER1_TIMER, TIMER1_TIMER_CHANNEL);
 }
 
+#if FEATURE_DEFERRED_SPEED_UPDATE
+/** \brief Moves the pending timer 1 compare to wait ticks after the last call.
+
+The counter is not restarted, it still counts from the last call. If that time has already
+passed, the call comes as soon as possible.
+*/
+void HAL::moveStepperTimer(unsigned long wait)
+{
+    uint32_t timer_count = (wait * TIMER1_PRESCALE);
+    uint32_t minCount = TIMER1_TIMER->TC_CHANNEL[TIMER1_TIMER_CHANNEL].TC_CV + 100 * TIMER1_PRESCALE;
+    if(timer_count < minCount) timer_count = minCount;
+    TC_SetRC(TIMER1_TIMER, TIMER1_TIMER_CHANNEL, timer_count);
+}
+
+/** \brief Software interrupt computing the speed changes requested by the stepper interrupt.
+*/
+void SPEED_UPDATE_VECTOR ()
+{
+    PrintLine::deferredSpeedUpdate();
+}
+#endif
+#if FEATURE_STEP_BUFFER
+/** \brief Software interrupt refilling the step buffer while the main loop is busy.
+*/
+void STEP_BUFFER_VECTOR ()
+{
+    PrintLine::fillStepBuffer();
+}
+#endif
+
 /** \brief Timer interrupt routine to drive the stepper motors.
 */
 void TIMER1_COMPA_VECTOR ()
@@ -693,9 +767,27 @@ void TIMER1_COMPA_VECTOR ()
     TC_GetStatus(TIMER1_TIMER, TIMER1_TIMER_CHANNEL);
     if(HAL::insideTimer1) return;
     HAL::insideTimer1 = 1;
+#if FEATURE_ISR_PROFILER
+    // The counter restarts at the RC compare, so it holds the latency in timer ticks
+    uint32_t profileLatency = TIMER1_TIMER->TC_CHANNEL[TIMER1_TIMER_CHANNEL].TC_CV * TIMER1_PRESCALE;
+    uint32_t profileStart = DWT->CYCCNT;
+#endif
     if(PrintLine::hasLines())
     {
+#if FEATURE_ISR_PROFILER
+        // setTimer restarts the counter, so the next call is never requested for a time already passed
+#if FEATURE_STEP_BUFFER
+        unsigned long delay = PrintLine::executeStepEvents();
+#else
+        unsigned long delay = PrintLine::bresenhamStep();
+#endif
+        Commands::stepperProfile.add(DWT->CYCCNT - profileStart,profileLatency);
+        setTimer(delay);
+#elif FEATURE_STEP_BUFFER
+        setTimer(PrintLine::executeStepEvents());
+#else
         setTimer(PrintLine::bresenhamStep());
+#endif
         HAL::allowInterrupts();
     }
     else
@@ -718,6 +810,10 @@ void TIMER1_COMPA_VECTOR ()
 #endif
         }
         else waitRelax--;
+#if FEATURE_BRESENHAM_ADVANCE
+        unsigned int advanceWait = PrintLine::idleAdvanceStep();
+        if(advanceWait) setTimer(advanceWait);
+#endif
     }
     DEBUG_MEMORY;
     HAL::insideTimer1=0;
@@ -735,6 +831,9 @@ void PWM_TIMER_VECTOR ()
     static uint8_t pwm_count = 0;
     static uint8_t pwm_pos_set[NUM_EXTRUDER+3];
     static uint8_t pwm_cooler_pos_set[NUM_EXTRUDER];
+#if FEATURE_ISR_PROFILER
+    uint32_t profileStart = DWT->CYCCNT;
+#endif
 
     if(pwm_count==0)
     {
@@ -874,6 +973,17 @@ void PWM_TIMER_VECTOR ()
 #endif
     UI_FAST; // Short timed user interface action
     pwm_count++;
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+    // Keep the next delta segments ready while the main loop is busy
+    PrintLine::fillDeltaSegments();
+#endif
+#if FEATURE_STEP_BUFFER
+    // Refill the buffer after this interrupt, in the lower priority step buffer interrupt
+    HAL::triggerStepBufferFill();
+#endif
+#if FEATURE_ISR_PROFILER
+    Commands::pwmProfile.add(DWT->CYCCNT - profileStart,0);
+#endif
 }
 
 
@@ -886,7 +996,7 @@ interrupt, one step is executed. This will keep the extruder
 moving, until the total wanted movement is achieved. This will 
 be done with the maximum allowable speed for the extruder. 
 */
-#if defined(USE_ADVANCE)
+#if defined(USE_ADVANCE) && !FEATURE_BRESENHAM_ADVANCE
 // EXTRUDER_TIMER IRQ handler
 void EXTRUDER_TIMER_VECTOR ()
 {
@@ -87,6 +87,10 @@ typedef char prog_char;
 #define SERVO_TIMER_CHANNEL     0
 #define SERVO_TIMER_IRQ         ID_TC6
 #define SERVO_COMPA_VECTOR      TC6_Handler
+#define SPEED_UPDATE_IRQ        ID_TC7  // timer not started, only used as software interrupt
+#define SPEED_UPDATE_VECTOR     TC7_Handler
+#define STEP_BUFFER_IRQ         ID_TC7  // software interrupt, FEATURE_STEP_BUFFER excludes FEATURE_DEFERRED_SPEED_UPDATE
+#define STEP_BUFFER_VECTOR      TC7_Handler
 #define BEEPER_TIMER            TC1
 #define BEEPER_TIMER_CHANNEL    0
 #define BEEPER_TIMER_IRQ        ID_TC3
@@ -146,12 +150,28 @@ typedef char prog_char;
 #define	SET_OUTPUT(pin) PIO_Configure(g_APinDescription[pin].pPort, PIO_OUTPUT_1, \
     g_APinDescription[pin].ulPin, g_APinDescription[pin].ulPinConfiguration)
 #define TOGGLE(pin) WRITE(pin,!READ(pin))
+/* Step port for FEATURE_STEP_PORT_MASKS: the PIO controller of Y_STEP_PIN if Y and Z share one
+   without X, otherwise the one of X_STEP_PIN. Its set and clear registers change all pins of a
+   mask in one write. */
+inline Pio *stepPort()
+{
+    Pio *port = g_APinDescription[Y_STEP_PIN].pPort;
+    return port == g_APinDescription[Z_STEP_PIN].pPort && port != g_APinDescription[X_STEP_PIN].pPort ? port : g_APinDescription[X_STEP_PIN].pPort;
+}
+#define STEP_PORT_MASK(pin) (g_APinDescription[pin].pPort == stepPort() ? g_APinDescription[pin].ulPin : 0)
+#define STEP_PORT_SET(mask) stepPort()->PIO_SODR = (mask)
+#define STEP_PORT_CLEAR(mask) stepPort()->PIO_CODR = (mask)
+typedef uint32_t step_port_t;
 #define LOW         0
 #define HIGH        1
 
 #define BEGIN_INTERRUPT_PROTECTED noInterrupts();
 #define END_INTERRUPT_PROTECTED interrupts();
 #define ESCAPE_INTERRUPT_PROTECTED  interrupts();
+// FEATURE_ISR_PROFILER counts cpu cycles with the DWT cycle counter
+#define ISR_PROFILER_TICKS_PER_US (F_CPU_TRUE/1000000)
+// FEATURE_DEFERRED_SPEED_UPDATE raises SPEED_UPDATE_IRQ by software
+#define HAL_SPEED_UPDATE_INTERRUPT
 
 #define EEPROM_OFFSET               0
 #define SECONDS_TO_TICKS(s) (unsigned long)(s*(float)F_CPU)
@@ -225,6 +245,8 @@ public:
         TC_Start(DELAY_TIMER, DELAY_TIMER_CHANNEL);
     }
 
+    // Square root of an unsigned 32 bit value, rounded to the nearest integer
+    static uint16_t integerSqrt(long a);
     // return val'val
     static inline unsigned long U16SquaredToU32(unsigned int val)
     {
@@ -261,7 +283,12 @@ public:
         if (mode == INPUT) {SET_INPUT(pin);}
         else SET_OUTPUT(pin);
     }
-    static long CPUDivU2(unsigned int divisor);
+    // The Cortex-M3 divides in hardware within 2-12 cycles, which is faster than the
+    // interpolated lookup table used on AVR. Inlined to save the call in the stepper interrupt.
+    static inline long CPUDivU2(unsigned int divisor)
+    {
+        return F_CPU/divisor;
+    }
     static inline void delayMicroseconds(unsigned int delayUs)
     {
         microsecondsWait(delayUs);
@@ -406,6 +433,10 @@ public:
     {
         return millis();
     }
+    static inline unsigned long timeInMicroseconds()
+    {
+        return micros();
+    }
     static inline char readFlashByte(PGM_P ptr)
     {
         return pgm_read_byte(ptr);
@@ -430,10 +461,31 @@ public:
     {
         RFSERIAL.flush();
     }
+    /** Bytes that can be written without waiting for the UART, not reported by the Due serial driver. */
+    static inline int serialOutputUnused()
+    {
+        return 255;
+    }
     static void setupTimer();
     static void showStartReason();
     static int getFreeRam();
     static void resetHardware();
+#if FEATURE_ENDSTOP_INTERRUPTS
+    static bool attachEndstopInterrupt(uint8_t pin);
+#endif
+#if FEATURE_DEFERRED_SPEED_UPDATE
+    static inline void triggerSpeedUpdate()
+    {
+        NVIC_SetPendingIRQ((IRQn_Type)SPEED_UPDATE_IRQ);
+    }
+    static void moveStepperTimer(unsigned long wait);
+#endif
+#if FEATURE_STEP_BUFFER
+    static inline void triggerStepBufferFill()
+    {
+        NVIC_SetPendingIRQ((IRQn_Type)STEP_BUFFER_IRQ);
+    }
+#endif
 
     // SPI related functions
 
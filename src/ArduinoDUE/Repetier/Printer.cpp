@@ -22,6 +22,9 @@
 uint8_t Printer::minExtruderSpeed;            ///< Timer delay for start extruder speed
 uint8_t Printer::maxExtruderSpeed;            ///< Timer delay for end extruder speed
 volatile int Printer::extruderStepsNeeded; ///< This many extruder steps are still needed, <0 = reverse steps needed.
+#if FEATURE_BRESENHAM_ADVANCE
+int8_t Printer::extruderLastDirection = 0;
+#endif
 //uint8_t Printer::extruderAccelerateDelay;     ///< delay between 2 speec increases
 #endif
 uint8_t Printer::unitIsInches = 0; ///< 0 = Units are mm, 1 = units are inches.
@@ -55,6 +58,9 @@ uint8_t Printer::flag0 = 0;
 uint8_t Printer::flag1 = 0;
 uint8_t Printer::debugLevel = 6; ///< Bitfield defining debug output. 1 = echo, 2 = info, 4 = error, 8 = dry run., 16 = Only communication, 32 = No moves
 uint8_t Printer::stepsPerTimerCall = 1;
+#if FEATURE_STEP_PORT_MASKS
+step_port_t Printer::stepPortBits = 0;
+#endif
 uint8_t Printer::menuMode = 0;
 
 #if FEATURE_AUTOLEVEL
@@ -71,8 +77,18 @@ int Printer::advanceStepsSet;
 #endif
 #if NONLINEAR_SYSTEM
 long Printer::maxDeltaPositionSteps;
+#if DRIVE_SYSTEM==3
+long Printer::deltaDiagonalSteps;
+unsigned long Printer::deltaDiagonalStepsSquared;
+#if CPU_ARCH==ARCH_AVR
+float Printer::deltaDiagonalStepsSquaredF;
+#else
+uint8_t Printer::deltaSqrtShift;
+#endif
+#else
 long Printer::deltaDiagonalStepsSquared;
 float Printer::deltaDiagonalStepsSquaredF;
+#endif
 long Printer::deltaAPosXSteps;
 long Printer::deltaAPosYSteps;
 long Printer::deltaBPosXSteps;
@@ -86,6 +102,9 @@ long Printer::realDeltaPositionSteps[3];
 #if FEATURE_Z_PROBE || MAX_HARDWARE_ENDSTOP_Z || NONLINEAR_SYSTEM
 long Printer::stepsRemainingAtZHit;
 #endif
+#if FEATURE_ENDSTOP_INTERRUPTS
+volatile uint8_t Printer::endstopState = ENDSTOP_POLL;
+#endif
 #if DRIVE_SYSTEM==3
 long Printer::stepsRemainingAtXHit;
 long Printer::stepsRemainingAtYHit;
@@ -116,12 +135,13 @@ float Printer::maxJerk;                    ///< Maximum allowed jerk in mm/s
 #if DRIVE_SYSTEM!=3
 float Printer::maxZJerk;                   ///< Maximum allowed jerk in z direction in mm/s
 #endif
+float Printer::junctionDeviation;          ///< Junction deviation in mm for corner speeds, 0 = use maxJerk
 float Printer::offsetX;                     ///< X-offset for different extruder positions.
 float Printer::offsetY;                     ///< Y-offset for different extruder positions.
 unsigned int Printer::vMaxReached;         ///< Maximumu reached speed
 unsigned long Printer::msecondsPrinting;            ///< Milliseconds of printing time (means time with heated extruder)
 float Printer::filamentPrinted;            ///< mm of filament printed since counting started
-uint8_t Printer::wasLastHalfstepping;         ///< Indicates if last move had halfstepping enabled
+uint8_t Printer::lastStepSmoothing;           ///< Step smoothing level of the last move
 #if ENABLE_BACKLASH_COMPENSATION
 float Printer::backlashX;
 float Printer::backlashY;
@@ -186,14 +206,22 @@ void Printer::updateDerivedParameter()
     deltaBPosYSteps = floor(radiusB * sin(EEPROM::deltaAlphaB() * M_PI/180.0) * axisStepsPerMM[Z_AXIS] + 0.5);
     deltaCPosXSteps = floor(radiusC * cos(EEPROM::deltaAlphaC() * M_PI/180.0) * axisStepsPerMM[Z_AXIS] + 0.5);
     deltaCPosYSteps = floor(radiusC * sin(EEPROM::deltaAlphaC() * M_PI/180.0) * axisStepsPerMM[Z_AXIS] + 0.5);
-    deltaDiagonalStepsSquared = long(EEPROM::deltaDiagonalRodLength()*axisStepsPerMM[Z_AXIS]);
-    if(deltaDiagonalStepsSquared>46000 || 2*EEPROM::deltaHorizontalRadius()*axisStepsPerMM[2]>46000)
+    deltaDiagonalSteps = long(EEPROM::deltaDiagonalRodLength()*axisStepsPerMM[Z_AXIS]);
+    if(deltaDiagonalSteps>65535)
     {
         setLargeMachine(true);
-        deltaDiagonalStepsSquaredF = float(deltaDiagonalStepsSquared)*float(deltaDiagonalStepsSquared);
+#if CPU_ARCH==ARCH_AVR
+        deltaDiagonalStepsSquaredF = float(deltaDiagonalSteps)*float(deltaDiagonalSteps);
+#else
+        deltaSqrtShift = 0;
+        while((deltaDiagonalSteps >> deltaSqrtShift) >= 32768) deltaSqrtShift++;
+#endif
     }
     else
-        deltaDiagonalStepsSquared = deltaDiagonalStepsSquared*deltaDiagonalStepsSquared;
+    {
+        setLargeMachine(false);
+        deltaDiagonalStepsSquared = (unsigned long)deltaDiagonalSteps*deltaDiagonalSteps;
+    }
     long cart[3], delta[3];
     cart[X_AXIS] = cart[Y_AXIS] = 0;
     cart[Z_AXIS] = zMaxSteps;
@@ -296,6 +324,9 @@ void Printer::updateAdvanceFlags()
         if(extruder[i].advanceK!=0) Printer::setAdvanceActivated(true);
 #endif
     }
+#if FEATURE_BRESENHAM_ADVANCE
+    extruderLastDirection = 0; // moves without advance set the direction pin themselves
+#endif
 #endif
 }
 
@@ -715,6 +746,7 @@ void Printer::setup()
 #if DRIVE_SYSTEM!=3
     maxZJerk = MAX_ZJERK;
 #endif
+    junctionDeviation = JUNCTION_DEVIATION;
     offsetX = offsetY = 0;
     interval = 5000;
     stepsPerTimerCall = 1;
@@ -727,7 +759,7 @@ void Printer::setup()
     xMin = X_MIN_POS;
     yMin = Y_MIN_POS;
     zMin = Z_MIN_POS;
-    wasLastHalfstepping = 0;
+    lastStepSmoothing = 0;
 #if ENABLE_BACKLASH_COMPENSATION
     backlashX = X_BACKLASH;
     backlashY = Y_BACKLASH;
@@ -748,6 +780,12 @@ void Printer::setup()
     Commands::checkFreeMemory();
     Commands::writeLowestFreeRAM();
     HAL::setupTimer();
+#if FEATURE_ENDSTOP_INTERRUPTS
+    setupEndstopInterrupts();
+#endif
+#if FEATURE_ISR_PROFILER
+    Commands::resetIsrProfile();
+#endif
 #if NONLINEAR_SYSTEM
     transformCartesianStepsToDeltaSteps(Printer::currentPositionSteps, Printer::currentDeltaPositionSteps);
 #if DELTA_HOME_ON_POWER
@@ -767,6 +805,9 @@ void Printer::setup()
 void Printer::defaultLoopActions()
 {
     Commands::checkForPeriodicalActions();  //check heater every n milliseconds
+#if FEATURE_MOVE_MERGING
+    if(PrintLine::linesCount < 2) PrintLine::flushMergedMove(); // don't let the printer wait for a pending move
+#endif
     UI_MEDIUM; // do check encoder
     millis_t curtime = HAL::timeInMilliseconds();
     if(PrintLine::hasLines())
@@ -1112,6 +1153,54 @@ void Printer::setAutolevelActive(bool on)
     updateCurrentPosition();
 #endif // FEATURE_AUTOLEVEL    if(isAutolevelActive()==on) return;
 }
+#if FEATURE_ENDSTOP_INTERRUPTS
+void Printer::setupEndstopInterrupts()
+{
+    bool poll = false;
+#if MIN_HARDWARE_ENDSTOP_X && X_MIN_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(X_MIN_PIN);
+#endif
+#if MIN_HARDWARE_ENDSTOP_Y && Y_MIN_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(Y_MIN_PIN);
+#endif
+#if MIN_HARDWARE_ENDSTOP_Z && Z_MIN_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(Z_MIN_PIN);
+#endif
+#if MAX_HARDWARE_ENDSTOP_X && X_MAX_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(X_MAX_PIN);
+#endif
+#if MAX_HARDWARE_ENDSTOP_Y && Y_MAX_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(Y_MAX_PIN);
+#endif
+#if MAX_HARDWARE_ENDSTOP_Z && Z_MAX_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(Z_MAX_PIN);
+#endif
+#if FEATURE_Z_PROBE && Z_PROBE_PIN>-1
+    poll |= !HAL::attachEndstopInterrupt(Z_PROBE_PIN);
+#endif
+    BEGIN_INTERRUPT_PROTECTED
+    endstopState = (poll ? ENDSTOP_POLL : 0);
+    updateEndstops();
+    END_INTERRUPT_PROTECTED
+    if(poll)
+        Com::printWarningFLN(Com::tEndstopPolling);
+}
+
+/** Stores the triggered endstops in endstopState. Called by the pin change interrupts. */
+void Printer::updateEndstops()
+{
+    uint8_t state = endstopState & ENDSTOP_POLL;
+    if(isXMinEndstopHit()) state |= ENDSTOP_X_MIN_HIT;
+    if(isYMinEndstopHit()) state |= ENDSTOP_Y_MIN_HIT;
+    if(isZMinEndstopHit()) state |= ENDSTOP_Z_MIN_HIT;
+    if(isXMaxEndstopHit()) state |= ENDSTOP_X_MAX_HIT;
+    if(isYMaxEndstopHit()) state |= ENDSTOP_Y_MAX_HIT;
+    if(isZMaxEndstopHit()) state |= ENDSTOP_Z_MAX_HIT;
+    if(isZProbeHit()) state |= ENDSTOP_Z_PROBE_HIT;
+    endstopState = state;
+}
+#endif
+
 #if MAX_HARDWARE_ENDSTOP_Z
 float Printer::runZMaxProbe()
 {
@@ -35,6 +35,43 @@
 #define PRINTER_FLAG1_AUTOMOUNT             2
 #define PRINTER_FLAG1_ANIMATION             4
 #define PRINTER_FLAG1_ALLKILLED             8
+
+// Bits of Printer::endstopState
+#define ENDSTOP_X_MIN_HIT                   1
+#define ENDSTOP_Y_MIN_HIT                   2
+#define ENDSTOP_Z_MIN_HIT                   4
+#define ENDSTOP_X_MAX_HIT                   8
+#define ENDSTOP_Y_MAX_HIT                   16
+#define ENDSTOP_Z_MAX_HIT                   32
+#define ENDSTOP_Z_PROBE_HIT                 64
+#define ENDSTOP_POLL                        128
+
+#if FEATURE_STEP_PORT_MASKS
+/** Step pins on the step port are collected in Printer::stepPortBits and set by Printer::writeStepPort,
+    all others are written directly. */
+#define START_STEP_PIN(pin) do { if(STEP_PORT_MASK(pin)) Printer::stepPortBits |= STEP_PORT_MASK(pin); else WRITE(pin,HIGH); } while(0)
+#define END_STEP_PIN(pin) do { if(!STEP_PORT_MASK(pin)) WRITE(pin,LOW); } while(0)
+#if FEATURE_TWO_XSTEPPER
+#define STEP_MASK_X2 STEP_PORT_MASK(X2_STEP_PIN)
+#else
+#define STEP_MASK_X2 0
+#endif
+#if FEATURE_TWO_YSTEPPER
+#define STEP_MASK_Y2 STEP_PORT_MASK(Y2_STEP_PIN)
+#else
+#define STEP_MASK_Y2 0
+#endif
+#if FEATURE_TWO_ZSTEPPER
+#define STEP_MASK_Z2 STEP_PORT_MASK(Z2_STEP_PIN)
+#else
+#define STEP_MASK_Z2 0
+#endif
+#define STEP_MASK_XYZ (STEP_PORT_MASK(X_STEP_PIN) | STEP_PORT_MASK(Y_STEP_PIN) | STEP_PORT_MASK(Z_STEP_PIN) | STEP_MASK_X2 | STEP_MASK_Y2 | STEP_MASK_Z2)
+#else
+#define START_STEP_PIN(pin) WRITE(pin,HIGH)
+#define END_STEP_PIN(pin) WRITE(pin,LOW)
+#endif
+
 class Printer
 {
 public:
@@ -44,6 +81,9 @@ public:
     static uint8_t maxExtruderSpeed;            ///< Timer delay for end extruder speed
     //static uint8_t extruderAccelerateDelay;     ///< delay between 2 speec increases
     static int advanceStepsSet;
+#if FEATURE_BRESENHAM_ADVANCE
+    static int8_t extruderLastDirection;        ///< Direction set for the extruder steps, 0 = not known
+#endif
 #ifdef ENABLE_QUADRATIC_ADVANCE
     static long advanceExecuted;             ///< Executed advance steps
 #endif
@@ -65,6 +105,9 @@ public:
     static uint8_t debugLevel;
     static uint8_t flag0,flag1; // 1 = stepper disabled, 2 = use external extruder interrupt, 4 = temp Sensor defect, 8 = homed
     static uint8_t stepsPerTimerCall;
+#if FEATURE_STEP_PORT_MASKS
+    static step_port_t stepPortBits; ///< Step pins on the step port, that writeStepPort sets next
+#endif
     static unsigned long interval;    ///< Last step duration in ticks.
     static unsigned long timer;              ///< used for acceleration/deceleration timing
     static unsigned long stepNumber;         ///< Step number in current move.
@@ -76,8 +119,18 @@ public:
 #if NONLINEAR_SYSTEM
     static long currentDeltaPositionSteps[4];
     static long maxDeltaPositionSteps;
+#if DRIVE_SYSTEM==3
+    static long deltaDiagonalSteps;
+    static unsigned long deltaDiagonalStepsSquared; ///< Only set for rods below 65536 steps
+#if CPU_ARCH==ARCH_AVR
+    static float deltaDiagonalStepsSquaredF;        ///< Large machines use the float square root on AVR
+#else
+    static uint8_t deltaSqrtShift;                  ///< Large machines only take the square root of the radicand shifted by 2*deltaSqrtShift
+#endif
+#else
     static long deltaDiagonalStepsSquared;
     static float deltaDiagonalStepsSquaredF;
+#endif
     static long deltaAPosXSteps;
     static long deltaAPosYSteps;
     static long deltaBPosXSteps;
@@ -91,6 +144,9 @@ public:
 #if FEATURE_Z_PROBE || MAX_HARDWARE_ENDSTOP_Z || NONLINEAR_SYSTEM
     static long stepsRemainingAtZHit;
 #endif
+#if FEATURE_ENDSTOP_INTERRUPTS
+    static volatile uint8_t endstopState; ///< Triggered endstops set by the pin interrupts, ENDSTOP_POLL if a pin has none
+#endif
 #if DRIVE_SYSTEM==3
     static long stepsRemainingAtXHit;
     static long stepsRemainingAtYHit;
@@ -124,12 +180,13 @@ public:
 #if DRIVE_SYSTEM!=3
     static float maxZJerk;                   ///< Maximum allowed jerk in z direction in mm/s
 #endif
+    static float junctionDeviation;          ///< Junction deviation in mm for corner speeds, 0 = use maxJerk
     static float offsetX;                     ///< X-offset for different extruder positions.
     static float offsetY;                     ///< Y-offset for different extruder positions.
     static unsigned int vMaxReached;         ///< Maximumu reached speed
     static unsigned long msecondsPrinting;            ///< Milliseconds of printing time (means time with heated extruder)
     static float filamentPrinted;            ///< mm of filament printed since counting started
-    static uint8_t wasLastHalfstepping;         ///< Indicates if last move had halfstepping enabled
+    static uint8_t lastStepSmoothing;           ///< Step smoothing level of the last move
 #if ENABLE_BACKLASH_COMPENSATION
     static float backlashX;
     static float backlashY;
@@ -439,6 +496,20 @@ public:
         return (Z_PROBE_ON_HIGH ? READ(Z_PROBE_PIN) : !READ(Z_PROBE_PIN));
 #else
         return false;
+#endif
+    }
+#if FEATURE_ENDSTOP_INTERRUPTS
+    static void setupEndstopInterrupts();
+    static void updateEndstops();
+#endif
+    /** True if the stepper interrupt has to read the endstop pins. With endstop interrupts
+    this is only the case while an endstop is triggered. */
+    static inline bool isEndstopCheckNeeded()
+    {
+#if FEATURE_ENDSTOP_INTERRUPTS
+        return endstopState != 0;
+#else
+        return true;
 #endif
     }
     static inline void executeXYGantrySteps()
@@ -447,54 +518,68 @@ public:
         if(motorX <= -2)
         {
             ANALYZER_ON(ANALYZER_CH2);
-            WRITE(X_STEP_PIN,HIGH);
+            START_STEP_PIN(X_STEP_PIN);
 #if FEATURE_TWO_XSTEPPER
-            WRITE(X2_STEP_PIN,HIGH);
+            START_STEP_PIN(X2_STEP_PIN);
 #endif
             motorX += 2;
         }
         else if(motorX >= 2)
         {
             ANALYZER_ON(ANALYZER_CH2);
-            WRITE(X_STEP_PIN,HIGH);
+            START_STEP_PIN(X_STEP_PIN);
 #if FEATURE_TWO_XSTEPPER
-            WRITE(X2_STEP_PIN,HIGH);
+            START_STEP_PIN(X2_STEP_PIN);
 #endif
             motorX -= 2;
         }
         if(motorY <= -2)
         {
             ANALYZER_ON(ANALYZER_CH3);
-            WRITE(Y_STEP_PIN,HIGH);
+            START_STEP_PIN(Y_STEP_PIN);
 #if FEATURE_TWO_YSTEPPER
-            WRITE(Y2_STEP_PIN,HIGH);
+            START_STEP_PIN(Y2_STEP_PIN);
 #endif
             motorY += 2;
         }
         else if(motorY >= 2)
         {
             ANALYZER_ON(ANALYZER_CH3);
-            WRITE(Y_STEP_PIN,HIGH);
+            START_STEP_PIN(Y_STEP_PIN);
 #if FEATURE_TWO_YSTEPPER
-            WRITE(Y2_STEP_PIN,HIGH);
+            START_STEP_PIN(Y2_STEP_PIN);
 #endif
             motorY -= 2;
         }
+#endif
+    }
+    /** Sets the step pins collected on the step port with one port write. */
+    static inline void writeStepPort()
+    {
+#if FEATURE_STEP_PORT_MASKS
+        if(stepPortBits)
+        {
+            STEP_PORT_SET(stepPortBits);
+            stepPortBits = 0;
+        }
 #endif
     }
     static inline void endXYZSteps()
     {
-        WRITE(X_STEP_PIN,LOW);
-        WRITE(Y_STEP_PIN,LOW);
-        WRITE(Z_STEP_PIN,LOW);
+#if FEATURE_STEP_PORT_MASKS
+        STEP_PORT_CLEAR(STEP_MASK_XYZ);
+#endif
+        END_STEP_PIN(X_STEP_PIN);
+        END_STEP_PIN(Y_STEP_PIN);
+        END_STEP_PIN(Z_STEP_PIN);
 #if FEATURE_TWO_XSTEPPER
-        WRITE(X2_STEP_PIN,LOW);
+        END_STEP_PIN(X2_STEP_PIN);
 #endif
 #if FEATURE_TWO_YSTEPPER
-        WRITE(Y2_STEP_PIN,LOW);
+        END_STEP_PIN(Y2_STEP_PIN);
 #endif
 #if FEATURE_TWO_ZSTEPPER
-        WRITE(Z2_STEP_PIN,LOW);
+        END_STEP_PIN(Z2_STEP_PIN);
 #endif
         ANALYZER_OFF(ANALYZER_CH1);
         ANALYZER_OFF(ANALYZER_CH2);
@@ -504,6 +589,7 @@ public:
     }
     static inline unsigned int updateStepsPerTimerCall(unsigned int vbase)
     {
+        SIM_RAMP_SPEED(vbase);
         if(vbase>STEP_DOUBLER_FREQUENCY)
         {
 #if ALLOW_QUADSTEPPING
@@ -126,12 +126,132 @@ usage or for seraching for memory induced errors. Switch it off for production,
 #define UI_SPEEDDEPENDENT_POSITIONING true
 #endif
 
+#ifndef PLANNER_CACHE_SIZE
+#define PLANNER_CACHE_SIZE MOVE_CACHE_SIZE
+#endif
+
+#ifndef JUNCTION_DEVIATION
+#define JUNCTION_DEVIATION 0
+#endif
+
+#ifndef FEATURE_S_CURVE_ACCELERATION
+#define FEATURE_S_CURVE_ACCELERATION false
+#endif
+
+#ifndef FEATURE_STEP_BUFFER
+#define FEATURE_STEP_BUFFER false
+#endif
+
+#ifndef FEATURE_STEP_PORT_MASKS
+#define FEATURE_STEP_PORT_MASKS false
+#endif
+
+#ifndef FEATURE_ISR_PROFILER
+#define FEATURE_ISR_PROFILER false
+#endif
+
+#ifndef FEATURE_ENDSTOP_INTERRUPTS
+#define FEATURE_ENDSTOP_INTERRUPTS false
+#endif
+
+#ifndef FEATURE_DEFERRED_SPEED_UPDATE
+#define FEATURE_DEFERRED_SPEED_UPDATE false
+#endif
+
+#ifndef FEATURE_BRESENHAM_ADVANCE
+#define FEATURE_BRESENHAM_ADVANCE false
+#endif
+
+#ifndef FEATURE_COMPACT_COMMAND_BUFFER
+#define FEATURE_COMPACT_COMMAND_BUFFER false
+#endif
+
+#ifndef GCODE_RING_SIZE
+#define GCODE_RING_SIZE 256
+#endif
+
+#ifndef FEATURE_EXTENDED_OK
+#define FEATURE_EXTENDED_OK false
+#endif
+
+#ifndef FEATURE_PROTOCOL_V3
+#define FEATURE_PROTOCOL_V3 false
+#endif
+
+#ifndef PROTOCOL_V3_FRAME_SIZE
+#define PROTOCOL_V3_FRAME_SIZE 128
+#endif
+
+#ifndef FEATURE_OUTPUT_QUEUE
+#define FEATURE_OUTPUT_QUEUE false
+#endif
+
+#ifndef OUTPUT_QUEUE_SIZE
+#define OUTPUT_QUEUE_SIZE 4
+#endif
+
+#ifndef FEATURE_AUTO_REPORT
+#define FEATURE_AUTO_REPORT false
+#endif
+
+#ifndef FEATURE_DELTA_ADAPTIVE_SEGMENTS
+#define FEATURE_DELTA_ADAPTIVE_SEGMENTS false
+#endif
+
+#ifndef FEATURE_DELTA_TOWER_LIMITS
+#define FEATURE_DELTA_TOWER_LIMITS false
+#endif
+
+#ifndef DELTA_SEGMENT_MAX_DEVIATION
+#define DELTA_SEGMENT_MAX_DEVIATION 0.01
+#endif
+
+#ifndef FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+#define FEATURE_DELTA_SEGMENTS_ON_THE_FLY false
+#endif
+
+#ifndef DELTA_SEGMENT_BUFFER_SIZE
+#define DELTA_SEGMENT_BUFFER_SIZE 2
+#endif
+
+#ifndef FEATURE_MOVE_MERGING
+#define FEATURE_MOVE_MERGING false
+#endif
+
+#ifdef LOW_TICKS_PER_MOVE
+#error LOW_TICKS_PER_MOVE was replaced by LOW_QUEUE_TICKS, the minimum time of all queued moves. Twice the old value is a good start.
+#endif
+#ifndef LOW_QUEUE_TICKS
+#define LOW_QUEUE_TICKS 500000
+#endif
+
+#ifndef MAX_STEP_SMOOTHING
+#define MAX_STEP_SMOOTHING 1
+#endif
+
 #if DRIVE_SYSTEM==3 || DRIVE_SYSTEM==4
 #define NONLINEAR_SYSTEM true
 #else
 #define NONLINEAR_SYSTEM false
 #endif
 
+#if FEATURE_BRESENHAM_ADVANCE && !defined(USE_ADVANCE)
+#undef FEATURE_BRESENHAM_ADVANCE
+#define FEATURE_BRESENHAM_ADVANCE false
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY && !NONLINEAR_SYSTEM
+#undef FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+#define FEATURE_DELTA_SEGMENTS_ON_THE_FLY false
+#endif
+#if FEATURE_DELTA_ADAPTIVE_SEGMENTS && DRIVE_SYSTEM!=3
+#undef FEATURE_DELTA_ADAPTIVE_SEGMENTS
+#define FEATURE_DELTA_ADAPTIVE_SEGMENTS false
+#endif
+#if FEATURE_DELTA_TOWER_LIMITS && DRIVE_SYSTEM!=3
+#undef FEATURE_DELTA_TOWER_LIMITS
+#define FEATURE_DELTA_TOWER_LIMITS false
+#endif
+
 #ifdef FEATURE_Z_PROBE
 #define MANUAL_CONTROL true
 #endif
@@ -253,6 +373,20 @@ usage or for seraching for memory induced errors. Switch it off for production,
 #define MENU_MODE_FAN_RUNNING 8
 
 #include "HAL.h"
+#if FEATURE_DEFERRED_SPEED_UPDATE && !defined(HAL_SPEED_UPDATE_INTERRUPT)
+#undef FEATURE_DEFERRED_SPEED_UPDATE
+#define FEATURE_DEFERRED_SPEED_UPDATE false // the HAL has no software interrupt for it
+#endif
+#ifndef SIM_POLL
+// Hooks for the host simulation in src/Simulation. They do nothing in the firmware.
+#define SIM_POLL
+#define SIM_PROBE_START(p)
+#define SIM_PROBE_END(p)
+#define SIM_COUNT(c)
+#define SIM_DELTA_SEGMENT_START(p)
+#define SIM_DELTA_SEGMENT_END(p)
+#define SIM_RAMP_SPEED(v)
+#endif
 #include "gcode.h"
 #define MAX_VFAT_ENTRIES (2)
 /** Total size of the buffer used to store the long filenames */
@@ -91,6 +91,8 @@ Custom M Codes
 - M116 - Wait for all temperatures in a +/- 1 degree range
 - M117 <message> - Write message in status row on lcd
 - M119 - Report endstop status
+- M154 S<seconds> P<1 = binary> - Report position every S seconds (FEATURE_AUTO_REPORT), S0 stops
+- M155 S<seconds> P<1 = binary> - Report temperatures every S seconds (FEATURE_AUTO_REPORT), S0 stops
 - M140 S<temp> F1 - Set bed target temp, F1 makes a beep when temperature is reached the first time
 - M190 - Wait for bed current temp to reach target temp.
 - M201 - Set max acceleration in units/s^2 for print moves (M201 X1000 Y1000)
@@ -99,12 +101,14 @@ Custom M Codes
 - M204 - Set PID parameter X => Kp Y => Ki Z => Kd S<extruder> Default is current extruder. NUM_EXTRUDER=Heated bed
 - M205 - Output EEPROM settings
 - M206 - Set EEPROM value
-- M207 X<XY jerk> Z<Z Jerk> E<ExtruderJerk> - Changes current jerk values, but do not store them in eeprom.
+- M207 X<XY jerk> Z<Z Jerk> E<ExtruderJerk> J<junction deviation> - Changes current jerk values, but do not store them in eeprom.
 - M220 S<Feedrate multiplier in percent> - Increase/decrease given feedrate
 - M221 S<Extrusion flow multiplier in percent> - Increase/decrease given flow rate
 - M231 S<OPS_MODE> X<Min_Distance> Y<Retract> Z<Backlash> F<ReatrctMove> - Set OPS parameter
 - M232 - Read and reset max. advance values
 - M233 X<AdvanceK> Y<AdvanceL> - Set temporary advance K-value to X and linear term advanceL to Y
+- M234 - Read and reset queue underruns and minimum queued time, also shows the planner time per move
+- M235 [S1] - Report stepper and pwm interrupt profile (FEATURE_ISR_PROFILER), S1 resets it afterwards
 - M251 Measure Z steps from homing stop (Delta printers). S0 - Reset, S1 - Print, S2 - Store to Z length (also EEPROM if enabled)
 - M280 S<mode> - Set ditto printing mode. mode: 0 = off, 1 = on
 - M300 S<Frequency> P<DurationMillis> play frequency
@@ -18,7 +18,17 @@
 #ifndef _GCODE_H
 #define _GCODE_H
 
+#if FEATURE_PROTOCOL_V3 && PROTOCOL_V3_FRAME_SIZE > 96
+#define MAX_CMD_SIZE PROTOCOL_V3_FRAME_SIZE
+#else
 #define MAX_CMD_SIZE 96
+#endif
+#if FEATURE_COMPACT_COMMAND_BUFFER
+#define COMPACT_COMMAND_MAX_SIZE (52+sizeof(char*)) // length, all parameters and the text pointer
+#define ANNOUNCED_BUFFERS_STEP RMath::max(1,(GCODE_RING_SIZE<<2)/commandRecordMean) // records of mean size in a quarter ring
+#else
+#define ANNOUNCED_BUFFERS_STEP ((GCODE_BUFFER_SIZE+3)/4)
+#endif
 class SDCard;
 class GCode   // 52 uint8_ts per command needed
 {
@@ -134,29 +144,71 @@ public:
     static void pushCommand();
     static void executeFString(FSTRINGPARAM(cmd));
     static uint8_t computeBinarySize(char *ptr);
+    /** Number of commands that can be stored for sure. */
+    static inline uint8_t freeCommandBuffers()
+    {
+#if FEATURE_COMPACT_COMMAND_BUFFER
+        return (GCODE_RING_SIZE-commandRingUsed)/COMPACT_COMMAND_MAX_SIZE;
+#else
+        return GCODE_BUFFER_SIZE-bufferLength;
+#endif
+    }
+    /** Free command buffers announced to the host as B.
+
+    With FEATURE_COMPACT_COMMAND_BUFFER one record of maximum size stays reserved and the remaining bytes are
+    counted in records of the mean size stored recently, so B commands like the last ones fit. Larger commands
+    wait until the ring has room, in a frame they get a resend.
+    */
+    static inline uint8_t announcedCommandBuffers()
+    {
+#if FEATURE_COMPACT_COMMAND_BUFFER
+        uint16_t free = GCODE_RING_SIZE-commandRingUsed;
+        if(free < COMPACT_COMMAND_MAX_SIZE) return 0;
+        return 1+((free-COMPACT_COMMAND_MAX_SIZE)<<4)/commandRecordMean;
+#else
+        return freeCommandBuffers();
+#endif
+    }
+    /** Command the parser fills before it gets stored with pushCommand. */
+    static inline GCode *receivedCommand()
+    {
+#if FEATURE_COMPACT_COMMAND_BUFFER
+        return &commandReceived;
+#else
+        return &commandsBuffered[bufferWriteIndex];
+#endif
+    }
 
     friend class SDCard;
     friend class UIDisplay;
 private:
     void debugCommandBuffer();
     void checkAndPushCommand();
+    void decodeBinary(uint8_t *p);
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    uint8_t encodeCompact(uint8_t *p);
+    static uint8_t compactSize(uint16_t params,uint16_t params2);
+    void decodeCompact(uint8_t *p);
+#endif
+    static bool checkFletcher16(uint8_t *buffer,uint8_t len);
+#if FEATURE_PROTOCOL_V3
+    static void parseFrame();
+    static void sendFrameAck();
+#endif
     static void requestResend();
-    inline float parseFloatValue(char *s)
-    {
-        char *endPtr;
-        float f = (strtod(s, &endPtr));
-        if(s == endPtr) setFormatError();
-        return f;
-    }
-    inline long parseLongValue(char *s)
-    {
-        char *endPtr;
-        long l = (strtol(s, &endPtr, 10));
-        if(s == endPtr) setFormatError();
-        return l;
-    }
+    float parseFloatValue(char *s);
+    long parseLongValue(char *s);
 
+#if FEATURE_COMPACT_COMMAND_BUFFER
+    static uint8_t commandRing[GCODE_RING_SIZE]; ///< Buffered commands with only the parameters they have.
+    static uint16_t commandRingUsed; ///< Bytes used in commandRing.
+    static GCode commandReceived; ///< Command the parser fills.
+    static GCode commandExecuted; ///< Decoded oldest command of commandRing.
+    static bool commandDecoded; ///< commandExecuted holds the oldest command.
+    static uint16_t commandRecordMean; ///< Mean size of the stored records in 1/16 bytes, rounded up.
+#else
     static GCode commandsBuffered[GCODE_BUFFER_SIZE]; ///< Buffer for received commands.
+#endif
     static uint8_t bufferReadIndex; ///< Read position in gcode_buffer.
     static uint8_t bufferWriteIndex; ///< Write position in gcode_buffer.
     static uint8_t commandReceiving[MAX_CMD_SIZE]; ///< Current received command.
@@ -172,6 +224,9 @@ private:
     static volatile uint8_t bufferLength; ///< Number of commands stored in gcode_buffer
     static millis_t timeOfLastDataPacket; ///< Time, when we got the last data packet. Used to detect missing uint8_ts.
     static uint8_t formatErrors; ///< Number of sequential format errors
+#if FEATURE_PROTOCOL_V3
+    static uint8_t freeBuffersReported; ///< Free command buffers sent with the last frame ok, 255 = host does not use frames.
+#endif
 };
 
 
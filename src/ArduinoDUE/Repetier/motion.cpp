@@ -63,6 +63,35 @@
 #if MOVE_CACHE_SIZE<4
 #error MOVE_CACHE_SIZE must be at least 5
 #endif
+#if PLANNER_CACHE_SIZE<4 || PLANNER_CACHE_SIZE>MOVE_CACHE_SIZE || (MOVE_CACHE_SIZE % PLANNER_CACHE_SIZE)!=0
+#error PLANNER_CACHE_SIZE must be at least 4 and divide MOVE_CACHE_SIZE
+#endif
+#if FEATURE_S_CURVE_ACCELERATION && !defined(RAMP_ACCELERATION)
+#error FEATURE_S_CURVE_ACCELERATION needs RAMP_ACCELERATION
+#endif
+#if FEATURE_STEP_BUFFER
+#if (STEP_BUFFER_SIZE & (STEP_BUFFER_SIZE - 1)) != 0 || STEP_BUFFER_SIZE < 8 || STEP_BUFFER_SIZE > 256
+#error STEP_BUFFER_SIZE must be a power of 2 between 8 and 256
+#endif
+#if defined(USE_ADVANCE) || defined(XY_GANTRY)
+#error FEATURE_STEP_BUFFER does not work with USE_ADVANCE or XY gantries
+#endif
+#if ALWAYS_CHECK_ENDSTOPS
+#error FEATURE_STEP_BUFFER buffers only one step ahead with ALWAYS_CHECK_ENDSTOPS, set it to false
+#endif
+#endif
+#if FEATURE_DEFERRED_SPEED_UPDATE && (FEATURE_STEP_BUFFER || defined(USE_ADVANCE))
+#error FEATURE_DEFERRED_SPEED_UPDATE does not work with FEATURE_STEP_BUFFER or USE_ADVANCE
+#endif
+#if FEATURE_MOVE_MERGING && (MOVE_MERGE_MAX_SEGMENTS < 2 || MOVE_MERGE_MAX_SEGMENTS > 32)
+#error MOVE_MERGE_MAX_SEGMENTS must be between 2 and 32
+#endif
+#if MAX_STEP_SMOOTHING < 0 || MAX_STEP_SMOOTHING > 3
+#error MAX_STEP_SMOOTHING must be between 0 and 3
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY && ((DELTA_SEGMENT_BUFFER_SIZE & (DELTA_SEGMENT_BUFFER_SIZE - 1)) != 0 || DELTA_SEGMENT_BUFFER_SIZE < 2 || DELTA_SEGMENT_BUFFER_SIZE > 128)
+#error DELTA_SEGMENT_BUFFER_SIZE must be a power of 2 between 2 and 128
+#endif
 
 //Inactivity shutdown variables
 millis_t previousMillisCmd = 0;
@@ -80,6 +109,40 @@ uint8_t pwm_pos[NUM_EXTRUDER+3]; // 0-NUM_EXTRUDER = Heater 0-NUM_EXTRUDER of ex
 volatile int waitRelax = 0; // Delay filament relax at the end of print, could be a simple timeout
 
 PrintLine PrintLine::lines[MOVE_CACHE_SIZE]; ///< Cache for print moves.
+PlannerLine PrintLine::plannerLines[PLANNER_CACHE_SIZE]; ///< Planner data of the last moves.
+long PrintLine::error[4];                    ///< Bresenham error of the current line.
+long PrintLine::queuedTicks = 0;
+long PrintLine::minQueuedTicks = 0x7fffffff;
+unsigned int PrintLine::underruns = 0;
+long PrintLine::plannerTicks = 0;
+long PrintLine::arrivalTicks = 0;
+unsigned long PrintLine::lastMoveMicros = 0;
+#if FEATURE_STEP_BUFFER
+StepEvent PrintLine::stepEvents[STEP_BUFFER_SIZE];
+volatile uint8_t PrintLine::stepEventsRead = 0;
+volatile uint8_t PrintLine::stepEventsWrite = 0;
+uint8_t PrintLine::stepEventSteps = 0;
+uint8_t PrintLine::stepEventDirs = 0;
+uint8_t PrintLine::stepEventPinDirs = 255;        ///< 255 forces setting all direction pins with the first event
+ticks_t PrintLine::stepEventTicks = 0;
+ticks_t PrintLine::stepEventIdle = 0;
+volatile uint8_t PrintLine::stepBufferFilling = 0;
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+DeltaSegment PrintLine::deltaSegments[DELTA_SEGMENT_BUFFER_SIZE];
+uint8_t PrintLine::deltaSegmentLine[DELTA_SEGMENT_BUFFER_SIZE];
+volatile uint8_t PrintLine::deltaSegmentsRead = 0;
+volatile uint8_t PrintLine::deltaSegmentsWrite = 0;
+uint8_t PrintLine::deltaSegmentPos = 0;
+uint8_t PrintLine::deltaSegmentsLeft = 0;
+uint8_t PrintLine::deltaSegmentFlags;
+long PrintLine::deltaSegmentMaxSteps;
+long PrintLine::deltaSegmentCartesian[3];
+long PrintLine::deltaSegmentEnd[3];
+long PrintLine::deltaSegmentTower[3];
+volatile uint8_t PrintLine::deltaSegmentSequence = 0;
+volatile uint8_t PrintLine::deltaSegmentFilling = 0;
+#endif
 PrintLine *PrintLine::cur = 0;               ///< Current printing line
 #if CPU_ARCH==ARCH_ARM
 volatile bool PrintLine::nlFlag = false;
@@ -113,6 +176,128 @@ void PrintLine::moveRelativeDistanceInSteps(long x,long y,long z,long e,float fe
         Commands::waitUntilEndOfAllMoves();
 }
 
+#if FEATURE_MOVE_MERGING
+uint8_t PrintLine::mergeCount = 0;
+long PrintLine::mergeStart[4];
+float PrintLine::mergeJoints[MOVE_MERGE_MAX_SEGMENTS - 1][3];
+long PrintLine::mergeE;
+float PrintLine::mergeLength;
+float PrintLine::mergeFeedrate;
+
+/**
+  Queues a G0/G1 move to the destination coordinates, joining it with the previous move if possible.
+
+  The last move is held back as pending move. A new move is joined, if it has the same feedrate and
+  extrusion per mm and all corners of the pending move stay within MOVE_MERGE_TOLERANCE of the new line.
+  The current position is already the end of the pending move, so all other code sees the position as if
+  the move was queued. The pending move is queued by flushMergedMove, which is called before every other
+  move, command and wait and when the move cache runs low.
+*/
+void PrintLine::queueMergedMove()
+{
+    float start[3],end[3],len2 = 0;
+    for(uint8_t i = 0; i < 3; i++)
+    {
+        start[i] = Printer::currentPositionSteps[i] * Printer::invAxisStepsPerMM[i];
+        end[i] = Printer::destinationSteps[i] * Printer::invAxisStepsPerMM[i];
+        len2 += (end[i] - start[i]) * (end[i] - start[i]);
+    }
+    long e = Printer::destinationSteps[E_AXIS] - Printer::currentPositionSteps[E_AXIS];
+    if(len2 == 0)   // Extruder only moves are never joined
+    {
+#if NONLINEAR_SYSTEM
+        queueDeltaMove(ALWAYS_CHECK_ENDSTOPS, true, true);
+#else
+        queueCartesianMove(ALWAYS_CHECK_ENDSTOPS,true);
+#endif
+        return;
+    }
+    float len = sqrt(len2);
+    if(mergeCount)
+    {
+        bool join = mergeCount < MOVE_MERGE_MAX_SEGMENTS && Printer::feedrate == mergeFeedrate;
+        // Extrusion per mm must match within 2%, with one step for rounding
+        if(join)
+        {
+            float eExpected = (float)mergeE * len / mergeLength;
+            join = fabs((float)e - eExpected) <= 1.0f + 0.02f * fabs(eExpected);
+        }
+        if(join)
+        {
+            // All corners, the start of this move included, must be close to the joined line and in order
+            float s[3],u[3],total2 = 0;
+            for(uint8_t i = 0; i < 3; i++)
+            {
+                s[i] = mergeStart[i] * Printer::invAxisStepsPerMM[i];
+                u[i] = end[i] - s[i];
+                total2 += u[i] * u[i];
+            }
+            float total = sqrt(total2);
+            for(uint8_t i = 0; i < 3; i++) u[i] /= total;
+            float lastT = 0;
+            for(uint8_t j = 0; j < mergeCount && join; j++)
+            {
+                float *p = (j < mergeCount - 1 ? mergeJoints[j] : start);
+                float v2 = 0,t = 0;
+                for(uint8_t i = 0; i < 3; i++)
+                {
+                    float v = p[i] - s[i];
+                    v2 += v * v;
+                    t += v * u[i];
+                }
+                join = t > lastT && t < total && v2 - t * t <= MOVE_MERGE_TOLERANCE * MOVE_MERGE_TOLERANCE;
+                lastT = t;
+            }
+        }
+        if(join)
+        {
+            for(uint8_t i = 0; i < 3; i++)
+                mergeJoints[mergeCount - 1][i] = start[i];
+            mergeCount++;
+            mergeE += e;
+            mergeLength += len;
+            for(uint8_t i = 0; i < 4; i++)
+                Printer::currentPositionSteps[i] = Printer::destinationSteps[i];
+            return;
+        }
+        flushMergedMove();
+    }
+    mergeCount = 1;
+    mergeE = e;
+    mergeLength = len;
+    mergeFeedrate = Printer::feedrate;
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        mergeStart[i] = Printer::currentPositionSteps[i];
+        Printer::currentPositionSteps[i] = Printer::destinationSteps[i];
+    }
+}
+
+/** Queues the pending move of queueMergedMove. Destination and feedrate are preserved. */
+void PrintLine::flushMergedMove()
+{
+    if(!mergeCount) return;
+    mergeCount = 0;
+    long destination[4];
+    float feedrate = Printer::feedrate;
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        destination[i] = Printer::destinationSteps[i];
+        Printer::destinationSteps[i] = Printer::currentPositionSteps[i];
+        Printer::currentPositionSteps[i] = mergeStart[i];
+    }
+    Printer::feedrate = mergeFeedrate;
+#if NONLINEAR_SYSTEM
+    queueDeltaMove(ALWAYS_CHECK_ENDSTOPS, true, true);
+#else
+    queueCartesianMove(ALWAYS_CHECK_ENDSTOPS,true);
+#endif
+    Printer::feedrate = feedrate;
+    for(uint8_t i = 0; i < 4; i++)
+        Printer::destinationSteps[i] = destination[i];
+}
+#endif
+
 #if !NONLINEAR_SYSTEM
 /**
   Put a move to the current destination coordinates into the movement cache.
@@ -122,6 +307,9 @@ void PrintLine::moveRelativeDistanceInSteps(long x,long y,long z,long e,float fe
 */
 void PrintLine::queueCartesianMove(uint8_t check_endstops,uint8_t pathOptimize)
 {
+#if FEATURE_MOVE_MERGING
+    flushMergedMove();
+#endif
     Printer::unsetAllSteppersDisabled();
     waitForXFreeLines(1);
     uint8_t newPath=insertWaitMovesIfNeeded(pathOptimize, 0);
@@ -154,7 +342,7 @@ void PrintLine::queueCartesianMove(uint8_t check_endstops,uint8_t pathOptimize)
         return; // No steps included
     }
     Printer::filamentPrinted += axis_diff[E_AXIS];
-    float xydist2;
+    float xydist2,distance;
 #if ENABLE_BACKLASH_COMPENSATION
     if((p->isXYZMove()) && ((p->dir & 7)^(Printer::backlashDir & 7)) & (Printer::backlashDir >> 3))   // We need to compensate backlash, add a move
     {
@@ -184,11 +372,11 @@ void PrintLine::queueCartesianMove(uint8_t check_endstops,uint8_t pathOptimize)
         //Feedrate calc based on XYZ travel distance
         xydist2 = back_diff[X_AXIS] * back_diff[X_AXIS] + back_diff[Y_AXIS] * back_diff[Y_AXIS];
         if(p->isZMove())
-            p->distance = sqrt(xydist2 + back_diff[Z_AXIS] * back_diff[Z_AXIS]);
+            distance = sqrt(xydist2 + back_diff[Z_AXIS] * back_diff[Z_AXIS]);
         else
-            p->distance = sqrt(xydist2);
+            distance = sqrt(xydist2);
         Printer::backlashDir = (Printer::backlashDir & 56) | (p2->dir & 7);
-        p->calculateMove(back_diff,pathOptimize);
+        p->calculateMove(back_diff,pathOptimize,distance);
         p = p2; // use saved instance for the real move
     }
 #endif
@@ -203,32 +391,56 @@ void PrintLine::queueCartesianMove(uint8_t check_endstops,uint8_t pathOptimize)
     {
         xydist2 = axis_diff[X_AXIS] * axis_diff[X_AXIS] + axis_diff[Y_AXIS] * axis_diff[Y_AXIS];
         if(p->isZMove())
-            p->distance = RMath::max((float)sqrt(xydist2 + axis_diff[Z_AXIS] * axis_diff[Z_AXIS]),fabs(axis_diff[E_AXIS]));
+            distance = RMath::max((float)sqrt(xydist2 + axis_diff[Z_AXIS] * axis_diff[Z_AXIS]),fabs(axis_diff[E_AXIS]));
         else
-            p->distance = RMath::max((float)sqrt(xydist2),fabs(axis_diff[E_AXIS]));
+            distance = RMath::max((float)sqrt(xydist2),fabs(axis_diff[E_AXIS]));
     }
     else
-        p->distance = fabs(axis_diff[E_AXIS]);
-    p->calculateMove(axis_diff,pathOptimize);
+        distance = fabs(axis_diff[E_AXIS]);
+    p->calculateMove(axis_diff,pathOptimize,distance);
 }
 #endif
-void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize)
+void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize,float distance)
 {
+    PlannerLine *pl = getPlannerLine();
 #if NONLINEAR_SYSTEM
     long axisInterval[5]; // shortest interval possible for that axis
 #else
     long axisInterval[4];
 #endif
+    SIM_PROBE_START(PLANNER);
+    unsigned long startMicros = HAL::timeInMicroseconds();
     float timeForMove = (float)(F_CPU)*distance / (isXOrYMove() ? RMath::max(Printer::minimumSpeed,Printer::feedrate): Printer::feedrate); // time is in ticks
     bool critical = Printer::isZProbingActive();
-    if(linesCount < MOVE_CACHE_LOW && timeForMove < LOW_TICKS_PER_MOVE)   // Limit speed to keep cache full.
+    long queued = queuedTicksLeft();
+    if(lastMoveMicros)
     {
-        //OUT_P_I("L:",lines_count);
-        timeForMove += (3 * (LOW_TICKS_PER_MOVE-timeForMove)) / (linesCount+1); // Increase time if queue gets empty. Add more time if queue gets smaller.
-        //OUT_P_F_LN("Slow ",time_for_move);
-        critical=true;
+        // Longer pauses, e.g. from the host or the user interface, are no part of the stream of moves.
+        unsigned long arrival = startMicros - lastMoveMicros;
+        bool inStream = arrival < 250000;
+        if(linesCount == 0)
+        {
+            if(inStream) underruns++; // the queue ran empty, although the move came in time
+        }
+        else if(queued < minQueuedTicks) minQueuedTicks = queued;
+        // Only a low queue shows how fast new moves come.
+        if(linesCount < MOVE_CACHE_LOW && inStream)
+            arrivalTicks += ((long)arrival * (F_CPU / 1000000) - arrivalTicks) >> 3;
+    }
+    lastMoveMicros = (startMicros ? startMicros : 1);
+    if(linesCount < MOVE_CACHE_LOW)   // Limit speed to keep cache full.
+    {
+        // A move must last as long as it takes the next one to arrive, otherwise the queue runs empty.
+        // If the queue is already below LOW_QUEUE_TICKS, the missing time is spread over the queued moves.
+        float minTime = arrivalTicks;
+        if(queued < LOW_QUEUE_TICKS)
+            minTime += (float)(LOW_QUEUE_TICKS - queued) / (linesCount + 1);
+        if(timeForMove < minTime)
+        {
+            timeForMove = minTime;
+            critical = true;
+        }
     }
-    timeInTicks = timeForMove;
     UI_MEDIUM; // do check encoder
     // Compute the solwest allowed interval (ticks/step), so maximum feedrate is not violated
     long limitInterval = timeForMove/stepsRemaining; // until not violated by other constraints it is your target speed
@@ -258,43 +470,48 @@ void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize)
     else axisInterval[E_AXIS] = 0;
 #if NONLINEAR_SYSTEM
     axisInterval[VIRTUAL_AXIS] = fabs(axis_diff[VIRTUAL_AXIS])*F_CPU/(Printer::maxFeedrate[X_AXIS]*stepsRemaining);
+#if FEATURE_DELTA_TOWER_LIMITS
+    limitInterval = RMath::max(axisInterval[VIRTUAL_AXIS],limitInterval); // The virtual axis moves like the fastest tower
+#endif
 #endif
 
     fullInterval = limitInterval>200 ? limitInterval : 200; // This is our target speed
     // new time at full speed = limitInterval*p->stepsRemaining [ticks]
     timeForMove = (float)limitInterval * (float)stepsRemaining; // for large z-distance this overflows with long computation
+    timeInTicks = timeForMove;
     float inv_time_s = (float)F_CPU / timeForMove;
     if(isXMove())
     {
         axisInterval[X_AXIS] = timeForMove / delta[X_AXIS];
-        speedX = axis_diff[X_AXIS] * inv_time_s;
-        if(isXNegativeMove()) speedX = -speedX;
+        pl->speedX = axis_diff[X_AXIS] * inv_time_s;
+        if(isXNegativeMove()) pl->speedX = -pl->speedX;
     }
-    else speedX = 0;
+    else pl->speedX = 0;
     if(isYMove())
     {
         axisInterval[Y_AXIS] = timeForMove/delta[Y_AXIS];
-        speedY = axis_diff[Y_AXIS] * inv_time_s;
-        if(isYNegativeMove()) speedY = -speedY;
+        pl->speedY = axis_diff[Y_AXIS] * inv_time_s;
+        if(isYNegativeMove()) pl->speedY = -pl->speedY;
     }
-    else speedY = 0;
+    else pl->speedY = 0;
     if(isZMove())
     {
         axisInterval[Z_AXIS] = timeForMove/delta[Z_AXIS];
-        speedZ = axis_diff[Z_AXIS] * inv_time_s;
-        if(isZNegativeMove()) speedZ = -speedZ;
+        pl->speedZ = axis_diff[Z_AXIS] * inv_time_s;
+        if(isZNegativeMove()) pl->speedZ = -pl->speedZ;
     }
-    else speedZ = 0;
+    else pl->speedZ = 0;
     if(isEMove())
     {
         axisInterval[E_AXIS] = timeForMove/delta[E_AXIS];
-        speedE = axis_diff[E_AXIS] * inv_time_s;
-        if(isENegativeMove()) speedE = -speedE;
+        pl->speedE = axis_diff[E_AXIS] * inv_time_s;
+        if(isENegativeMove()) pl->speedE = -pl->speedE;
     }
+    else pl->speedE = 0;
 #if NONLINEAR_SYSTEM
     axisInterval[VIRTUAL_AXIS] = limitInterval; //timeForMove/stepsRemaining;
 #endif
-    fullSpeed = distance * inv_time_s;
+    pl->fullSpeed = distance * inv_time_s;
     //long interval = axis_interval[primary_axis]; // time for every step in ticks with full speed
     //If acceleration is enabled, do some Bresenham calculations depending on which axis will lead it.
 #ifdef RAMP_ACCELERATION
@@ -308,21 +525,21 @@ void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize)
             // v = a * t => t = v/a = F_CPU/(c*a) => 1/t = c*a/F_CPU
             slowest_axis_plateau_time_repro = RMath::min(slowest_axis_plateau_time_repro,(float)axisInterval[i] * (float)accel[i]); //  steps/s^2 * step/tick  Ticks/s^2
     }
-    // Errors for delta move are initialized in timer (except extruder)
-#if !NONLINEAR_SYSTEM
-    error[0] = error[1] = error[2] = delta[primaryAxis] >> 1;
-#endif
-#if NONLINEAR_SYSTEM
-    error[E_AXIS] = stepsRemaining >> 1;
-#endif
-    invFullSpeed = 1.0/fullSpeed;
-    accelerationPrim = slowest_axis_plateau_time_repro / axisInterval[primaryAxis]; // a = v/t = F_CPU/(c*t): Steps/s^2
+#if FEATURE_DELTA_TOWER_LIMITS
+    // The fastest tower accelerates like the effector times its speed ratio
+    if(axis_diff[VIRTUAL_AXIS] > 0)
+        slowest_axis_plateau_time_repro = RMath::min(slowest_axis_plateau_time_repro,
+                                          timeForMove * (float)accel[X_AXIS] / (axis_diff[VIRTUAL_AXIS] * Printer::axisStepsPerMM[X_AXIS]));
+#endif
+    pl->invFullSpeed = 1.0/pl->fullSpeed;
+    pl->accelerationPrim = slowest_axis_plateau_time_repro / axisInterval[primaryAxis]; // a = v/t = F_CPU/(c*t): Steps/s^2
     //Now we can calculate the new primary axis acceleration, so that the slowest axis max acceleration is not violated
-    fAcceleration = 262144.0*(float)accelerationPrim/F_CPU; // will overflow without float!
-    accelerationDistance2 = 2.0*distance*slowest_axis_plateau_time_repro*fullSpeed/((float)F_CPU); // mm^2/s^2
-    startSpeed = endSpeed = minSpeed = safeSpeed();
+    fAcceleration = 262144.0*(float)pl->accelerationPrim/F_CPU; // will overflow without float!
+    pl->accelerationDistance2 = 2.0*distance*slowest_axis_plateau_time_repro*pl->fullSpeed/((float)F_CPU); // mm^2/s^2
+    float safe = safeSpeed(pl);
+    pl->startSpeed2 = pl->endSpeed2 = pl->minSpeed2 = safe * safe;
     // Can accelerate to full speed within the line
-    if (startSpeed * startSpeed + accelerationDistance2 >= fullSpeed * fullSpeed)
+    if (pl->startSpeed2 + pl->accelerationDistance2 >= pl->fullSpeed * pl->fullSpeed)
         setNominalMove();
 
     vMax = F_CPU / fullInterval; // maximum steps per second, we can reach
@@ -340,27 +557,30 @@ void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize)
     }
     else
     {
-        float advlin = fabs(speedE)*Extruder::current->advanceL*0.001*Printer::axisStepsPerMM[E_AXIS];
+        float advlin = fabs(pl->speedE)*Extruder::current->advanceL*0.001*Printer::axisStepsPerMM[E_AXIS];
         advanceL = (uint16_t)((65536*advlin)/vMax); //advanceLscaled = (65536*vE*k2)/vMax
 #ifdef ENABLE_QUADRATIC_ADVANCE;
-        advanceFull = 65536*Extruder::current->advanceK * speedE * speedE; // Steps*65536 at full speed
-        long steps = (HAL::U16SquaredToU32(vMax))/(accelerationPrim<<1); // v^2/(2*a) = steps needed to accelerate from 0-vMax
+        advanceFull = 65536*Extruder::current->advanceK * pl->speedE * pl->speedE; // Steps*65536 at full speed
+        long steps = (HAL::U16SquaredToU32(vMax))/(pl->accelerationPrim<<1); // v^2/(2*a) = steps needed to accelerate from 0-vMax
+        if(steps < 1) steps = 1; // very slow moves reach vMax with the first step
         advanceRate = advanceFull/steps;
         if((advanceFull>>16)>maxadv)
         {
             maxadv = (advanceFull>>16);
-            maxadvspeed = fabs(speedE);
+            maxadvspeed = fabs(pl->speedE);
         }
 #endif
         if(advlin>maxadv2)
         {
             maxadv2 = advlin;
-            maxadvspeed = fabs(speedE);
+            maxadvspeed = fabs(pl->speedE);
         }
     }
 #endif
     UI_MEDIUM; // do check encoder
+    SIM_PROBE_START(PATH_PLANNER);
     updateTrapezoids();
+    SIM_PROBE_END(PATH_PLANNER);
     // how much steps on primary axis do we need to reach target feedrate
     //p->plateauSteps = (long) (((float)p->acceleration *0.5f / slowest_axis_plateau_time_repro + p->vMin) *1.01f/slowest_axis_plateau_time_repro);
 #else
@@ -373,18 +593,11 @@ void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize)
 #endif
 
     // Correct integers for fixed point math used in bresenham_step
-    if(fullInterval<MAX_HALFSTEP_INTERVAL || critical)
-        halfStep = 4;
-    else
-    {
-        halfStep = 1;
-#if NONLINEAR_SYSTEM
-        // Error 0-2 are used for the towers and set up in the timer
-        error[E_AXIS] = stepsRemaining;
-#else
-        error[X_AXIS] = error[Y_AXIS] = error[Z_AXIS] = error[E_AXIS] = delta[primaryAxis];
-#endif
-    }
+    stepSmoothing = 0;
+    if(!critical)
+        while(stepSmoothing < MAX_STEP_SMOOTHING && fullInterval >= ((ticks_t)MAX_HALFSTEP_INTERVAL << stepSmoothing))
+            stepSmoothing++;
+    smoothingPhase = smoothingMask();
 #ifdef DEBUG_STEPCOUNT
 // Set in delta move calculation
 #if !NONLINEAR_SYSTEM
@@ -404,16 +617,35 @@ void PrintLine::calculateMove(float axis_diff[],uint8_t pathOptimize)
     // Make result permanent
     if (pathOptimize) waitRelax = 70;
     pushLine();
+    long cost = (long)(HAL::timeInMicroseconds() - startMicros) * (F_CPU / 1000000);
+    if(cost > plannerTicks) plannerTicks = cost; // be safe with expensive moves
+    else plannerTicks -= (plannerTicks - cost) >> 4;
+    SIM_PROBE_END(PLANNER);
     DEBUG_MEMORY;
 }
 
+/** Returns the time the queued moves still need, without the executed part of the current move. */
+long PrintLine::queuedTicksLeft()
+{
+    long ticks;
+    BEGIN_INTERRUPT_PROTECTED
+    ticks = queuedTicks;
+    PrintLine *c = cur;
+    if(c != NULL && c->delta[c->primaryAxis] > 0)
+        ticks -= (float)c->timeInTicks * (1.0f - (float)c->stepsRemaining / (float)c->delta[c->primaryAxis]);
+    END_INTERRUPT_PROTECTED
+    return (ticks > 0 ? ticks : 0);
+}
+
 /**
 This is the path planner.
 
 It goes from the last entry and tries to increase the end speed of previous moves in a fashion that the maximum jerk
-is never exceeded. If a segment with reached maximum speed is met, the planner stops. Everything left from this
-is already optimal from previous updates.
-The first 2 entries in the queue are not checked. The first is the one that is already in print and the following will likely become active.
+is never exceeded. The planner only looks at the moves after the last move with fixed end speed, everything left
+from this is already optimal from previous updates. The backward pass stops as soon as a junction keeps its speed,
+because the moves before it were planned with the same speed already. Only the moves following that junction are
+recomputed by the forward pass.
+Moves that may start before the planner has finished are not touched.
 
 The method is called before lines_count is increased!
 */
@@ -423,22 +655,25 @@ void PrintLine::updateTrapezoids()
     PrintLine *firstLine;
     PrintLine *act = &lines[linesWritePos];
     BEGIN_INTERRUPT_PROTECTED;
-    uint8_t maxfirst = linesPos; // first non fixed segment
-    if(maxfirst != linesWritePos)
-        nextPlannerIndex(maxfirst); // don't touch the line printing
-    // Now ignore enough segments to gain enough time for path planning
-    long timeleft = 0;
-    // Skip as many stored moves as needed to gain enough time for computation
-    while(timeleft < 4500 * MOVE_CACHE_SIZE && maxfirst != linesWritePos)
-    {
-        timeleft += lines[maxfirst].timeInTicks;
-        nextPlannerIndex(maxfirst);
-    }
-    // Search last fixed element
-    while(first != maxfirst && !lines[first].isEndSpeedFixed())
-        previousPlannerIndex(first);
-    if(first != linesWritePos && lines[first].isEndSpeedFixed())
-        nextPlannerIndex(first);
+    // Search backwards for the first move whose end speed can still change. Only the last PLANNER_CACHE_SIZE
+    // moves have planner data and the moves before must leave enough time for the computation. The measured
+    // planner time is doubled, because the stepper interrupt slows the planner down and the moves may run
+    // faster than planned. The line printing is never touched.
+    if(linesPos != linesWritePos)
+    {
+        long timeleft = queuedTicks - lines[linesPos].timeInTicks; // Moves between the printing and the new move
+        uint8_t linesLeft = PLANNER_CACHE_SIZE - 1;
+        uint8_t previousIndex = linesWritePos;
+        previousPlannerIndex(previousIndex);
+        while(linesLeft-- && previousIndex != linesPos && !lines[previousIndex].isEndSpeedFixed())
+        {
+            SIM_COUNT(plannerSegments);
+            timeleft -= lines[previousIndex].timeInTicks;
+            if(timeleft < (plannerTicks << 1)) break;
+            first = previousIndex;
+            previousPlannerIndex(previousIndex);
+        }
+    }
     if(first == linesWritePos)   // Nothing to plan
     {
         act->block();
@@ -464,6 +699,7 @@ void PrintLine::updateTrapezoids()
     {
         previous->setEndSpeedFixed(true);
         act->setStartSpeedFixed(true);
+        previous->updateStepsParameter(); // computeMaxJunctionSpeed may have changed its end speed
         act->updateStepsParameter();
         firstLine->unblock();
         return;
@@ -475,16 +711,25 @@ void PrintLine::updateTrapezoids()
     {
         previous->setEndSpeedFixed(true);
         act->setStartSpeedFixed(true);
+        previous->updateStepsParameter(); // computeMaxJunctionSpeed may have changed its end speed
         act->updateStepsParameter();
         firstLine->unblock();
         return;
     }
-    backwardPlanner(linesWritePos,first);
+    uint8_t changed = backwardPlanner(linesWritePos,first);
+    if(changed != first)   // The moves before kept their speeds and may start
+    {
+        BEGIN_INTERRUPT_PROTECTED;
+        lines[changed].block();
+        firstLine->unblock();
+        END_INTERRUPT_PROTECTED;
+        first = changed;
+    }
     // Reduce speed to reachable speeds
     forwardPlanner(first);
 
     // Update precomputed data
-    do
+    while(first != linesWritePos)
     {
         lines[first].updateStepsParameter();
         BEGIN_INTERRUPT_PROTECTED;
@@ -493,13 +738,17 @@ void PrintLine::updateTrapezoids()
         lines[first].block();
         END_INTERRUPT_PROTECTED;
     }
-    while(first!=linesWritePos);
     act->updateStepsParameter();
     act->unblock();
 }
 
+#if FEATURE_DELTA_TOWER_LIMITS
+static float deltaTowerJunctionSpeed(PlannerLine *prevPlan,PlannerLine *curPlan);
+#endif
+
 inline void PrintLine::computeMaxJunctionSpeed(PrintLine *previous,PrintLine *current)
 {
+    PlannerLine *prevPlan = previous->getPlannerLine(),*curPlan = current->getPlannerLine();
 #ifdef USE_ADVANCE
     if(Printer::isAdvanceActivated())
     {
@@ -507,7 +756,7 @@ inline void PrintLine::computeMaxJunctionSpeed(PrintLine *previous,PrintLine *cu
         {
             previous->setEndSpeedFixed(true);
             current->setStartSpeedFixed(true);
-            previous->endSpeed = current->startSpeed = previous->maxJunctionSpeed = RMath::min(previous->endSpeed,current->startSpeed);
+            prevPlan->endSpeed2 = curPlan->startSpeed2 = prevPlan->maxJunctionSpeed2 = RMath::min(prevPlan->endSpeed2,curPlan->startSpeed2);
             previous->invalidateParameter();
             current->invalidateParameter();
             return;
@@ -515,47 +764,90 @@ inline void PrintLine::computeMaxJunctionSpeed(PrintLine *previous,PrintLine *cu
     }
 #endif // USE_ADVANCE
 #if NONLINEAR_SYSTEM
-    if (previous->moveID == current->moveID)   // Avoid computing junction speed for split delta lines
+    if (prevPlan->moveID == curPlan->moveID)   // Avoid computing junction speed for split delta lines
     {
-        if(previous->fullSpeed>current->fullSpeed)
-            previous->maxJunctionSpeed = current->fullSpeed;
+        if(prevPlan->fullSpeed>curPlan->fullSpeed)
+            prevPlan->maxJunctionSpeed2 = curPlan->fullSpeed * curPlan->fullSpeed;
         else
-            previous->maxJunctionSpeed = previous->fullSpeed;
+            prevPlan->maxJunctionSpeed2 = prevPlan->fullSpeed * prevPlan->fullSpeed;
         return;
     }
 #endif
-    // First we compute the normalized jerk for speed 1
-    float dx = current->speedX-previous->speedX;
-    float dy = current->speedY-previous->speedY;
     float factor=1;
+    float junctionSpeed2 = curPlan->fullSpeed * curPlan->fullSpeed;
+#ifdef RAMP_ACCELERATION
+    if(Printer::junctionDeviation > 0 && previous->isXYZMove() && current->isXYZMove())
+    {
+        // Junction deviation: Move on a circle touching both segments with maximum acceleration.
+        // theta is the angle between reversed previous and current direction.
+        float dot = prevPlan->speedX*curPlan->speedX + prevPlan->speedY*curPlan->speedY + prevPlan->speedZ*curPlan->speedZ;
+        float len2 = (prevPlan->speedX*prevPlan->speedX + prevPlan->speedY*prevPlan->speedY + prevPlan->speedZ*prevPlan->speedZ) *
+                     (curPlan->speedX*curPlan->speedX + curPlan->speedY*curPlan->speedY + curPlan->speedZ*curPlan->speedZ);
+        float cosTheta = -dot/sqrt(len2);
+        if(cosTheta > 0.999)   // Reversal, stop at the join
+            junctionSpeed2 = 0;
+        else if(cosTheta > -0.999)   // Nearly straight joins are not limited
+        {
+            float *accel = (current->isEPositiveMove() ? Printer::maxAccelerationMMPerSquareSecond : Printer::maxTravelAccelerationMMPerSquareSecond);
+            float sinThetaHalf = sqrt(0.5*(1.0-cosTheta));
+            junctionSpeed2 = RMath::min(accel[X_AXIS],accel[Y_AXIS]) * Printer::junctionDeviation * sinThetaHalf / (1.0-sinThetaHalf);
+        }
+    }
+    else
+#endif // RAMP_ACCELERATION
+    {
+        // First we compute the normalized jerk for speed 1
+        float dx = curPlan->speedX-prevPlan->speedX;
+        float dy = curPlan->speedY-prevPlan->speedY;
 #if (DRIVE_SYSTEM == 3) // No point computing Z Jerk separately for delta moves
-    float dz = current->speedZ-previous->speedZ;
-    float jerk = sqrt(dx*dx+dy*dy+dz*dz);
+        float dz = curPlan->speedZ-prevPlan->speedZ;
+        float jerk = sqrt(dx*dx+dy*dy+dz*dz);
 #else
-    float jerk = sqrt(dx*dx+dy*dy);
+        float jerk = sqrt(dx*dx+dy*dy);
 #endif
-    if(jerk>Printer::maxJerk)
-        factor = Printer::maxJerk/jerk;
+        if(jerk>Printer::maxJerk)
+            factor = Printer::maxJerk/jerk;
+    }
 #if DRIVE_SYSTEM!=3
     if((previous->dir | current->dir) & 64)
     {
-        float dz = fabs(current->speedZ-previous->speedZ);
+        float dz = fabs(curPlan->speedZ-prevPlan->speedZ);
         if(dz>Printer::maxZJerk)
             factor = RMath::min(factor,Printer::maxZJerk/dz);
     }
 #endif
-    float eJerk = fabs(current->speedE-previous->speedE);
+    float eJerk = fabs(curPlan->speedE-prevPlan->speedE);
     if(eJerk > Extruder::current->maxStartFeedrate)
         factor = RMath::min(factor,Extruder::current->maxStartFeedrate/eJerk);
-    previous->maxJunctionSpeed = RMath::min(previous->fullSpeed*factor,current->fullSpeed);
+    float maxJunctionSpeed = RMath::min(prevPlan->fullSpeed*factor,curPlan->fullSpeed);
+#if FEATURE_DELTA_TOWER_LIMITS
+    if(previous->isXYZMove() && current->isXYZMove())
+        maxJunctionSpeed = RMath::min(maxJunctionSpeed,deltaTowerJunctionSpeed(prevPlan,curPlan));
+#endif
+    prevPlan->maxJunctionSpeed2 = RMath::min(maxJunctionSpeed * maxJunctionSpeed,junctionSpeed2);
 #ifdef DEBUG_QUEUE_MOVE
     if(Printer::debugEcho()) {
         Com::printF(PSTR("ID:"),(int)previous);
-        Com::printFLN(PSTR(" MJ:"),previous->maxJunctionSpeed);
+        Com::printFLN(PSTR(" MJ:"),sqrt(prevPlan->maxJunctionSpeed2));
     }
 #endif // DEBUG_QUEUE_MOVE
 }
 
+#if FEATURE_S_CURVE_ACCELERATION
+/** Duration in seconds of an S-curve changing the speed by deltaV, with peak acceleration accel and jerk as limits. */
+static inline float sCurveTime(float deltaV,float accel,float jerk)
+{
+    if(deltaV * jerk >= accel * accel) // the configured acceleration is reached
+        return deltaV / accel + accel / jerk;
+    return 2.0f * sqrt(deltaV / jerk);
+}
+/** Steps of an S-curve from speed v1 up to v2 >= v1. */
+static inline float sCurveSteps(speed_t v1,speed_t v2,float accel,float jerk)
+{
+    return 0.5f * ((float)v1 + (float)v2) * sCurveTime((float)(v2 - v1),accel,jerk);
+}
+#endif
+
 /** Update parameter used by updateTrapezoids
 
 Computes the acceleration/decelleration steps and advanced parameter associated.
@@ -563,25 +855,60 @@ Computes the acceleration/decelleration steps and advanced parameter associated.
 void PrintLine::updateStepsParameter()
 {
     if(areParameterUpToDate() || isWarmUp()) return;
-    float startFactor = startSpeed * invFullSpeed;
-    float endFactor   = endSpeed   * invFullSpeed;
+    SIM_COUNT(parameterUpdates);
+    PlannerLine *pl = getPlannerLine();
+    float startFactor = sqrt(pl->startSpeed2) * pl->invFullSpeed;
+    float endFactor   = sqrt(pl->endSpeed2)   * pl->invFullSpeed;
     vStart = vMax * startFactor; //starting speed
     vEnd   = vMax * endFactor;
+#if FEATURE_S_CURVE_ACCELERATION
+    float accel = pl->accelerationPrim;
+    float jerk = (float)S_CURVE_JERK * (float)vMax * pl->invFullSpeed; // steps/s^3
+    float stepsFree = (float)stepsRemaining - 2; // Reserve for rounding
+    float maxTime = 0; // Set if the line is too short for the jerk limit
+    speed_t vPeak = vMax; // Highest speed really reached, the ramps are shaped between this and start/end speed
+    if(sCurveSteps(vStart,vMax,accel,jerk) + sCurveSteps(vEnd,vMax,accel,jerk) > stepsFree)   // can't reach limit speed
+    {
+        speed_t vHigh = vMax;
+        vPeak = RMath::max(vStart,vEnd);
+        for(uint8_t i = 0; i < 10 && vHigh - vPeak > 1; i++)
+        {
+            speed_t v = vPeak + ((vHigh - vPeak) >> 1);
+            if(sCurveSteps(vStart,v,accel,jerk) + sCurveSteps(vEnd,v,accel,jerk) > stepsFree)
+                vHigh = v;
+            else
+                vPeak = v;
+        }
+        if(sCurveSteps(vStart,vPeak,accel,jerk) + sCurveSteps(vEnd,vPeak,accel,jerk) > stepsFree)
+            maxTime = stepsFree / (0.5f * ((float)vStart + (float)vEnd) + 1.0f);
+    }
+    float accelTime = computeSCurveRamp(accelRamp,vPeak - vStart,accel,jerk,maxTime);
+    float decelTime = computeSCurveRamp(decelRamp,vPeak - vEnd,accel,jerk,maxTime);
+    // The speed of an S-curve is symmetric around its middle, so the mean speed is that of the trapezoid
+    decelSteps = (unsigned int)(0.5f * ((float)vPeak + (float)vEnd) * decelTime) + 1;
+    if(vPeak < vMax) // No plateau, the acceleration ramp ends at vPeak and keeps it until deceleration
+        accelSteps = (stepsRemaining > (long)decelSteps ? stepsRemaining - decelSteps : 0);
+    else
+        accelSteps = (unsigned int)(0.5f * ((float)vStart + (float)vPeak) * accelTime) + 1;
+#else
     unsigned long vmax2 = HAL::U16SquaredToU32(vMax);
-    accelSteps = ((vmax2 - HAL::U16SquaredToU32(vStart)) / (accelerationPrim<<1)) + 1; // Always add 1 for missing precision
-    decelSteps = ((vmax2 - HAL::U16SquaredToU32(vEnd))  /(accelerationPrim<<1)) + 1;
+    accelSteps = ((vmax2 - HAL::U16SquaredToU32(vStart)) / (pl->accelerationPrim<<1)) + 1; // Always add 1 for missing precision
+    decelSteps = ((vmax2 - HAL::U16SquaredToU32(vEnd))  /(pl->accelerationPrim<<1)) + 1;
+#endif
 #ifdef USE_ADVANCE
 #ifdef ENABLE_QUADRATIC_ADVANCE
     advanceStart = (float)advanceFull*startFactor * startFactor;
     advanceEnd   = (float)advanceFull*endFactor   * endFactor;
 #endif
 #endif
+#if !FEATURE_S_CURVE_ACCELERATION
     if(accelSteps+decelSteps >= stepsRemaining)   // can't reach limit speed
     {
         unsigned int red = (accelSteps+decelSteps + 2 - stepsRemaining) >> 1;
         accelSteps = accelSteps-RMath::min(accelSteps,red);
         decelSteps = decelSteps-RMath::min(decelSteps,red);
     }
+#endif
     setParameterUpToDate();
 #ifdef DEBUG_QUEUE_MOVE
     if(Printer::debugEcho())
@@ -592,156 +919,193 @@ void PrintLine::updateStepsParameter()
         Com::printF(Com::tDBAccelSteps,(long)accelSteps);
         Com::printF(Com::tSlash,(long)decelSteps);
         Com::printFLN(Com::tSlash,(long)stepsRemaining);
-        Com::printF(Com::tDBGStartEndSpeed,startSpeed,1);
-        Com::printFLN(Com::tSlash,endSpeed,1);
+        Com::printF(Com::tDBGStartEndSpeed,sqrt(pl->startSpeed2),1);
+        Com::printFLN(Com::tSlash,sqrt(pl->endSpeed2),1);
         Com::printFLN(Com::tDBGFlags,flags);
         Com::printFLN(Com::tDBGJoinFlags,joinFlags);
     }
 #endif
 }
 
+#if FEATURE_S_CURVE_ACCELERATION
+/**
+Precomputes the S-curve for a speed change of deltaV steps/s and returns its duration in seconds.
+
+The ramp takes sCurveTime, so the peak acceleration a_p stays below accel and the jerk below jerk.
+With jerk phases of length tj the peak follows from a_p*(T-tj) = deltaV. If maxTime is set and
+shorter, the line is too short for the jerk limit and the ramp is compressed to maxTime with a
+higher jerk, the acceleration still stays below accel.
+*/
+float PrintLine::computeSCurveRamp(SCurveRamp &ramp,speed_t deltaV,float accel,float jerk,float maxTime)
+{
+    ramp.deltaV = deltaV;
+    ramp.fPeak = fAcceleration;
+    ramp.rampTime = ramp.jerkTime = ramp.jerkFactor = 0;
+    if(deltaV == 0) return 0;
+    SIM_COUNT(sCurveRamps);
+    float linearTime = (float)deltaV / accel;
+    float time = sCurveTime(deltaV,accel,jerk);
+    if(maxTime > 0 && time > maxTime)
+    {
+        SIM_COUNT(sCurveJerkRaised);
+        time = maxTime;
+    }
+    float jerkTime = RMath::min(0.5f * time,time - linearTime);
+    float rampUnits = time * (F_CPU / 256.0f) + 2; // rounded up, so a_p and jerk stay below their limits
+    if(jerkTime * (F_CPU / 256.0f) < 1 || rampUnits > 32767)   // Too short or too long to shape, use constant acceleration
+    {
+        SIM_COUNT(sCurveUnshaped);
+        return linearTime;
+    }
+    uint16_t jerkUnits = (uint16_t)(jerkTime * (F_CPU / 256.0f)) + 1;
+    ramp.jerkFactor = 32768 / jerkUnits;
+    // Lengthen the jerk phases until jerkFactor*jerkTime is 32768 within one jerkFactor, else speedChange jumps between the phases
+    ramp.jerkTime = (32768 + ramp.jerkFactor - 1) / ramp.jerkFactor;
+    ramp.rampTime = RMath::max((long)rampUnits + ramp.jerkTime - jerkUnits,2L * ramp.jerkTime);
+    ramp.fPeak = ((unsigned long)deltaV << 10) / (ramp.rampTime - ramp.jerkTime);
+    return (float)ramp.rampTime * (256.0f / F_CPU);
+}
+#endif
+
 /**
 Compute the maximum speed from the last entered move.
 The backwards planner traverses the moves from last to first looking at deceleration. The RHS of the accelerate/decelerate ramp.
+All speeds are squared, so no square root is needed.
 
 start = last line inserted
 last = last element until we check
+
+Returns the index of the first move whose start speed may have changed.
 */
-inline void PrintLine::backwardPlanner(uint8_t start,uint8_t last)
+inline uint8_t PrintLine::backwardPlanner(uint8_t start,uint8_t last)
 {
     PrintLine *act = &lines[start],*previous;
-    float lastJunctionSpeed = act->endSpeed; // Start always with safe speed
+    PlannerLine *actPlan = act->getPlannerLine(),*prevPlan;
+    float lastJunctionSpeed2 = actPlan->endSpeed2; // Start always with safe speed
 
     //PREVIOUS_PLANNER_INDEX(last); // Last element is already fixed in start speed
     while(start != last)
     {
+        uint8_t actIndex = start;
         previousPlannerIndex(start);
         previous = &lines[start];
+        prevPlan = previous->getPlannerLine();
+        SIM_COUNT(plannerSegments);
+        float prevEndSpeed2 = prevPlan->endSpeed2,actStartSpeed2 = actPlan->startSpeed2;
         // Avoid speed calc once crusing in split delta move
 #if NONLINEAR_SYSTEM
-        if (previous->moveID == act->moveID && lastJunctionSpeed == previous->maxJunctionSpeed)
+        if (prevPlan->moveID == actPlan->moveID && lastJunctionSpeed2 == prevPlan->maxJunctionSpeed2)
         {
-            act->startSpeed = RMath::max(act->minSpeed,previous->endSpeed = lastJunctionSpeed);
-            previous->invalidateParameter();
-            act->invalidateParameter();
+            prevPlan->endSpeed2 = lastJunctionSpeed2;
+            actPlan->startSpeed2 = RMath::max(actPlan->minSpeed2,lastJunctionSpeed2);
         }
 #endif
 
-        /* if(prev->isEndSpeedFixed())   // Nothing to update from here on, happens when path optimize disabled
-         {
-             act->setStartSpeedFixed(true);
-             return;
-         }*/
-
         // Avoid speed calcs if we know we can accelerate within the line
-        lastJunctionSpeed = (act->isNominalMove() ? act->fullSpeed : sqrt(lastJunctionSpeed*lastJunctionSpeed+act->accelerationDistance2)); // acceleration is acceleration*distance*2! What can be reached if we try?
+        lastJunctionSpeed2 = (act->isNominalMove() ? actPlan->fullSpeed * actPlan->fullSpeed : lastJunctionSpeed2 + actPlan->accelerationDistance2); // acceleration is acceleration*distance*2! What can be reached if we try?
         // If that speed is more that the maximum junction speed allowed then ...
-        if(lastJunctionSpeed >= previous->maxJunctionSpeed)   // Limit is reached
+        if(lastJunctionSpeed2 >= prevPlan->maxJunctionSpeed2)   // Limit is reached
         {
-            // If the previous line's end speed has not been updated to maximum speed then do it now
-            if(previous->endSpeed != previous->maxJunctionSpeed)
-            {
-                previous->invalidateParameter(); // Needs recomputation
-                previous->endSpeed = RMath::max(previous->minSpeed,previous->maxJunctionSpeed); // possibly unneeded???
-            }
-            // If actual line start speed has not been updated to maximum speed then do it now
-            if(act->startSpeed != previous->maxJunctionSpeed)
-            {
-                act->startSpeed = RMath::max(act->minSpeed,previous->maxJunctionSpeed); // possibly unneeded???
-                act->invalidateParameter();
-            }
-            lastJunctionSpeed = previous->endSpeed;
+            prevPlan->endSpeed2 = RMath::max(prevPlan->minSpeed2,prevPlan->maxJunctionSpeed2);
+            actPlan->startSpeed2 = RMath::max(actPlan->minSpeed2,prevPlan->maxJunctionSpeed2);
+            lastJunctionSpeed2 = prevPlan->endSpeed2;
         }
         else
         {
             // Block prev end and act start as calculated speed and recalculate plateau speeds (which could move the speed higher again)
-            act->startSpeed = RMath::max(act->minSpeed,lastJunctionSpeed);
-            lastJunctionSpeed = previous->endSpeed = RMath::max(lastJunctionSpeed,previous->minSpeed);
-            previous->invalidateParameter();
-            act->invalidateParameter();
+            actPlan->startSpeed2 = RMath::max(actPlan->minSpeed2,lastJunctionSpeed2);
+            lastJunctionSpeed2 = prevPlan->endSpeed2 = RMath::max(lastJunctionSpeed2,prevPlan->minSpeed2);
         }
+        if(actPlan->startSpeed2 != actStartSpeed2)
+            act->invalidateParameter();
+        if(prevPlan->endSpeed2 != prevEndSpeed2)
+            previous->invalidateParameter();
+        else if(actPlan->startSpeed2 == actStartSpeed2)   // Junction unchanged, the moves before are still optimal
+            return actIndex;
         act = previous;
+        actPlan = prevPlan;
     } // while loop
+    return last;
 }
 
 void PrintLine::forwardPlanner(uint8_t first)
 {
     PrintLine *act;
     PrintLine *next = &lines[first];
-    float vmaxRight;
-    float leftSpeed = next->startSpeed;
+    PlannerLine *actPlan,*nextPlan = next->getPlannerLine();
+    float vmaxRight2;
+    float leftSpeed2 = nextPlan->startSpeed2;
     while(first != linesWritePos)   // All except last segment, which has fixed end speed
     {
         act = next;
+        actPlan = nextPlan;
         nextPlannerIndex(first);
         next = &lines[first];
-        /* if(act->isEndSpeedFixed())
-         {
-             leftSpeed = act->endSpeed;
-             continue; // Nothing to do here
-         }*/
+        nextPlan = next->getPlannerLine();
+        SIM_COUNT(plannerSegments);
+        float startSpeed2 = actPlan->startSpeed2,endSpeed2 = actPlan->endSpeed2;
         // Avoid speed calc once crusing in split delta move
 #if NONLINEAR_SYSTEM
-        if (act->moveID == next->moveID && act->endSpeed == act->maxJunctionSpeed)
+        if (actPlan->moveID == nextPlan->moveID && actPlan->endSpeed2 == actPlan->maxJunctionSpeed2)
         {
-            act->startSpeed = leftSpeed;
-            leftSpeed       = act->endSpeed;
+            actPlan->startSpeed2 = leftSpeed2;
+            leftSpeed2           = actPlan->endSpeed2;
             act->setEndSpeedFixed(true);
             next->setStartSpeedFixed(true);
             continue;
         }
 #endif
         // Avoid speed calcs if we know we can accelerate within the line.
-        vmaxRight = (act->isNominalMove() ? act->fullSpeed : sqrt(leftSpeed * leftSpeed + act->accelerationDistance2));
-        if(vmaxRight > act->endSpeed)   // Could be higher next run?
+        vmaxRight2 = (act->isNominalMove() ? actPlan->fullSpeed * actPlan->fullSpeed : leftSpeed2 + actPlan->accelerationDistance2);
+        if(vmaxRight2 > actPlan->endSpeed2)   // Could be higher next run?
         {
-            if(leftSpeed < act->minSpeed) {
-                leftSpeed = act->minSpeed;
-                act->endSpeed = sqrt(leftSpeed * leftSpeed + act->accelerationDistance2);
+            if(leftSpeed2 < actPlan->minSpeed2) {
+                leftSpeed2 = actPlan->minSpeed2;
+                actPlan->endSpeed2 = leftSpeed2 + actPlan->accelerationDistance2;
             }
-            act->startSpeed = leftSpeed;
-            next->startSpeed = leftSpeed = RMath::max(RMath::min(act->endSpeed,act->maxJunctionSpeed),next->minSpeed);
-            if(act->endSpeed == act->maxJunctionSpeed)  // Full speed reached, don't compute again!
+            actPlan->startSpeed2 = leftSpeed2;
+            nextPlan->startSpeed2 = leftSpeed2 = RMath::max(RMath::min(actPlan->endSpeed2,actPlan->maxJunctionSpeed2),nextPlan->minSpeed2);
+            if(actPlan->endSpeed2 == actPlan->maxJunctionSpeed2)  // Full speed reached, don't compute again!
             {
                 act->setEndSpeedFixed(true);
                 next->setStartSpeedFixed(true);
             }
-            act->invalidateParameter();
         }
         else     // We can accelerate full speed without reaching limit, which is as fast as possible. Fix it!
         {
             act->fixStartAndEndSpeed();
-            act->invalidateParameter();
-            if(act->minSpeed > leftSpeed) {
-                leftSpeed = act->minSpeed;
-                vmaxRight = sqrt(leftSpeed * leftSpeed + act->accelerationDistance2);
+            if(actPlan->minSpeed2 > leftSpeed2) {
+                leftSpeed2 = actPlan->minSpeed2;
+                vmaxRight2 = leftSpeed2 + actPlan->accelerationDistance2;
             }
-            act->startSpeed = leftSpeed;
-            act->endSpeed = RMath::max(act->minSpeed,vmaxRight);
-            next->startSpeed = leftSpeed = RMath::max(RMath::min(act->endSpeed,act->maxJunctionSpeed),next->minSpeed);
+            actPlan->startSpeed2 = leftSpeed2;
+            actPlan->endSpeed2 = RMath::max(actPlan->minSpeed2,vmaxRight2);
+            nextPlan->startSpeed2 = leftSpeed2 = RMath::max(RMath::min(actPlan->endSpeed2,actPlan->maxJunctionSpeed2),nextPlan->minSpeed2);
             next->setStartSpeedFixed(true);
         }
+        if(actPlan->startSpeed2 != startSpeed2 || actPlan->endSpeed2 != endSpeed2) // Only changed moves need new parameters
+            act->invalidateParameter();
     } // While
-    next->startSpeed = RMath::max(next->minSpeed,leftSpeed); // This is the new segment, which is updated anyway, no extra flag needed.
+    nextPlan->startSpeed2 = RMath::max(nextPlan->minSpeed2,leftSpeed2); // This is the new segment, which is updated anyway, no extra flag needed.
 }
 
 
-inline float PrintLine::safeSpeed()
+inline float PrintLine::safeSpeed(PlannerLine *pl)
 {
     float safe(Printer::maxJerk * 0.5);
 #if DRIVE_SYSTEM != 3
     if(isZMove())
     {
         if(primaryAxis == Z_AXIS) {
-            safe = Printer::maxZJerk*0.5*fullSpeed/fabs(speedZ);
-        } else if(fabs(speedZ) > Printer::maxZJerk * 0.5)
-            safe = RMath::min(safe,Printer::maxZJerk * 0.5 * fullSpeed / fabs(speedZ));
+            safe = Printer::maxZJerk*0.5*pl->fullSpeed/fabs(pl->speedZ);
+        } else if(fabs(pl->speedZ) > Printer::maxZJerk * 0.5)
+            safe = RMath::min(safe,Printer::maxZJerk * 0.5 * pl->fullSpeed / fabs(pl->speedZ));
     }
 #endif
     if(isEMove())
     {
         if(isXYZMove())
-            safe = RMath::min(safe,0.5*Extruder::current->maxStartFeedrate*fullSpeed/fabs(speedE));
+            safe = RMath::min(safe,0.5*Extruder::current->maxStartFeedrate*pl->fullSpeed/fabs(pl->speedE));
         else
             safe = 0.5*Extruder::current->maxStartFeedrate; // This is a retraction move
     }
@@ -750,7 +1114,7 @@ inline float PrintLine::safeSpeed()
     else if(primaryAxis == Z_AXIS) {
         safe = RMath::max(Printer::minimumZSpeed,safe);
     }
-    return RMath::min(safe,fullSpeed);
+    return RMath::min(safe,pl->fullSpeed);
 }
 
 
@@ -784,10 +1148,10 @@ void PrintLine::logLine()
     Com::printArrayFLN(Com::tDBGDelta,delta);
     Com::printFLN(Com::tDBGDir,dir);
     Com::printFLN(Com::tDBGFlags,flags);
-    Com::printFLN(Com::tDBGFullSpeed,fullSpeed);
+    Com::printFLN(Com::tDBGFullSpeed,getPlannerLine()->fullSpeed);
     Com::printFLN(Com::tDBGVMax,(long)vMax);
-    Com::printFLN(Com::tDBGAcceleration,accelerationDistance2);
-    Com::printFLN(Com::tDBGAccelerationPrim,(long)accelerationPrim);
+    Com::printFLN(Com::tDBGAcceleration,getPlannerLine()->accelerationDistance2);
+    Com::printFLN(Com::tDBGAccelerationPrim,(long)getPlannerLine()->accelerationPrim);
     Com::printFLN(Com::tDBGRemainingSteps,stepsRemaining);
 #ifdef USE_ADVANCE
 #ifdef ENABLE_QUADRATIC_ADVANCE
@@ -810,81 +1174,108 @@ void PrintLine::waitForXFreeLines(uint8_t b)
 
 #if DRIVE_SYSTEM==3
 /**
-  Calculate the delta tower position from a cartesian position
-  @param cartesianPosSteps Array containing cartesian coordinates.
-  @param deltaPosSteps Result array with tower coordinates.
-  @returns 1 if cartesian coordinates have a valid delta tower position 0 if not.
+  Calculate the height of a carriage above the effector.
+  @param dx Horizontal x distance between tower and effector in steps.
+  @param dy Horizontal y distance between tower and effector in steps.
+  @param height Result in steps.
+  @returns 1 if the rod can reach the effector, 0 if not.
 */
-uint8_t transformCartesianStepsToDeltaSteps(long cartesianPosSteps[], long deltaPosSteps[])
+static inline uint8_t deltaCarriageHeight(long dx, long dy, long *height)
 {
-    if(Printer::isLargeMachine())
+    unsigned long adx = labs(dx), ady = labs(dy);
+    if(adx >= (unsigned long)Printer::deltaDiagonalSteps || ady >= (unsigned long)Printer::deltaDiagonalSteps)
+        return 0;
+    if(!Printer::isLargeMachine())
     {
-        float temp = Printer::deltaAPosYSteps - cartesianPosSteps[Y_AXIS];
-        float opt = Printer::deltaDiagonalStepsSquaredF - temp*temp;
-        float temp2 = Printer::deltaAPosXSteps - cartesianPosSteps[X_AXIS];
-        if ((temp = opt - temp2*temp2) >= 0)
-            deltaPosSteps[X_AXIS] = sqrt(temp) + cartesianPosSteps[Z_AXIS];
-        else
-            return 0;
-
-        temp = Printer::deltaBPosYSteps - cartesianPosSteps[Y_AXIS];
-        opt = Printer::deltaDiagonalStepsSquaredF - temp*temp;
-        temp2 = Printer::deltaBPosXSteps - cartesianPosSteps[X_AXIS];
-        if ((temp = opt - temp2*temp2) >= 0)
-            deltaPosSteps[Y_AXIS] = sqrt(temp) + cartesianPosSteps[Z_AXIS];
-        else
-            return 0;
-
-        temp = Printer::deltaCPosYSteps - cartesianPosSteps[Y_AXIS];
-        opt = Printer::deltaDiagonalStepsSquaredF - temp*temp;
-        temp2 = Printer::deltaCPosXSteps - cartesianPosSteps[X_AXIS];
-        if ((temp = opt - temp2*temp2) >= 0)
-            deltaPosSteps[Z_AXIS] = sqrt(temp) + cartesianPosSteps[Z_AXIS];
-        else
+        // Rod length is below 65536 steps, so all squares fit unsigned 32 bit
+        unsigned long temp = Printer::deltaDiagonalStepsSquared - adx*adx;
+        unsigned long dy2 = ady*ady;
+        if(dy2 > temp)
             return 0;
+        *height = HAL::integerSqrt(temp - dy2);
         return 1;
     }
-    else
-    {
-        long temp = Printer::deltaAPosYSteps - cartesianPosSteps[Y_AXIS];
-        long opt = Printer::deltaDiagonalStepsSquared - temp*temp;
-        long temp2 = Printer::deltaAPosXSteps - cartesianPosSteps[X_AXIS];
-        if ((temp = opt - temp2*temp2) >= 0)
-#ifdef FAST_INTEGER_SQRT
-            deltaPosSteps[X_AXIS] = HAL::integerSqrt(temp) + cartesianPosSteps[Z_AXIS];
+#if CPU_ARCH==ARCH_AVR
+    // 64 bit multiplies and divides are library calls on AVR, the float square root is cheaper
+    float temp = Printer::deltaDiagonalStepsSquaredF - (float)adx*(float)adx - (float)ady*(float)ady;
+    if(temp < 0)
+        return 0;
+    *height = (long)(sqrt(temp) + 0.5f);
+    return 1;
 #else
-            deltaPosSteps[X_AXIS] = sqrt(temp) + cartesianPosSteps[Z_AXIS];
+    // Square root of the radicand shifted into 30 bit, refined by one Newton step
+    uint8_t shift = Printer::deltaSqrtShift;
+    int64_t temp = (int64_t)Printer::deltaDiagonalSteps * Printer::deltaDiagonalSteps - (int64_t)adx*adx - (int64_t)ady*ady;
+    if(temp < 0)
+        return 0;
+    long root = (long)HAL::integerSqrt((long)(temp >> (shift << 1))) << shift;
+    if(root == 0)
+    {
+        *height = 0;
+        return 1;
+    }
+    long error = (long)(temp - (int64_t)root*root);
+    *height = root + (error >= 0 ? (error + root) / (root << 1) : -((root - error) / (root << 1)));
+    return 1;
 #endif
-        else
-            return 0;
+}
+/**
+  Calculate the delta tower position from a cartesian position
+  @param cartesianPosSteps Array containing cartesian coordinates.
+  @param deltaPosSteps Result array with tower coordinates.
+  @returns 1 if cartesian coordinates have a valid delta tower position 0 if not.
+*/
+uint8_t transformCartesianStepsToDeltaSteps(long cartesianPosSteps[], long deltaPosSteps[])
+{
+    if(!deltaCarriageHeight(Printer::deltaAPosXSteps - cartesianPosSteps[X_AXIS],Printer::deltaAPosYSteps - cartesianPosSteps[Y_AXIS],&deltaPosSteps[X_AXIS]))
+        return 0;
+    if(!deltaCarriageHeight(Printer::deltaBPosXSteps - cartesianPosSteps[X_AXIS],Printer::deltaBPosYSteps - cartesianPosSteps[Y_AXIS],&deltaPosSteps[Y_AXIS]))
+        return 0;
+    if(!deltaCarriageHeight(Printer::deltaCPosXSteps - cartesianPosSteps[X_AXIS],Printer::deltaCPosYSteps - cartesianPosSteps[Y_AXIS],&deltaPosSteps[Z_AXIS]))
+        return 0;
+    deltaPosSteps[X_AXIS] += cartesianPosSteps[Z_AXIS];
+    deltaPosSteps[Y_AXIS] += cartesianPosSteps[Z_AXIS];
+    deltaPosSteps[Z_AXIS] += cartesianPosSteps[Z_AXIS];
+    return 1;
+}
 
-        temp = Printer::deltaBPosYSteps - cartesianPosSteps[Y_AXIS];
-        opt = Printer::deltaDiagonalStepsSquared - temp*temp;
-        temp2 = Printer::deltaBPosXSteps - cartesianPosSteps[X_AXIS];
-        if ((temp = opt - temp2*temp2) >= 0)
-#ifdef FAST_INTEGER_SQRT
-            deltaPosSteps[Y_AXIS] = HAL::integerSqrt(temp) + cartesianPosSteps[Z_AXIS];
-#else
-            deltaPosSteps[Y_AXIS] = sqrt(temp) + cartesianPosSteps[Z_AXIS];
-#endif
-        else
-            return 0;
+#if FEATURE_DELTA_TOWER_LIMITS
+/**
+  Highest speed for the join of two moves at Printer::currentPositionSteps, where no tower changes its
+  speed by more than the jerk or exceeds the tower feedrate.
 
-        temp = Printer::deltaCPosYSteps - cartesianPosSteps[Y_AXIS];
-        opt = Printer::deltaDiagonalStepsSquared - temp*temp;
-        temp2 = Printer::deltaCPosXSteps - cartesianPosSteps[X_AXIS];
-        if ((temp = opt - temp2*temp2) >= 0)
-#ifdef FAST_INTEGER_SQRT
-            deltaPosSteps[Z_AXIS] = HAL::integerSqrt(temp) + cartesianPosSteps[Z_AXIS];
-#else
-            deltaPosSteps[Z_AXIS] = sqrt(temp) + cartesianPosSteps[Z_AXIS];
-#endif
-        else
-            return 0;
+  A carriage is h = sqrt(L^2-dx^2-dy^2) above the effector, so it moves (dx*vx+dy*vy)/h+vz for an effector
+  speed (vx,vy,vz), with dx,dy the horizontal distance from effector to tower.
+  @return Speed in mm/s, or a very high speed if the join is outside the reachable area.
+*/
+static float deltaTowerJunctionSpeed(PlannerLine *prevPlan,PlannerLine *curPlan)
+{
+    const long towerX[3] = {Printer::deltaAPosXSteps,Printer::deltaBPosXSteps,Printer::deltaCPosXSteps};
+    const long towerY[3] = {Printer::deltaAPosYSteps,Printer::deltaBPosYSteps,Printer::deltaCPosYSteps};
+    float invPrevSpeed = 1.0 / prevPlan->fullSpeed, invCurSpeed = 1.0 / curPlan->fullSpeed;
+    float maxSpeed = 1e10;
+    for(uint8_t i=0; i < 3; i++)
+    {
+        long dx = towerX[i] - Printer::currentPositionSteps[X_AXIS];
+        long dy = towerY[i] - Printer::currentPositionSteps[Y_AXIS];
+        long height;
+        if(!deltaCarriageHeight(dx,dy,&height) || height <= 0)
+            continue;
+        float invHeight = 1.0 / height;
+        // Tower speed per effector speed before and after the join
+        float prevRatio = ((dx * prevPlan->speedX + dy * prevPlan->speedY) * invHeight + prevPlan->speedZ) * invPrevSpeed;
+        float curRatio = ((dx * curPlan->speedX + dy * curPlan->speedY) * invHeight + curPlan->speedZ) * invCurSpeed;
+        float change = fabs(curRatio - prevRatio);
+        if(change * maxSpeed > Printer::maxJerk)
+            maxSpeed = Printer::maxJerk / change;
+        float ratio = RMath::max(fabs(prevRatio),fabs(curRatio));
+        if(ratio * maxSpeed > Printer::maxFeedrate[X_AXIS])
+            maxSpeed = Printer::maxFeedrate[X_AXIS] / ratio;
     }
-    return 1;
+    return maxSpeed;
 }
 #endif
+#endif
 
 #if DRIVE_SYSTEM==4
 
@@ -1034,6 +1425,245 @@ void PrintLine::calculateDirectionAndDelta(long difference[], uint8_t *dir, long
         if(delta[i]) *dir |= 16<<i;
     }
 }
+/**
+  Moves a cartesian position to the end of the next segment.
+  @param pos Cartesian position in steps, gets updated.
+  @param end Cartesian end of the line in steps.
+  @param s Number of segments left up to end.
+*/
+static inline void nextDeltaSegmentPosition(long pos[], long end[], uint8_t s)
+{
+    for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+    {
+        long diff = end[i] - pos[i];
+        if(s == 1)
+            pos[i] += diff;
+        else if(s == 2)
+            pos[i] += (diff >> 1);
+        else if(s == 4)
+            pos[i] += (diff >> 2);
+        else
+            if(diff<0)
+                pos[i] -= HAL::Div4U2U(-diff, s);
+            else
+                pos[i] += HAL::Div4U2U(diff, s);
+    }
+}
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+/**
+  Calculate the tower positions of a segment end, limited by the software endstop.
+  @return 0 if the position can not be reached.
+*/
+static inline uint8_t deltaSegmentTowers(long cartesianPosSteps[], long deltaPosSteps[], uint8_t softEndstop)
+{
+    if(!transformCartesianStepsToDeltaSteps(cartesianPosSteps, deltaPosSteps))
+        return 0;
+    if(softEndstop)
+        for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+            if(deltaPosSteps[i] > Printer::maxDeltaPositionSteps)
+                deltaPosSteps[i] = Printer::maxDeltaPositionSteps;
+    return 1;
+}
+/**
+  Store the start of the line, so its delta segments can be computed just before the stepper interrupt needs them.
+  Along a straight line every tower moves on a concave curve, so the longest segment is the first or the last one.
+  Only their ends are transformed here.
+  @return The largest delta axis move in a single segment
+*/
+inline uint16_t PrintLine::prepareDeltaSegments(uint8_t softEndstop)
+{
+    long pos[3], towers[3], lastTowers[3];
+    uint8_t valid = 1;
+    uint16_t max_axis_move = 0;
+    segmentFlags = (softEndstop ? DELTA_SEGMENT_SOFT_ENDSTOP : 0);
+    for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+    {
+        pos[i] = segmentStart[i] = Printer::currentPositionSteps[i];
+        lastTowers[i] = segmentTowerStart[i] = Printer::currentDeltaPositionSteps[i];
+        if(Printer::destinationSteps[i] >= pos[i])
+            segmentFlags |= 1<<i;
+    }
+    for (uint8_t s = numDeltaSegments; s > 0; s--)
+    {
+        nextDeltaSegmentPosition(pos, Printer::destinationSteps, s);
+        if(s < numDeltaSegments && s > 2) continue; // Only end of first segment, start of last segment and end of line
+        if(!deltaSegmentTowers(pos, towers, softEndstop))
+        {
+            valid = 0;
+            continue;
+        }
+        for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+        {
+            if(s == numDeltaSegments || s == 1)
+            {
+                long delta = labs(towers[i] - lastTowers[i]);
+#ifdef DEBUG_DELTA_OVERFLOW
+                if (delta > 65535)
+                    Com::printFLN(Com::tDBGDeltaOverflow, delta);
+#endif
+                if (max_axis_move < delta) max_axis_move = delta;
+            }
+            lastTowers[i] = towers[i];
+        }
+        if(s == 1)
+            for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+                Printer::currentDeltaPositionSteps[i] = towers[i];
+    }
+    if(!valid)
+        Com::printWarningFLN(Com::tInvalidDeltaCoordinate);
+    // Segment ends are rounded to full steps, allow the inner segments to be a bit longer
+    if(max_axis_move)
+        max_axis_move += DELTA_SEGMENT_STEP_MARGIN;
+    return max_axis_move;
+}
+/**
+  Compute the next delta segment into the segment buffer.
+
+  The state is copied with interrupts disabled and the segment is only stored, if nobody else stored a segment
+  or restarted the buffer in between. So the stepper interrupt can compute a segment the main loop is working on.
+  @return false if the buffer is full or no queued line has segments left to compute.
+*/
+bool PrintLine::computeDeltaSegment()
+{
+    long pos[3], end[3], towers[3], target[3], maxSteps;
+    uint8_t line, left, softEndstop, sequence;
+    DeltaSegment d;
+    BEGIN_INTERRUPT_PROTECTED
+    if(deltaSegmentsQueued() >= DELTA_SEGMENT_BUFFER_SIZE)
+    {
+        ESCAPE_INTERRUPT_PROTECTED
+        return false;
+    }
+    while(!deltaSegmentsLeft) // Start the next queued line with segments
+    {
+        uint8_t offset = deltaSegmentPos + (deltaSegmentPos < linesPos ? MOVE_CACHE_SIZE : 0) - linesPos;
+        if(offset >= linesCount)
+        {
+            ESCAPE_INTERRUPT_PROTECTED
+            return false;
+        }
+        PrintLine *p = &lines[deltaSegmentPos];
+        if(p->isWarmUp() || !p->numDeltaSegments)
+        {
+            nextPlannerIndex(deltaSegmentPos);
+            continue;
+        }
+        deltaSegmentsLeft = p->numDeltaSegments;
+        deltaSegmentFlags = p->segmentFlags;
+        deltaSegmentMaxSteps = p->numPrimaryStepPerSegment;
+        for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+        {
+            deltaSegmentCartesian[i] = p->segmentStart[i];
+            deltaSegmentEnd[i] = p->segmentStart[i] + (p->segmentFlags & (1<<i) ? p->delta[i] : -p->delta[i]);
+            deltaSegmentTower[i] = p->segmentTowerStart[i];
+        }
+    }
+    line = deltaSegmentPos;
+    left = deltaSegmentsLeft;
+    softEndstop = deltaSegmentFlags & DELTA_SEGMENT_SOFT_ENDSTOP;
+    maxSteps = deltaSegmentMaxSteps;
+    for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+    {
+        pos[i] = deltaSegmentCartesian[i];
+        end[i] = deltaSegmentEnd[i];
+        towers[i] = deltaSegmentTower[i];
+    }
+    sequence = deltaSegmentSequence;
+    END_INTERRUPT_PROTECTED
+
+    SIM_DELTA_SEGMENT_START(pos);
+    nextDeltaSegmentPosition(pos, end, left);
+    SIM_DELTA_SEGMENT_END(pos);
+    d.dir = 0;
+    d.deltaSteps[X_AXIS] = d.deltaSteps[Y_AXIS] = d.deltaSteps[Z_AXIS] = 0;
+    if (deltaSegmentTowers(pos, target, softEndstop)) // An illegal position was reported when the line was queued
+    {
+        for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+        {
+            long delta = target[i] - towers[i];
+            if(delta > maxSteps || delta < -maxSteps) // Rest is added to the next segment
+            {
+                SIM_COUNT(deltaSegmentClamps);
+                delta = (delta > 0 ? maxSteps : -maxSteps);
+            }
+            towers[i] += delta;
+            if (delta > 0)
+            {
+                d.dir |= 17<<i;
+                d.deltaSteps[i] = delta;
+            }
+            else
+            {
+                d.dir |= 16<<i;
+                d.deltaSteps[i] = -delta;
+            }
+        }
+    }
+
+    BEGIN_INTERRUPT_PROTECTED
+    if(sequence == deltaSegmentSequence)
+    {
+        uint8_t slot = deltaSegmentsWrite & (DELTA_SEGMENT_BUFFER_SIZE - 1);
+        deltaSegments[slot] = d;
+        deltaSegmentLine[slot] = line;
+        for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+        {
+            deltaSegmentCartesian[i] = pos[i];
+            deltaSegmentTower[i] = towers[i];
+        }
+        if(!--deltaSegmentsLeft)
+            nextPlannerIndex(deltaSegmentPos);
+        deltaSegmentsWrite++;
+        deltaSegmentSequence++;
+        SIM_COUNT(deltaSegmentsComputed);
+    }
+    END_INTERRUPT_PROTECTED
+    return true;
+}
+
+/** Computes delta segments ahead of the stepper interrupt until the segment buffer is full. */
+void PrintLine::fillDeltaSegments()
+{
+    if(deltaSegmentFilling) return;
+    deltaSegmentFilling = 1;
+    while(computeDeltaSegment()) {}
+    deltaSegmentFilling = 0;
+}
+
+/**
+  Returns the next delta segment for the stepper interrupt and releases the previous one of the line.
+  If the buffer has run empty, the segment is computed here.
+  @param first true for the first segment of the line at linesPos.
+*/
+DeltaSegment *PrintLine::nextDeltaSegment(bool first)
+{
+    if(!first)
+        deltaSegmentsRead++;
+    else if(!deltaSegmentsQueued() || deltaSegmentLine[deltaSegmentsRead & (DELTA_SEGMENT_BUFFER_SIZE - 1)] != linesPos)
+        restartDeltaSegments();
+    while(!deltaSegmentsQueued())
+    {
+        SIM_COUNT(deltaSegmentsLate);
+        if(!computeDeltaSegment()) return NULL;
+    }
+    return &deltaSegments[deltaSegmentsRead & (DELTA_SEGMENT_BUFFER_SIZE - 1)];
+}
+
+/** Drops the segments left of the line at linesPos, called when it is removed. */
+void PrintLine::releaseDeltaSegments()
+{
+    BEGIN_INTERRUPT_PROTECTED
+    while(deltaSegmentsQueued() && deltaSegmentLine[deltaSegmentsRead & (DELTA_SEGMENT_BUFFER_SIZE - 1)] == linesPos)
+        deltaSegmentsRead++;
+    if(deltaSegmentsLeft && deltaSegmentPos == linesPos)
+    {
+        deltaSegmentsLeft = 0;
+        nextPlannerIndex(deltaSegmentPos);
+        deltaSegmentSequence++;
+    }
+    END_INTERRUPT_PROTECTED
+}
+#else
 /**
   Calculate and cache the delta robot positions of the cartesian move in a line.
   @return The largest delta axis move in a single segment
@@ -1042,7 +1672,7 @@ void PrintLine::calculateDirectionAndDelta(long difference[], uint8_t *dir, long
 inline uint16_t PrintLine::calculateDeltaSubSegments(uint8_t softEndstop)
 {
     uint8_t i;
-    long delta,diff;
+    long delta;
     long destinationSteps[3], destinationDeltaSteps[3];
     // Save current position
     for(uint8_t i=0; i < NUM_AXIS - 1; i++)
@@ -1057,21 +1687,9 @@ inline uint16_t PrintLine::calculateDeltaSubSegments(uint8_t softEndstop)
     for (int s = numDeltaSegments; s > 0; s--)
     {
         DeltaSegment *d = &segments[s-1];
-        for(i=0; i < NUM_AXIS - 1; i++) // End of segment in cartesian steps
-        {
-            diff = Printer::destinationSteps[i] - destinationSteps[i];
-            if(s == 1)
-                destinationSteps[i] += diff;
-            else if(s == 2)
-                destinationSteps[i] += (diff >> 1);
-            else if(s == 4)
-                destinationSteps[i] += (diff >> 2);
-            else
-                if(diff<0)
-                    destinationSteps[i] -= HAL::Div4U2U(-diff, s);
-                else
-                    destinationSteps[i] += HAL::Div4U2U(diff, s);
-        }
+        SIM_DELTA_SEGMENT_START(destinationSteps);
+        nextDeltaSegmentPosition(destinationSteps, Printer::destinationSteps, s); // End of segment in cartesian steps
+        SIM_DELTA_SEGMENT_END(destinationSteps);
         // Verify that delta calc has a solution
         if (transformCartesianStepsToDeltaSteps(destinationSteps, destinationDeltaSteps))
         {
@@ -1120,6 +1738,7 @@ inline uint16_t PrintLine::calculateDeltaSubSegments(uint8_t softEndstop)
 #endif
     return max_axis_move;
 }
+#endif
 
 uint8_t PrintLine::calculateDistance(float axisDiff[], uint8_t dir, float *distance)
 {
@@ -1202,11 +1821,46 @@ inline void PrintLine::queueEMove(long extrudeDiff,uint8_t check_endstops,uint8_
     //Define variables that are needed for the Bresenham algorithm. Please note that  Z is not currently included in the Bresenham algorithm.
     p->primaryAxis = E_AXIS;
     p->stepsRemaining = p->delta[E_AXIS];
-    p->distance = axisDiff[E_AXIS] = p->delta[E_AXIS] * Printer::invAxisStepsPerMM[E_AXIS];
-    p->moveID = lastMoveID++;
-    p->calculateMove(axisDiff,pathOptimize);
+    axisDiff[E_AXIS] = p->delta[E_AXIS] * Printer::invAxisStepsPerMM[E_AXIS];
+    p->getPlannerLine()->moveID = lastMoveID++;
+    p->calculateMove(axisDiff,pathOptimize,axisDiff[E_AXIS]);
 }
 
+#if FEATURE_DELTA_ADAPTIVE_SEGMENTS
+/**
+  Number of segments that keep every carriage within DELTA_SEGMENT_MAX_DEVIATION of the linear interpolation
+  between the segment ends, for the move from Printer::currentPositionSteps to Printer::destinationSteps.
+
+  A carriage is h = sqrt(L^2-w^2) above the effector, with rod length L and horizontal distance w to its tower.
+  Along a line of length len with horizontal length xy, the curvature of h is at most xy^2*L^2/(len^2*h^3).
+  The chord of a segment of length s then deviates at most s^2/8 times that. As w is convex along the line,
+  h is smallest at one of its ends, so these give the bound for the whole move.
+  @param distance Cartesian length of the move in mm.
+  @param xyDistance Horizontal length of the move in mm.
+  @return Number of segments or 0 if the end can not be reached.
+*/
+static int deltaSegmentsForDeviation(float distance, float xyDistance)
+{
+    long endDeltaSteps[3];
+    if(!transformCartesianStepsToDeltaSteps(Printer::destinationSteps, endDeltaSteps))
+        return 0;
+    long minHeight = endDeltaSteps[X_AXIS] - Printer::destinationSteps[Z_AXIS];
+    for(uint8_t i=0; i < NUM_AXIS - 1; i++)
+    {
+        minHeight = RMath::min(minHeight, endDeltaSteps[i] - Printer::destinationSteps[Z_AXIS]);
+        minHeight = RMath::min(minHeight, Printer::currentDeltaPositionSteps[i] - Printer::currentPositionSteps[Z_AXIS]);
+    }
+    if(minHeight <= 0)
+        return 0;
+    float height = minHeight * Printer::invAxisStepsPerMM[Z_AXIS];
+    float rodByHeight = EEPROM::deltaDiagonalRodLength() / height;
+    float segments = xyDistance * rodByHeight / sqrt(8.0 * DELTA_SEGMENT_MAX_DEVIATION * height);
+    // A segment moves a carriage at most L/h times its length, which has to fit the 16 bit steps of a segment
+    float minSegments = distance * rodByHeight * Printer::axisStepsPerMM[Z_AXIS] / 65535.0;
+    return RMath::max(1, int(RMath::max(segments, minSegments)) + 1);
+}
+#endif
+
 /**
   Split a line up into a series of lines with at most MAX_DELTA_SEGMENTS_PER_LINE delta segments.
   @param check_endstops Check endstops during the move.
@@ -1215,6 +1869,9 @@ inline void PrintLine::queueEMove(long extrudeDiff,uint8_t check_endstops,uint8_
 */
 void PrintLine::queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint8_t softEndstop)
 {
+#if FEATURE_MOVE_MERGING
+    flushMergedMove();
+#endif
     if (softEndstop && Printer::destinationSteps[Z_AXIS] < 0) Printer::destinationSteps[Z_AXIS] = 0;
     long difference[NUM_AXIS];
     float axis_diff[5]; // Axis movement in mm. Virtual axis in 4;
@@ -1266,6 +1923,11 @@ void PrintLine::queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint
         Com::printFLN(Com::tDBGDeltaSeconds, seconds);
 #endif
         segmentCount = RMath::max(1, int(float((cartesianDir & 136)==136 ? EEPROM::deltaSegmentsPerSecondPrint() : EEPROM::deltaSegmentsPerSecondMove()) * seconds));
+#if FEATURE_DELTA_ADAPTIVE_SEGMENTS
+        int adaptiveCount = deltaSegmentsForDeviation(cartesianDistance, sqrt(axis_diff[X_AXIS] * axis_diff[X_AXIS] + axis_diff[Y_AXIS] * axis_diff[Y_AXIS]));
+        if(adaptiveCount) // otherwise the move ends outside the reachable area, keep the time based count
+            segmentCount = adaptiveCount;
+#endif
         //Com::printFLN(PSTR("Segments:"),segmentCount);
     }
     else
@@ -1316,7 +1978,6 @@ void PrintLine::queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint
                 p->delta[i] = cartesianDeltaSteps[i];
                 fractional_steps[i] = difference[i];
             }
-            p->distance = cartesianDistance;
         }
         else
         {
@@ -1327,11 +1988,10 @@ void PrintLine::queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint
                 axis_diff[i] = fabs(fractional_steps[i]*Printer::invAxisStepsPerMM[i]);
             }
             calculateDirectionAndDelta(fractional_steps,&p->dir,p->delta);
-            p->distance = cartesianDistance;
         }
 
         p->joinFlags = 0;
-        p->moveID = lastMoveID;
+        p->getPlannerLine()->moveID = lastMoveID;
 
         // Only set fixed on last segment
         if (lineNumber == numLines && !pathOptimize)
@@ -1340,7 +2000,11 @@ void PrintLine::queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint
         p->flags = (check_endstops ? FLAG_CHECK_ENDSTOPS : 0);
         p->numDeltaSegments = segmentsPerLine;
 
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+        long max_delta_step = p->prepareDeltaSegments(softEndstop);
+#else
         long max_delta_step = p->calculateDeltaSubSegments(softEndstop);
+#endif
 
 #ifdef DEBUG_SPLIT
         Com::printFLN(Com::tDBGDeltaMaxDS, max_delta_step);
@@ -1365,13 +2029,17 @@ void PrintLine::queueDeltaMove(uint8_t check_endstops,uint8_t pathOptimize, uint
             // Round up the E move to get something divisible by segment count which is greater than E move
             p->numPrimaryStepPerSegment = (p->delta[E_AXIS] + segmentsPerLine - 1) / segmentsPerLine;
             p->stepsRemaining = p->numPrimaryStepPerSegment * segmentsPerLine;
+#if FEATURE_DELTA_TOWER_LIMITS
+            axis_diff[VIRTUAL_AXIS] = virtual_axis_move * Printer::invAxisStepsPerMM[0]; // Travel of the fastest tower for its limits
+#else
             axis_diff[VIRTUAL_AXIS] = p->stepsRemaining * Printer::invAxisStepsPerMM[0];
+#endif
         }
 #ifdef DEBUG_SPLIT
         Com::printFLN(Com::tDBGDeltaStepsPerSegment, p->numPrimaryStepPerSegment);
         Com::printFLN(Com::tDBGDeltaVirtualAxisSteps, p->stepsRemaining);
 #endif
-        p->calculateMove(axis_diff,pathOptimize);
+        p->calculateMove(axis_diff,pathOptimize,cartesianDistance);
         for (uint8_t i=0; i < 4; i++)
         {
             Printer::currentPositionSteps[i] += fractional_steps[i];
@@ -1563,6 +2231,9 @@ long PrintLine::bresenhamStep() // Version for delta printer
         {
             //HAL::forbidInterrupts();
             //deltaSegmentCount -= cur->numDeltaSegments; // should always be zero
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+            releaseDeltaSegments();
+#endif
             removeCurrentLineForbidInterrupt();
             if(linesCount == 0) UI_STATUS(UI_TEXT_IDLE);
             return 1000;
@@ -1590,7 +2261,12 @@ long PrintLine::bresenhamStep() // Version for delta printer
         if (cur->numDeltaSegments)
         {
             // If there are delta segments point to them here
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+            curd = nextDeltaSegment(true);
+            cur->numDeltaSegments--;
+#else
             curd = &cur->segments[--cur->numDeltaSegments];
+#endif
             // Enable axis - All axis are enabled since they will most probably all be involved in a move
             // Since segments could involve different axis this reduces load when switching segments and
             // makes disabling easier.
@@ -1600,21 +2276,14 @@ long PrintLine::bresenhamStep() // Version for delta printer
 
             // Copy across movement into main direction flags so that endstops function correctly
             cur->dir |= curd->dir;
-            // Initialize bresenham for the first segment
-            if (cur->isFullstepping())
-            {
-                cur->error[X_AXIS] = cur->error[Y_AXIS] = cur->error[Z_AXIS] = cur->numPrimaryStepPerSegment >> 1;
-                curd_errupd = cur->numPrimaryStepPerSegment;
-            }
-            else
-            {
-                cur->error[X_AXIS] = cur->error[Y_AXIS] = cur->error[Z_AXIS] = cur->numPrimaryStepPerSegment;
-                curd_errupd = cur->numPrimaryStepPerSegment = cur->numPrimaryStepPerSegment << 1;
-            }
+            // Initialize bresenham for the first segment, smoothing runs it with more timer calls per primary step
+            curd_errupd = cur->numPrimaryStepPerSegment = cur->numPrimaryStepPerSegment << cur->stepSmoothing;
+            error[X_AXIS] = error[Y_AXIS] = error[Z_AXIS] = curd_errupd >> 1;
             stepsPerSegRemaining = cur->numPrimaryStepPerSegment;
         }
         else curd = NULL;
-        cur_errupd = (cur->isFullstepping() ? cur->stepsRemaining : cur->stepsRemaining << 1);
+        cur_errupd = cur->stepsRemaining << cur->stepSmoothing;
+        error[E_AXIS] = cur_errupd >> 1;
 
         if(!cur->areParameterUpToDate())  // should never happen, but with bad timings???
         {
@@ -1627,40 +2296,36 @@ long PrintLine::bresenhamStep() // Version for delta printer
         //Determine direction of movement
         if (curd)
         {
-            Printer::setXDirection(curd->isXPositiveMove());
-            Printer::setYDirection(curd->isYPositiveMove());
-            Printer::setZDirection(curd->isZPositiveMove());
+            setXDirection(curd->isXPositiveMove());
+            setYDirection(curd->isYPositiveMove());
+            setZDirection(curd->isZPositiveMove());
         }
 #if defined(USE_ADVANCE)
         if(!Printer::isAdvanceActivated()) // Set direction if no advance/OPS enabled
 #endif
-            Extruder::setDirection(cur->isEPositiveMove());
+            setEDirection(cur->isEPositiveMove());
 #ifdef USE_ADVANCE
 #ifdef ENABLE_QUADRATIC_ADVANCE
         Printer::advanceExecuted = cur->advanceStart;
 #endif
         cur->updateAdvanceSteps(cur->vStart,0,false);
 #endif
-        if(Printer::wasLastHalfstepping && cur->isFullstepping())   // Switch halfstepping -> full stepping
-        {
-            Printer::wasLastHalfstepping = 0;
-            return Printer::interval + Printer::interval + Printer::interval; // Wait an other 150% from last half step to make the 100% full
-        }
-        else if(!Printer::wasLastHalfstepping && !cur->isFullstepping())     // Switch full to half stepping
-        {
-            Printer::wasLastHalfstepping = 1;
-        }
-        else
-            return Printer::interval; // Wait an other 50% from last step to make the 100% full
+        // Printer::interval is half a timer call of the last line. Complete the time to the first call of
+        // this line, which comes one primary step of the last line divided by 2^stepSmoothing after its last call.
+        uint8_t lastSmoothing = Printer::lastStepSmoothing;
+        Printer::lastStepSmoothing = cur->stepSmoothing;
+        if(cur->stepSmoothing <= lastSmoothing)
+            return (Printer::interval << (lastSmoothing + 1 - cur->stepSmoothing)) - Printer::interval;
+        // else one smoothing level more needs no extra wait, higher levels start a bit late
     } // End cur=0
     HAL::allowInterrupts();
 
-    /* For halfstepping, we divide the actions into even and odd actions to split
-       time used per loop. */
-    uint8_t doEven = cur->halfStep & 6;
-    uint8_t doOdd = cur->halfStep & 5;
-    if(cur->halfStep != 4) cur->halfStep = 3 - (cur->halfStep);
-    if(doEven && curd != NULL)
+    /* With step smoothing, the first timer call of a primary step updates the timing (odd) and
+       the last one counts the step (even), so the work is split over the calls. */
+    uint8_t doEven = cur->smoothingPhase == 0;
+    uint8_t doOdd = cur->smoothingPhase == cur->smoothingMask();
+    cur->smoothingPhase = (doEven ? cur->smoothingMask() : cur->smoothingPhase - 1);
+    if(doEven && curd != NULL && Printer::isEndstopCheckNeeded())
     {
         curd->checkEndstops(cur,(cur->isCheckEndstops()));
     }
@@ -1670,15 +2335,17 @@ long PrintLine::bresenhamStep() // Version for delta printer
     {
         for(uint8_t loop = 0; loop<maxLoops; loop++)
         {
+#if !FEATURE_STEP_BUFFER
             if(loop>0)
 #if STEPPER_HIGH_DELAY>0
                 HAL::delayMicroseconds(STEPPER_HIGH_DELAY+DOUBLE_STEP_DELAY);
 #else
                 HAL::delayMicroseconds(DOUBLE_STEP_DELAY);
+#endif
 #endif
             if(cur->isEMove())
             {
-                if((cur->error[E_AXIS] -= cur->delta[E_AXIS]) < 0)
+                if((error[E_AXIS] -= cur->delta[E_AXIS]) < 0)
                 {
 #if defined(USE_ADVANCE)
                     if(Printer::isAdvanceActivated())   // Use interrupt for movement
@@ -1690,19 +2357,22 @@ long PrintLine::bresenhamStep() // Version for delta printer
                     }
                     else
 #endif
-                        Extruder::step();
-                    cur->error[E_AXIS] += cur_errupd;
+                        startEStep();
+                    error[E_AXIS] += cur_errupd;
                 }
             }
+#if FEATURE_BRESENHAM_ADVANCE
+            if(Printer::isAdvanceActivated()) startAdvanceStep(); // Bresenham and advance steps of the extruder
+#endif
             if (curd)
             {
                 // Take delta steps
                 if(curd->isXMove())
                 {
-                    if((cur->error[X_AXIS] -= curd->deltaSteps[X_AXIS]) < 0)
+                    if((error[X_AXIS] -= curd->deltaSteps[X_AXIS]) < 0)
                     {
                         cur->startXStep();
-                        cur->error[X_AXIS] += curd_errupd;
+                        error[X_AXIS] += curd_errupd;
 #ifdef DEBUG_DELTA_REALPOS
                         Printer::realDeltaPositionSteps[X_AXIS] += curd->isXPositiveMove() ? 1 : -1;
 #endif
@@ -1714,10 +2384,10 @@ long PrintLine::bresenhamStep() // Version for delta printer
 
                 if(curd->isYMove())
                 {
-                    if((cur->error[Y_AXIS] -= curd->deltaSteps[Y_AXIS]) < 0)
+                    if((error[Y_AXIS] -= curd->deltaSteps[Y_AXIS]) < 0)
                     {
                         cur->startYStep();
-                        cur->error[Y_AXIS] += curd_errupd;
+                        error[Y_AXIS] += curd_errupd;
 #ifdef DEBUG_DELTA_REALPOS
                         Printer::realDeltaPositionSteps[Y_AXIS] += curd->isYPositiveMove() ? 1 : -1;
 #endif
@@ -1729,10 +2399,10 @@ long PrintLine::bresenhamStep() // Version for delta printer
 
                 if(curd->isZMove())
                 {
-                    if((cur->error[Z_AXIS] -= curd->deltaSteps[Z_AXIS]) < 0)
+                    if((error[Z_AXIS] -= curd->deltaSteps[Z_AXIS]) < 0)
                     {
                         cur->startZStep();
-                        cur->error[Z_AXIS] += curd_errupd;
+                        error[Z_AXIS] += curd_errupd;
 #ifdef DEBUG_DELTA_REALPOS
                         Printer::realDeltaPositionSteps[Z_AXIS] += curd->isZPositiveMove() ? 1 : -1;
 #endif
@@ -1741,46 +2411,74 @@ long PrintLine::bresenhamStep() // Version for delta printer
 #endif
                     }
                 }
+#if FEATURE_STEP_BUFFER
+                pushStepEvent(); // before the direction of the next segment is set
+#else
+                Printer::writeStepPort();
                 Printer::insertStepperHighDelay();
                 Printer::endXYZSteps();
+#endif
                 stepsPerSegRemaining--;
                 if (!stepsPerSegRemaining)
                 {
                     if (cur->numDeltaSegments)
                     {
                         // Get the next delta segment
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+                        curd = nextDeltaSegment(false);
+                        cur->numDeltaSegments--;
+#else
                         curd = &cur->segments[--cur->numDeltaSegments];
+#endif
 
                         // Initialize bresenham for this segment (numPrimaryStepPerSegment is already correct for the half step setting)
-                        cur->error[X_AXIS] = cur->error[Y_AXIS] = cur->error[Z_AXIS] = cur->numPrimaryStepPerSegment >> 1;
+                        error[X_AXIS] = error[Y_AXIS] = error[Z_AXIS] = cur->numPrimaryStepPerSegment >> 1;
 
                         // Reset the counter of the primary steps. This is initialized in the line
                         // generation so don't have to do this the first time.
                         stepsPerSegRemaining = cur->numPrimaryStepPerSegment;
 
                         // Change direction if necessary
-                        Printer::setXDirection(curd->dir & 1);
-                        Printer::setYDirection(curd->dir & 2);
-                        Printer::setZDirection(curd->dir & 4);
+                        setXDirection(curd->dir & 1);
+                        setYDirection(curd->dir & 2);
+                        setZDirection(curd->dir & 4);
                     }
                     else
                         curd = 0;// Release the last segment
                     //deltaSegmentCount--;
                 }
             }
-#if defined(USE_ADVANCE)
+#if FEATURE_STEP_BUFFER
+            pushStepEvent(); // extruder only moves have no delta segment
+#else
+            Printer::writeStepPort(); // extruder only moves have no delta segment
+#if defined(USE_ADVANCE) && !FEATURE_BRESENHAM_ADVANCE
             if(!Printer::isAdvanceActivated()) // Use interrupt for movement
 #endif
                 Extruder::unstep();
+#endif
         } // for loop
         if(doOdd)
         {
             HAL::allowInterrupts(); // Allow interrupts for other types, timer1 is still disabled
 #ifdef RAMP_ACCELERATION
+#if FEATURE_DEFERRED_SPEED_UPDATE
+            // If the line goes on, the speed update interrupt computes the ramp and moves the next call
+            uint8_t deferSpeedUpdate = !doEven || cur->stepsRemaining > maxLoops;
+            if (deferSpeedUpdate && cur->moveAccelerating())
+                requestSpeedUpdate(SPEED_UPDATE_ACCELERATE);
+            else if (deferSpeedUpdate && cur->moveDecelerating())
+                requestSpeedUpdate(SPEED_UPDATE_DECELERATE);
+            else
+#endif
             //If acceleration is enabled on this move and we are in the acceleration segment, calculate the current interval
             if (cur->moveAccelerating())
             {
+#if FEATURE_S_CURVE_ACCELERATION
+                Printer::vMaxReached = cur->accelRamp.speedChange(Printer::timer) + cur->vStart;
+#else
                 Printer::vMaxReached = HAL::ComputeV(Printer::timer,cur->fAcceleration) + cur->vStart;
+#endif
                 if(Printer::vMaxReached>cur->vMax) Printer::vMaxReached = cur->vMax;
                 unsigned int v = Printer::updateStepsPerTimerCall(Printer::vMaxReached);
                 Printer::interval = HAL::CPUDivU2(v);
@@ -1789,7 +2487,11 @@ long PrintLine::bresenhamStep() // Version for delta printer
             }
             else if (cur->moveDecelerating())     // time to slow down
             {
+#if FEATURE_S_CURVE_ACCELERATION
+                unsigned int v = cur->decelRamp.speedChange(Printer::timer);
+#else
                 unsigned int v = HAL::ComputeV(Printer::timer,cur->fAcceleration);
+#endif
                 if (v > Printer::vMaxReached)   // if deceleration goes too far it can become too large
                     v = cur->vEnd;
                 else
@@ -1845,7 +2547,7 @@ long PrintLine::bresenhamStep() // Version for delta printer
         }
 
     } // stepsRemaining
-    long interval = (cur->isFullstepping() ? Printer::interval : Printer::interval >> 1);
+    long interval = Printer::interval >> cur->stepSmoothing;
     if(doEven &&(cur->stepsRemaining <= 0 || cur->isNoMove()))   // line finished
     {
         // Release remaining delta segments
@@ -1855,13 +2557,18 @@ long PrintLine::bresenhamStep() // Version for delta printer
             Com::printFLN(PSTR("Missed steps:"), cur->totalStepsRemaining);
             Com::printFLN(PSTR("Step/seg r:"), stepsPerSegRemaining);
             Com::printFLN(PSTR("NDS:"), (int) cur->numDeltaSegments);
-            Com::printFLN(PSTR("HS:"), (int) cur->halfStep);
+            Com::printFLN(PSTR("SM:"), (int) cur->stepSmoothing);
         }
 #endif
         //HAL::forbidInterrupts();
         //deltaSegmentCount -= cur->numDeltaSegments; // should always be zero
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+        releaseDeltaSegments();
+#endif
         removeCurrentLineForbidInterrupt();
-        Printer::disableAllowedStepper();
+#if !FEATURE_STEP_BUFFER
+        Printer::disableAllowedStepper(); // with step buffer done by executeStepEvents
+#endif
         if(linesCount == 0) UI_STATUS(UI_TEXT_IDLE);
         interval = Printer::interval = interval >> 1; // 50% of time to next call to do cur=0
         DEBUG_MEMORY;
@@ -1945,7 +2652,8 @@ long PrintLine::bresenhamStep() // version for cartesian printer
         if(cur->isEMove()) Extruder::enable();
         cur->fixStartAndEndSpeed();
         HAL::allowInterrupts();
-        cur_errupd = (cur->isFullstepping() ? cur->delta[cur->primaryAxis] : cur->delta[cur->primaryAxis]<<1);;
+        cur_errupd = cur->delta[cur->primaryAxis] << cur->stepSmoothing;
+        error[X_AXIS] = error[Y_AXIS] = error[Z_AXIS] = error[E_AXIS] = cur_errupd >> 1;
         if(!cur->areParameterUpToDate())  // should never happen, but with bad timings???
         {
             cur->updateStepsParameter();
@@ -1956,47 +2664,43 @@ long PrintLine::bresenhamStep() // version for cartesian printer
         HAL::forbidInterrupts();
         //Determine direction of movement,check if endstop was hit
 #if !defined(XY_GANTRY)
-        Printer::setXDirection(cur->isXPositiveMove());
-        Printer::setYDirection(cur->isYPositiveMove());
+        setXDirection(cur->isXPositiveMove());
+        setYDirection(cur->isYPositiveMove());
 #else
         long gdx = (cur->dir & 1 ? cur->delta[0] : -cur->delta[0]); // Compute signed difference in steps
         long gdy = (cur->dir & 2 ? cur->delta[1] : -cur->delta[1]);
-        Printer::setXDirection(gdx+gdy>=0);
+        setXDirection(gdx+gdy>=0);
 #if DRIVE_SYSTEM==1
-        Printer::setYDirection(gdx>gdy);
+        setYDirection(gdx>gdy);
 #elif DRIVE_SYSTEM==2
-        Printer::setYDirection(gdx<=gdy);
+        setYDirection(gdx<=gdy);
 #endif
 #endif
-        Printer::setZDirection(cur->isZPositiveMove());
+        setZDirection(cur->isZPositiveMove());
 #if defined(USE_ADVANCE)
         if(!Printer::isAdvanceActivated()) // Set direction if no advance/OPS enabled
 #endif
-            Extruder::setDirection(cur->isEPositiveMove());
+            setEDirection(cur->isEPositiveMove());
 #ifdef USE_ADVANCE
 #ifdef ENABLE_QUADRATIC_ADVANCE
         Printer::advanceExecuted = cur->advanceStart;
 #endif
         cur->updateAdvanceSteps(cur->vStart,0,false);
 #endif
-        if(Printer::wasLastHalfstepping && cur->isFullstepping())   // Switch halfstepping -> full stepping
-        {
-            Printer::wasLastHalfstepping = 0;
-            return Printer::interval+Printer::interval+Printer::interval; // Wait an other 150% from last half step to make the 100% full
-        }
-        else if(!Printer::wasLastHalfstepping && !cur->isFullstepping())     // Switch full to half stepping
-        {
-            Printer::wasLastHalfstepping = 1;
-        }
-        else
-            return Printer::interval; // Wait an other 50% from last step to make the 100% full
+        // Printer::interval is half a timer call of the last line. Complete the time to the first call of
+        // this line, which comes one primary step of the last line divided by 2^stepSmoothing after its last call.
+        uint8_t lastSmoothing = Printer::lastStepSmoothing;
+        Printer::lastStepSmoothing = cur->stepSmoothing;
+        if(cur->stepSmoothing <= lastSmoothing)
+            return (Printer::interval << (lastSmoothing + 1 - cur->stepSmoothing)) - Printer::interval;
+        // else one smoothing level more needs no extra wait, higher levels start a bit late
     } // End cur=0
     HAL::allowInterrupts();
-    /* For halfstepping, we divide the actions into even and odd actions to split
-       time used per loop. */
-    uint8_t doEven = cur->halfStep & 6;
-    uint8_t doOdd = cur->halfStep & 5;
-    if(cur->halfStep!=4) cur->halfStep = 3-(cur->halfStep);
+    /* With step smoothing, the first timer call of a primary step updates the timing (odd) and
+       the last one counts the step (even), so the work is split over the calls. */
+    uint8_t doEven = cur->smoothingPhase == 0;
+    uint8_t doOdd = cur->smoothingPhase == cur->smoothingMask();
+    cur->smoothingPhase = (doEven ? cur->smoothingMask() : cur->smoothingPhase - 1);
     HAL::forbidInterrupts();
     if(doEven) cur->checkEndstops();
     uint8_t max_loops = RMath::min((long)Printer::stepsPerTimerCall,cur->stepsRemaining);
@@ -2005,11 +2709,13 @@ long PrintLine::bresenhamStep() // version for cartesian printer
         for(uint8_t loop=0; loop<max_loops; loop++)
         {
             ANALYZER_ON(ANALYZER_CH1);
+#if !FEATURE_STEP_BUFFER
             if(loop>0)
                 HAL::delayMicroseconds(STEPPER_HIGH_DELAY+DOUBLE_STEP_DELAY);
+#endif
             if(cur->isEMove())
             {
-                if((cur->error[E_AXIS] -= cur->delta[E_AXIS]) < 0)
+                if((error[E_AXIS] -= cur->delta[E_AXIS]) < 0)
                 {
 #if defined(USE_ADVANCE)
                     if(Printer::isAdvanceActivated())   // Use interrupt for movement
@@ -2021,24 +2727,27 @@ long PrintLine::bresenhamStep() // version for cartesian printer
                     }
                     else
 #endif
-                        Extruder::step();
-                    cur->error[E_AXIS] += cur_errupd;
+                        startEStep();
+                    error[E_AXIS] += cur_errupd;
                 }
             }
+#if FEATURE_BRESENHAM_ADVANCE
+            if(Printer::isAdvanceActivated()) startAdvanceStep(); // Bresenham and advance steps of the extruder
+#endif
             if(cur->isXMove())
             {
-                if((cur->error[X_AXIS] -= cur->delta[X_AXIS]) < 0)
+                if((error[X_AXIS] -= cur->delta[X_AXIS]) < 0)
                 {
                     cur->startXStep();
-                    cur->error[X_AXIS] += cur_errupd;
+                    error[X_AXIS] += cur_errupd;
                 }
             }
             if(cur->isYMove())
             {
-                if((cur->error[Y_AXIS] -= cur->delta[Y_AXIS]) < 0)
+                if((error[Y_AXIS] -= cur->delta[Y_AXIS]) < 0)
                 {
                     cur->startYStep();
-                    cur->error[Y_AXIS] += cur_errupd;
+                    error[Y_AXIS] += cur_errupd;
                 }
             }
 #if defined(XY_GANTRY)
@@ -2047,30 +2756,48 @@ long PrintLine::bresenhamStep() // version for cartesian printer
 
             if(cur->isZMove())
             {
-                if((cur->error[Z_AXIS] -= cur->delta[Z_AXIS]) < 0)
+                if((error[Z_AXIS] -= cur->delta[Z_AXIS]) < 0)
                 {
                     cur->startZStep();
-                    cur->error[Z_AXIS] += cur_errupd;
+                    error[Z_AXIS] += cur_errupd;
 #ifdef DEBUG_STEPCOUNT
                     cur->totalStepsRemaining--;
 #endif
                 }
             }
+#if FEATURE_STEP_BUFFER
+            pushStepEvent();
+#else
+            Printer::writeStepPort();
             Printer::insertStepperHighDelay();
-#if defined(USE_ADVANCE)
+#if defined(USE_ADVANCE) && !FEATURE_BRESENHAM_ADVANCE
             if(!Printer::isAdvanceActivated()) // Use interrupt for movement
 #endif
                 Extruder::unstep();
             Printer::endXYZSteps();
+#endif
         } // for loop
         if(doOdd)  // Update timings
         {
             HAL::allowInterrupts(); // Allow interrupts for other types, timer1 is still disabled
 #ifdef RAMP_ACCELERATION
+#if FEATURE_DEFERRED_SPEED_UPDATE
+            // If the line goes on, the speed update interrupt computes the ramp and moves the next call
+            uint8_t deferSpeedUpdate = !doEven || cur->stepsRemaining > max_loops;
+            if (deferSpeedUpdate && cur->moveAccelerating())
+                requestSpeedUpdate(SPEED_UPDATE_ACCELERATE);
+            else if (deferSpeedUpdate && cur->moveDecelerating())
+                requestSpeedUpdate(SPEED_UPDATE_DECELERATE);
+            else
+#endif
             //If acceleration is enabled on this move and we are in the acceleration segment, calculate the current interval
             if (cur->moveAccelerating())   // we are accelerating
             {
+#if FEATURE_S_CURVE_ACCELERATION
+                Printer::vMaxReached = cur->accelRamp.speedChange(Printer::timer) + cur->vStart;
+#else
                 Printer::vMaxReached = HAL::ComputeV(Printer::timer,cur->fAcceleration)+cur->vStart;
+#endif
                 if(Printer::vMaxReached>cur->vMax) Printer::vMaxReached = cur->vMax;
                 unsigned int v = Printer::updateStepsPerTimerCall(Printer::vMaxReached);
                 Printer::interval = HAL::CPUDivU2(v);
@@ -2079,7 +2806,11 @@ long PrintLine::bresenhamStep() // version for cartesian printer
             }
             else if (cur->moveDecelerating())     // time to slow down
             {
+#if FEATURE_S_CURVE_ACCELERATION
+                unsigned int v = cur->decelRamp.speedChange(Printer::timer);
+#else
                 unsigned int v = HAL::ComputeV(Printer::timer,cur->fAcceleration);
+#endif
                 if (v > Printer::vMaxReached)   // if deceleration goes too far it can become too large
                     v = cur->vEnd;
                 else
@@ -2132,9 +2863,7 @@ long PrintLine::bresenhamStep() // version for cartesian printer
         }
 
     } // stepsRemaining
-    long interval;
-    if(!cur->isFullstepping()) interval = (Printer::interval>>1); // time to come back
-    else interval = Printer::interval;
+    long interval = Printer::interval >> cur->stepSmoothing; // time to come back
     if(doEven && (cur->stepsRemaining <= 0 || cur->isNoMove()))   // line finished
     {
 #ifdef DEBUG_STEPCOUNT
@@ -2145,7 +2874,9 @@ long PrintLine::bresenhamStep() // version for cartesian printer
         }
 #endif
         removeCurrentLineForbidInterrupt();
-        Printer::disableAllowedStepper();
+#if !FEATURE_STEP_BUFFER
+        Printer::disableAllowedStepper(); // with step buffer done by executeStepEvents
+#endif
         if(linesCount == 0) UI_STATUS(UI_TEXT_IDLE);
         interval = Printer::interval = interval >> 1; // 50% of time to next call to do cur=0
         DEBUG_MEMORY;
@@ -2153,3 +2884,181 @@ long PrintLine::bresenhamStep() // version for cartesian printer
     return interval;
 }
 #endif
+#if FEATURE_DEFERRED_SPEED_UPDATE
+volatile uint8_t PrintLine::speedUpdateRequest = 0;
+uint8_t PrintLine::speedUpdateMode = SPEED_UPDATE_ACCELERATE;
+/**
+  Computes the speed requested by bresenhamStep in the speed update interrupt, which the stepper
+  interrupt can interrupt. The ramp is computed with interrupts enabled and only stored if no newer
+  request came in and the line is still running. Then the pending stepper timer call is moved to the
+  new interval, so the steps come at the same time as with the update inside bresenhamStep.
+*/
+void PrintLine::deferredSpeedUpdate()
+{
+    PrintLine *line;
+    uint8_t request,mode;
+    unsigned long timer;
+    unsigned int vMaxReached;
+    BEGIN_INTERRUPT_PROTECTED
+    line = cur;
+    request = speedUpdateRequest;
+    mode = speedUpdateMode;
+    timer = Printer::timer;
+    vMaxReached = Printer::vMaxReached;
+    END_INTERRUPT_PROTECTED
+    if(line == NULL) return;
+    unsigned int v;
+    if(mode == SPEED_UPDATE_ACCELERATE)
+    {
+#if FEATURE_S_CURVE_ACCELERATION
+        v = line->accelRamp.speedChange(timer) + line->vStart;
+#else
+        v = HAL::ComputeV(timer,line->fAcceleration) + line->vStart;
+#endif
+        if(v > line->vMax) v = line->vMax;
+        vMaxReached = v;
+    }
+    else
+    {
+#if FEATURE_S_CURVE_ACCELERATION
+        v = line->decelRamp.speedChange(timer);
+#else
+        v = HAL::ComputeV(timer,line->fAcceleration);
+#endif
+        if (v > vMaxReached)   // if deceleration goes too far it can become too large
+            v = line->vEnd;
+        else
+        {
+            v = vMaxReached - v;
+            if (v < line->vEnd) v = line->vEnd; // extra steps at the end of desceleration due to rounding erros
+        }
+    }
+    BEGIN_INTERRUPT_PROTECTED
+    if(request != speedUpdateRequest || line != cur)
+    {
+        SIM_COUNT(speedUpdatesDropped); // a newer request computes it again
+        ESCAPE_INTERRUPT_PROTECTED
+        return;
+    }
+    Printer::vMaxReached = vMaxReached;
+    v = Printer::updateStepsPerTimerCall(v);
+    Printer::interval = HAL::CPUDivU2(v);
+    Printer::timer += Printer::interval;
+    HAL::moveStepperTimer(Printer::interval >> line->stepSmoothing);
+    END_INTERRUPT_PROTECTED
+}
+#endif
+#if FEATURE_STEP_BUFFER
+/**
+  Computes step events ahead of time by running bresenhamStep outside the stepper interrupt.
+
+  The function stops if the buffer is full, no line is ready or the next line checks endstops.
+  Lines checking endstops are computed one timer call at a time, after the buffer has run empty,
+  so the endstop test stays synchronous with the steps executed.
+*/
+void PrintLine::fillStepBuffer()
+{
+    if(stepBufferFilling) return;
+    stepBufferFilling = 1;
+    while(linesCount && stepEventsQueued() < STEP_BUFFER_SIZE - 5)
+    {
+        if(stepEventsQueued() && (lines[linesPos].isCheckEndstops() || Printer::isZProbingActive()))
+            break;
+        uint8_t pos = linesPos;
+        long wait = bresenhamStep();
+        HAL::allowInterrupts();
+        if(cur == NULL && pos == linesPos) break; // line not ready, try again later
+        stepEventTicks += wait;
+    }
+    stepBufferFilling = 0;
+}
+
+/** Sets the direction pins that differ from the directions in dirs. */
+static inline void setStepEventDirections(uint8_t dirs)
+{
+    uint8_t changed = dirs ^ PrintLine::stepEventPinDirs;
+    if(!changed) return;
+    if(changed & STEP_EVENT_X) Printer::setXDirection(dirs & STEP_EVENT_X);
+    if(changed & STEP_EVENT_Y) Printer::setYDirection(dirs & STEP_EVENT_Y);
+    if(changed & STEP_EVENT_Z) Printer::setZDirection(dirs & STEP_EVENT_Z);
+    if(changed & STEP_EVENT_E) Extruder::setDirection(dirs & STEP_EVENT_E);
+    PrintLine::stepEventPinDirs = dirs;
+}
+
+/**
+  Executes the next step events. Called by the stepper interrupt instead of bresenhamStep.
+
+  Events following with zero ticks are the double and quad steps of one timer call
+  and are executed directly with the usual DOUBLE_STEP_DELAY.
+  Returns the timer ticks until the next call.
+*/
+long PrintLine::executeStepEvents()
+{
+    if(stepEventsRead == stepEventsWrite)
+    {
+        stepEventIdle += STEP_EVENT_POLL_TICKS;
+        return STEP_EVENT_POLL_TICKS;
+    }
+    StepEvent *ev = &stepEvents[stepEventsRead];
+    if(stepEventIdle)   // Buffer ran empty, continue at the computed time
+    {
+        if(stepEventIdle < ev->ticks)
+        {
+            ticks_t wait = ev->ticks - stepEventIdle;
+            stepEventIdle = 0;
+            return wait;
+        }
+        stepEventIdle = 0;
+    }
+    uint8_t first = 1;
+    do
+    {
+        if(!first)
+            HAL::delayMicroseconds(STEPPER_HIGH_DELAY+DOUBLE_STEP_DELAY);
+        first = 0;
+        setStepEventDirections(ev->dirs);
+        uint8_t steps = ev->steps;
+#if FEATURE_STEP_PORT_MASKS && NUM_EXTRUDER==1
+        if(steps & STEP_EVENT_E) START_STEP_PIN(EXT0_STEP_PIN);
+#else
+        if(steps & STEP_EVENT_E) Extruder::step();
+#endif
+        if(steps & STEP_EVENT_X)
+        {
+            START_STEP_PIN(X_STEP_PIN);
+#if FEATURE_TWO_XSTEPPER
+            START_STEP_PIN(X2_STEP_PIN);
+#endif
+        }
+        if(steps & STEP_EVENT_Y)
+        {
+            START_STEP_PIN(Y_STEP_PIN);
+#if FEATURE_TWO_YSTEPPER
+            START_STEP_PIN(Y2_STEP_PIN);
+#endif
+        }
+        if(steps & STEP_EVENT_Z)
+        {
+            START_STEP_PIN(Z_STEP_PIN);
+#if FEATURE_TWO_ZSTEPPER
+            START_STEP_PIN(Z2_STEP_PIN);
+#endif
+        }
+        Printer::writeStepPort();
+        Printer::insertStepperHighDelay();
+        if(steps & STEP_EVENT_E) Extruder::unstep();
+        Printer::endXYZSteps();
+        stepEventsRead = (stepEventsRead + 1) & (STEP_BUFFER_SIZE - 1);
+        ev = &stepEvents[stepEventsRead];
+    }
+    while(stepEventsRead != stepEventsWrite && ev->ticks == 0);
+    if(stepEventsRead == stepEventsWrite)
+    {
+        if(linesCount == 0) Printer::disableAllowedStepper();
+        stepEventIdle = STEP_EVENT_POLL_TICKS;
+        return STEP_EVENT_POLL_TICKS;
+    }
+    setStepEventDirections(ev->dirs); // gives the drivers the full interval as direction setup time
+    return ev->ticks;
+}
+#endif
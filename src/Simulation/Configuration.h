@@ -0,0 +1,38 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIM_CONFIGURATION_H
+#define SIM_CONFIGURATION_H
+
+/* The simulation uses the configuration of the firmware it is build from. The
+Makefile copies it as FirmwareConfiguration.h. Only features that need hardware
+the simulation does not have are switched off here. */
+
+#include "FirmwareConfiguration.h"
+
+// No display, keys or sd card
+#undef FEATURE_CONTROLLER
+#define FEATURE_CONTROLLER 0
+#undef SDSUPPORT
+#define SDSUPPORT false
+#undef FEATURE_WATCHDOG
+#define FEATURE_WATCHDOG false
+// Heaters are not simulated, so allow extrusion at any temperature
+#undef MIN_EXTRUDER_TEMP
+#define MIN_EXTRUDER_TEMP 0
+
+#endif
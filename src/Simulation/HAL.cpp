@@ -0,0 +1,300 @@
+#include "Repetier.h"
+
+HAL::HAL()
+{
+    //ctor
+}
+
+HAL::~HAL()
+{
+    //dtor
+}
+
+uint16_t HAL::integerSqrt(long a)
+{
+    // Same rounding as the avr assembler version: nearest integer, 0.5 rounds up
+    unsigned long op = a, res = 0, one = 1UL << 30;
+    while(one > op) one >>= 2;
+    while(one != 0)
+    {
+        if(op >= res + one)
+        {
+            op -= res + one;
+            res += one << 1;
+        }
+        res >>= 1;
+        one >>= 2;
+    }
+    if(op > res) res++;
+    return res;
+}
+
+/** Interval tables of the AVR HAL, see ArduinoAVR/Repetier/HAL.cpp. */
+static uint16_t fast_div_lut[17];
+static uint16_t slow_div_lut[257];
+
+static struct DivisionTables
+{
+    DivisionTables()
+    {
+        fast_div_lut[0] = slow_div_lut[0] = 0;
+        for(int i=1; i<17; i++)
+            fast_div_lut[i] = F_CPU/(4096L*i);
+        for(int i=1; i<257; i++)
+            slow_div_lut[i] = (i < 8 ? 0 : F_CPU/(32L*i));
+    }
+} divisionTables;
+
+/** Same approximation as the AVR version, so the simulated step timing matches. */
+long HAL::CPUDivU2(unsigned int divisor)
+{
+    if(divisor<512)
+    {
+        Simulation::intervalDivisions++;
+        if(divisor<10) divisor = 10;
+        return Div4U2U(F_CPU,divisor);
+    }
+    Simulation::intervalLookups++;
+    if(divisor<8192)
+    {
+        const uint16_t *adr0 = &slow_div_lut[divisor>>5];
+        uint16_t y0 = adr0[0];
+        uint16_t gain = y0-adr0[1];
+        return (uint16_t)(y0-((gain*(divisor & 31))>>5));
+    }
+    const uint16_t *adr0 = &fast_div_lut[divisor>>12];
+    uint16_t y0 = adr0[0];
+    uint16_t gain = y0-adr0[1];
+    return (uint16_t)(y0-(((long)gain*(divisor & 4095))>>12));
+}
+
+void HAL::setupTimer()
+{
+    Simulation::timer1Next = Simulation::clock + 65500; //start off with a slow frequency.
+    Simulation::pwmNext = Simulation::clock + 64*64;
+#if !FEATURE_BRESENHAM_ADVANCE // the stepper interrupt executes the advance steps
+    Simulation::extruderNext = Simulation::clock + 256*64;
+#endif
+}
+
+void HAL::showStartReason()
+{
+    Com::printInfoFLN(Com::tPowerUp);
+}
+
+int HAL::getFreeRam()
+{
+    return MAX_RAM;
+}
+
+void HAL::resetHardware()
+{
+    Simulation::report();
+    exit(0);
+}
+
+#if FEATURE_ENDSTOP_INTERRUPTS
+// The endstop pins never change in the simulation, so no interrupt is ever raised
+bool HAL::attachEndstopInterrupt(uint8_t pin)
+{
+    return true;
+}
+#endif
+
+void HAL::analogStart()
+{
+#if ANALOG_INPUTS>0
+    // No heater model, the sensors read a constant value
+    for(uint8_t i=0; i<ANALOG_INPUTS; i++)
+    {
+        osAnalogInputCounter[i] = 0;
+        osAnalogInputBuildup[i] = 0;
+        osAnalogInputValues[i] = 2048;
+    }
+#endif
+}
+
+#if FEATURE_SERVO
+unsigned int HAL::servoTimings[4] = {0,0,0,0};
+void HAL::servoMicroseconds(uint8_t servo,int ms)
+{
+    if(ms<500) ms = 0;
+    if(ms>2500) ms = 2500;
+    servoTimings[servo] = (unsigned int)(((F_CPU/1000000)*(long)ms)>>3);
+}
+#endif
+
+// ================== Interrupt handling ======================
+
+volatile uint8_t insideTimer1 = 0;
+/** \brief Emulation of the timer 1 interrupt routine driving the stepper motors.
+
+Follows ISR(TIMER1_COMPA_vect) of the avr version. Instead of setting OCR1A,
+the time of the next call is stored in Simulation::timer1Next.
+*/
+void Simulation::timer1Interrupt()
+{
+    if(insideTimer1) return;
+    insideTimer1 = 1;
+    uint64_t start = hostNanos();
+    if(PrintLine::hasLines())
+    {
+        if(!moving)
+        {
+            moving = true;
+            if(firstMove == 0) firstMove = timer1Next;
+            if(stalled)
+            {
+                stallTime += timer1Next-lastMove;
+                stalled = false;
+            }
+        }
+#if FEATURE_STEP_BUFFER
+        unsigned long delay = PrintLine::executeStepEvents();
+#else
+        unsigned long delay = PrintLine::bresenhamStep();
+#endif
+#if defined(USE_ADVANCE)
+        if(abs(Printer::extruderStepsNeeded) > advancePendingMax) advancePendingMax = abs(Printer::extruderStepsNeeded);
+#endif
+#if FEATURE_ISR_PROFILER
+        uint32_t latency = clock - timer1Next;
+        if(delay < latency + 100) // the next call is requested for a time already passed
+            Commands::stepperProfile.late++;
+        Commands::stepperProfile.add((hostNanos() - start) * ISR_PROFILER_TICKS_PER_US / 1000,latency);
+#endif
+        if(delay < 100) delay = 100; // same minimum as setTimer
+        timer1Last = timer1Next;
+        timer1Next += delay;
+    }
+    else
+    {
+        if(moving)
+        {
+            moving = false;
+            lastMove = timer1Next;
+            if(!serial.finished())
+            {
+                underruns++;
+                stalled = true;
+            }
+        }
+        if(waitRelax == 0)
+        {
+#ifdef USE_ADVANCE
+            if(Printer::advanceStepsSet)
+            {
+                Printer::extruderStepsNeeded -= Printer::advanceStepsSet;
+#ifdef ENABLE_QUADRATIC_ADVANCE
+                Printer::advanceExecuted = 0;
+#endif
+                Printer::advanceStepsSet = 0;
+            }
+#endif
+#if defined(USE_ADVANCE)
+            if(!Printer::extruderStepsNeeded) if(DISABLE_E) Extruder::disableCurrentExtruderMotor();
+#else
+            if(DISABLE_E) Extruder::disableCurrentExtruderMotor();
+#endif
+        }
+        else waitRelax--;
+#if FEATURE_BRESENHAM_ADVANCE
+        unsigned int advanceWait = PrintLine::idleAdvanceStep();
+        timer1Next += (advanceWait ? advanceWait : 65500);
+#else
+        timer1Next += 65500; // Wait for next move
+#endif
+    }
+    uint64_t duration = hostNanos() - start;
+    isrTime += duration;
+    if(duration > isrMax) isrMax = duration;
+    isrCalls++;
+    hostExcluded += duration;
+    if(isrLog && moving)
+        fprintf(isrLog,"%llu T %llu\n",(unsigned long long)clock,(unsigned long long)duration);
+    insideTimer1 = 0;
+}
+
+/**
+Emulation of the pwm timer, called 3906 timer per second. Only the periodical
+counter is needed, heaters and analog inputs are not simulated.
+*/
+void Simulation::pwmInterrupt()
+{
+#if FEATURE_ISR_PROFILER
+    uint64_t start = hostNanos();
+    uint32_t latency = clock - pwmNext;
+#endif
+    pwmNext += 64*64;
+    counterPeriodical++; // Appxoimate a 100ms timer
+    if(counterPeriodical>=(int)(F_CPU/40960))
+    {
+        counterPeriodical=0;
+        executePeriodical=1;
+    }
+#if FEATURE_ISR_PROFILER
+    Commands::pwmProfile.add((hostNanos() - start) * ISR_PROFILER_TICKS_PER_US / 1000,latency);
+#endif
+}
+
+#if FEATURE_DEFERRED_SPEED_UPDATE
+/**
+Emulation of the speed update interrupt. It is raised by the stepper interrupt and runs
+right after it, before the next timer interrupt.
+*/
+void Simulation::speedUpdateInterrupt()
+{
+    speedUpdatePending = 0;
+    uint64_t start = hostNanos();
+    PrintLine::deferredSpeedUpdate();
+    uint64_t duration = hostNanos() - start;
+    speedUpdateTime += duration;
+    if(duration > speedUpdateMax) speedUpdateMax = duration;
+    speedUpdates++;
+    hostExcluded += duration;
+    if(isrLog)
+        fprintf(isrLog,"%llu S %llu\n",(unsigned long long)clock,(unsigned long long)duration);
+}
+
+/** Moves the pending stepper interrupt to wait ticks after the last one. */
+void HAL::moveStepperTimer(unsigned long wait)
+{
+    if(wait < 100) wait = 100; // same minimum as setTimer
+    Simulation::timer1Next = Simulation::timer1Last + wait;
+}
+#endif
+
+/** \brief Emulation of the extruder timer routine for advance.
+*/
+void Simulation::extruderInterrupt()
+{
+    static int8_t extruderLastDirection = 0;
+    uint16_t timer = 0;
+#if defined(USE_ADVANCE)
+    if(Printer::isAdvanceActivated())
+    {
+        extruderCalls++;
+        if(Printer::extruderStepsNeeded > 0 && extruderLastDirection!=1)
+        {
+            Extruder::setDirection(true);
+            extruderLastDirection = 1;
+            timer += 40; // Add some more wait time to prevent blocking
+        }
+        else if(Printer::extruderStepsNeeded < 0 && extruderLastDirection!=-1)
+        {
+            Extruder::setDirection(false);
+            extruderLastDirection = -1;
+            timer += 40; // Add some more wait time to prevent blocking
+        }
+        else if(Printer::extruderStepsNeeded != 0)
+        {
+            Extruder::step();
+            Printer::extruderStepsNeeded -= extruderLastDirection;
+            Printer::insertStepperHighDelay();
+            Extruder::unstep();
+        }
+    }
+    timer = (uint8_t)(timer + Printer::maxExtruderSpeed);
+#endif
+    extruderNext += (timer ? timer : 256) * TIMER0_PRESCALE;
+}
@@ -0,0 +1,357 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+
+    This firmware is a nearly complete rewrite of the sprinter firmware
+    by kliment (https://github.com/kliment/Sprinter)
+    which based on Tonokip RepRap firmware rewrite based off of Hydra-mmm firmware.
+*/
+
+#ifndef HAL_H
+#define HAL_H
+
+/**
+  Hardware Abstraction Layer for the host simulation.
+
+  This HAL compiles the hardware independent firmware files for the host computer.
+  It emulates an AVR running at F_CPU: Timer 1 drives PrintLine::bresenhamStep,
+  the pwm timer sets executePeriodical and the extruder timer handles advance.
+  There is no real concurrency. The interrupt routines are called, whenever the
+  main loop polls the clock or the serial port and the virtual clock has passed
+  the next compare value. All state of the emulation lives in class Simulation.
+*/
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Print.h"
+#include "Arduino.h"
+#include "Simulation.h"
+
+#define PROGMEM
+#define PGM_P const char *
+typedef char prog_char;
+#define PSTR(s) s
+#define pgm_read_byte_near(x) (*(uint8_t*)(x))
+#define pgm_read_byte(x) (*(uint8_t*)(x))
+// Pointer tables are read with pgm_read_word, which only works if the native type is used
+#define pgm_read_word(addr) (*(addr))
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#define pgm_read_dword(addr) (*(addr))
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define pgm_read_float(addr) (*(const float *)(addr))
+
+#define PACK __attribute__ ((packed))
+
+#define FSTRINGVALUE(var,value) const char var[] PROGMEM = value;
+#define FSTRINGVAR(var) static const char var[] PROGMEM;
+#define FSTRINGPARAM(var) PGM_P var
+
+/** \brief Prescale factor, timer0 runs at. */
+#define TIMER0_PRESCALE 64
+
+#define ANALOG_PRESCALER 0
+
+#define	READ(IO) Simulation::readPin(IO)
+#define	WRITE(IO,v) Simulation::writePin(IO,v)
+#define PULLUP(IO,v) {}
+#define TOGGLE(IO) Simulation::writePin(IO,!Simulation::readPin(IO))
+#define	SET_INPUT(IO) {}
+#define	SET_OUTPUT(IO) {}
+/* Step port for FEATURE_STEP_PORT_MASKS, chosen like the AVR HAL from the ATmega2560 pin mapping. */
+#define STEP_PORT_MASK(IO) Simulation::stepPortMask(IO)
+#define STEP_PORT_SET(mask) Simulation::writeStepPort(mask,1)
+#define STEP_PORT_CLEAR(mask) Simulation::writeStepPort(mask,0)
+typedef uint8_t step_port_t;
+
+#define BEGIN_INTERRUPT_PROTECTED {uint8_t sreg=Simulation::interruptsEnabled;Simulation::interruptsEnabled=0;
+#define END_INTERRUPT_PROTECTED Simulation::interruptsEnabled=sreg;}
+#define ESCAPE_INTERRUPT_PROTECTED Simulation::interruptsEnabled=sreg;
+// FEATURE_ISR_PROFILER measures host time converted to cpu cycles, latencies in virtual time
+#define ISR_PROFILER_TICKS_PER_US (F_CPU/1000000)
+// FEATURE_DEFERRED_SPEED_UPDATE runs the speed update interrupt right after the stepper interrupt
+#define HAL_SPEED_UPDATE_INTERRUPT
+
+#define EEPROM_OFFSET               0
+#define SECONDS_TO_TICKS(s) (unsigned long)(s*(float)F_CPU)
+#define ANALOG_REDUCE_BITS 0
+#define ANALOG_REDUCE_FACTOR 1
+
+#define MAX_RAM 32767
+
+#define bit_clear(x,y) x&= ~(1<<y) //cbi(x,y)
+#define bit_set(x,y)   x|= (1<<y)//sbi(x,y)
+
+/** defines the data direction (reading from I2C device) in i2cStart(),i2cRepStart() */
+#define I2C_READ    1
+/** defines the data direction (writing to I2C device) in i2cStart(),i2cRepStart() */
+#define I2C_WRITE   0
+
+typedef unsigned int speed_t;
+typedef unsigned long ticks_t;
+typedef unsigned long millis_t;
+
+#define SERIAL_BUFFER_SIZE 128
+#define SERIAL_BUFFER_MASK 127
+
+#define RFSERIAL Simulation::serial
+#define WAIT_OUT_EMPTY {}
+
+#define OUT_P_I(p,i) Com::printF(PSTR(p),(int)(i))
+#define OUT_P_I_LN(p,i) Com::printFLN(PSTR(p),(int)(i))
+#define OUT_P_L(p,i) Com::printF(PSTR(p),(long)(i))
+#define OUT_P_L_LN(p,i) Com::printFLN(PSTR(p),(long)(i))
+#define OUT_P_F(p,i) Com::printF(PSTR(p),(float)(i))
+#define OUT_P_F_LN(p,i) Com::printFLN(PSTR(p),(float)(i))
+#define OUT_P_FX(p,i,x) Com::printF(PSTR(p),(float)(i),x)
+#define OUT_P_FX_LN(p,i,x) Com::printFLN(PSTR(p),(float)(i),x)
+#define OUT_P(p) Com::printF(PSTR(p))
+#define OUT_P_LN(p) Com::printFLN(PSTR(p))
+#define OUT_ERROR_P(p) Com::printErrorF(PSTR(p))
+#define OUT_ERROR_P_LN(p) {Com::printErrorF(PSTR(p));Com::println();}
+#define OUT(v) Com::print(v)
+#define OUT_LN Com::println()
+
+/** Lets the virtual time pass in busy loops of the firmware. */
+#define SIM_POLL Simulation::poll()
+/** Measures host time spent between the two macros and adds it to the named
+probe of the simulation statistics. */
+#define SIM_PROBE_START(p) Simulation::probeStart(Simulation::p)
+#define SIM_PROBE_END(p) Simulation::probeEnd(Simulation::p)
+/** Increments the named counter of the simulation statistics. */
+#define SIM_COUNT(c) Simulation::c++
+/** Measures how far the carriages deviate from the linear interpolation of a delta segment. */
+#define SIM_DELTA_SEGMENT_START(p) Simulation::deltaSegmentStart(p)
+#define SIM_DELTA_SEGMENT_END(p) Simulation::deltaSegmentEnd(p)
+/** Checks the acceleration of the speed ramps. */
+#define SIM_RAMP_SPEED(v) Simulation::rampSpeed(v)
+
+class HAL
+{
+public:
+    HAL();
+    virtual ~HAL();
+    static inline void hwSetup(void)
+    {}
+    // return val'val
+    static uint16_t integerSqrt(long a);
+    static inline long Div4U2U(unsigned long a,unsigned int b)
+    {
+        return a/b;
+    }
+    static inline unsigned long U16SquaredToU32(unsigned int val)
+    {
+        return (unsigned long)val*(unsigned long)val;
+    }
+    static inline unsigned int ComputeV(long timer,long accel)
+    {
+        return ((timer>>8)*accel)>>10;
+    }
+// Multiply two 16 bit values and return 32 bit result
+    static inline unsigned long mulu16xu16to32(unsigned int a,unsigned int b)
+    {
+        return (unsigned long)a*(unsigned long)b;
+    }
+// Multiply two 16 bit values and return 32 bit result
+    static inline unsigned int mulu6xu16shift16(unsigned int a,unsigned int b)
+    {
+        return ((unsigned long)a*(unsigned long)b)>>16;
+    }
+    static inline void digitalWrite(uint8_t pin,uint8_t value)
+    {
+        Simulation::writePin(pin,value);
+    }
+    static inline uint8_t digitalRead(uint8_t pin)
+    {
+        return Simulation::readPin(pin);
+    }
+    static inline void pinMode(uint8_t pin,uint8_t mode)
+    {
+    }
+    static long CPUDivU2(unsigned int divisor);
+    static inline void delayMicroseconds(unsigned int delayUs)
+    {
+        Simulation::delay((uint64_t)delayUs*(F_CPU/1000000));
+    }
+    static inline void delayMilliseconds(unsigned int delayMs)
+    {
+        Simulation::delay((uint64_t)delayMs*(F_CPU/1000));
+    }
+    static inline void tone(uint8_t pin,int duration)
+    {
+    }
+    static inline void noTone(uint8_t pin)
+    {
+    }
+    static inline void eprSetByte(unsigned int pos,uint8_t value)
+    {
+        Simulation::eeprom[EEPROM_OFFSET+pos] = value;
+    }
+    static inline void eprSetInt16(unsigned int pos,int16_t value)
+    {
+        memcpy(&Simulation::eeprom[EEPROM_OFFSET+pos],&value,2);
+    }
+    static inline void eprSetInt32(unsigned int pos,int32_t value)
+    {
+        memcpy(&Simulation::eeprom[EEPROM_OFFSET+pos],&value,4);
+    }
+    static inline void eprSetFloat(unsigned int pos,float value)
+    {
+        memcpy(&Simulation::eeprom[EEPROM_OFFSET+pos],&value,4);
+    }
+    static inline uint8_t eprGetByte(unsigned int pos)
+    {
+        return Simulation::eeprom[EEPROM_OFFSET+pos];
+    }
+    static inline int16_t eprGetInt16(unsigned int pos)
+    {
+        int16_t v;
+        memcpy(&v,&Simulation::eeprom[EEPROM_OFFSET+pos],2);
+        return v;
+    }
+    static inline int32_t eprGetInt32(unsigned int pos)
+    {
+        int32_t v;
+        memcpy(&v,&Simulation::eeprom[EEPROM_OFFSET+pos],4);
+        return v;
+    }
+    static inline float eprGetFloat(unsigned int pos)
+    {
+        float v;
+        memcpy(&v,&Simulation::eeprom[EEPROM_OFFSET+pos],4);
+        return v;
+    }
+    static inline void allowInterrupts()
+    {
+        Simulation::interruptsEnabled = 1;
+    }
+    static inline void forbidInterrupts()
+    {
+        Simulation::interruptsEnabled = 0;
+    }
+    static inline unsigned long timeInMilliseconds()
+    {
+        Simulation::poll();
+        return Simulation::clock/(F_CPU/1000);
+    }
+    /** Does not poll, so the firmware can measure its own time without changing it. */
+    static inline unsigned long timeInMicroseconds()
+    {
+        return Simulation::clock/(F_CPU/1000000);
+    }
+    static inline char readFlashByte(PGM_P ptr)
+    {
+        return pgm_read_byte(ptr);
+    }
+    static inline void serialSetBaudrate(long baud)
+    {
+        RFSERIAL.begin(baud);
+    }
+    static inline bool serialByteAvailable()
+    {
+        Simulation::poll();
+        return RFSERIAL.available()>0;
+    }
+    static inline uint8_t serialReadByte()
+    {
+        return RFSERIAL.read();
+    }
+    static inline void serialWriteByte(char b)
+    {
+        RFSERIAL.write(b);
+    }
+    static inline void serialFlush()
+    {
+        RFSERIAL.flush();
+    }
+    static inline int serialOutputUnused()
+    {
+        return RFSERIAL.outputUnused();
+    }
+    static void setupTimer();
+    static void showStartReason();
+    static int getFreeRam();
+    static void resetHardware();
+#if FEATURE_ENDSTOP_INTERRUPTS
+    static bool attachEndstopInterrupt(uint8_t pin);
+#endif
+#if FEATURE_DEFERRED_SPEED_UPDATE
+    static inline void triggerSpeedUpdate()
+    {
+        Simulation::speedUpdatePending = 1;
+    }
+    static void moveStepperTimer(unsigned long wait);
+#endif
+
+    // SPI related functions
+    static void spiBegin()
+    {
+    }
+    static inline void spiInit(uint8_t spiRate)
+    {
+    }
+    static inline uint8_t spiReceive(uint8_t send=0xff)
+    {
+        return 0xff;
+    }
+    static inline void spiReadBlock(uint8_t*buf,size_t nbyte)
+    {
+        memset(buf,0xff,nbyte);
+    }
+    static inline void spiSend(uint8_t b)
+    {
+    }
+    static inline void spiSend(const uint8_t* buf , size_t n)
+    {
+    }
+    static inline void spiSendBlock(uint8_t token, const uint8_t* buf)
+    {
+    }
+
+    // I2C Support
+
+    static void i2cInit(unsigned long clockSpeedHz) {}
+    static unsigned char i2cStart(unsigned char address) {return 1;}
+    static void i2cStartWait(unsigned char address) {}
+    static void i2cStop(void) {}
+    static unsigned char i2cWrite( unsigned char data ) {return 1;}
+    static unsigned char i2cReadAck(void) {return 0;}
+    static unsigned char i2cReadNak(void) {return 0;}
+
+    // Watchdog support
+
+    inline static void startWatchdog()
+    {
+    };
+    inline static void stopWatchdog()
+    {
+    }
+    inline static void pingWatchdog()
+    {
+    };
+    inline static float maxExtruderTimerFrequency()
+    {
+        return (float)F_CPU/TIMER0_PRESCALE;
+    }
+#if FEATURE_SERVO
+    static unsigned int servoTimings[4];
+    static void servoMicroseconds(uint8_t servo,int ms);
+#endif
+    static void analogStart();
+protected:
+private:
+};
+#endif // HAL_H
@@ -0,0 +1,633 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+  Reference host for the serial protocols of the firmware.
+
+  Sends a G-code file over a serial device or the pseudo terminal of repetier-sim -t
+  as ASCII, as ASCII driven by the extended ok, as binary repetier protocol or as
+  version 3 frames and reports the throughput. See README.txt in this directory for usage.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <deque>
+
+enum Mode {ASCII,EXTENDED,BINARY,FRAMES};
+
+struct Command
+{
+    std::string ascii;          ///< Line without line number and checksum
+    std::vector<uint8_t> fields; ///< Binary fields without line number and checksum
+    bool hasText;
+};
+
+struct Received
+{
+    uint64_t time;
+    std::string line;
+};
+
+static Mode mode = FRAMES;
+static uint64_t latency = 0;    ///< Nanoseconds each answer is delayed
+static int maxFrameCommands = 255;
+static int maxFrameSize = 128;
+static int errorEvery = 0;
+static int receiveBuffer = 127; ///< Bytes of unacknowledged lines in extended mode, one less than SERIAL_BUFFER_SIZE
+static bool verbose = false;
+static int port = -1;
+static std::vector<Command> commands;
+static std::deque<Received> received;
+static std::string inLine;
+static unsigned long transmissions = 0,resends = 0,bytesSent = 0,frames = 0;
+static int autoReport = 0;              ///< Seconds between automatic reports, 0 = none requested
+static std::vector<uint8_t> report;     ///< Binary report being received
+static unsigned long textReports[2] = {0,0},binaryReports[2] = {0,0},badReports = 0;
+
+static uint64_t nanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+
+template<typename T> static void append(std::vector<uint8_t> &v,T value)
+{
+    const uint8_t *p = (const uint8_t *)&value;
+    v.insert(v.end(),p,p+sizeof(T));
+}
+
+/** Encodes a command in the binary format of GCode::parseBinary without line number and checksum.
+Returns false for commands the binary format can not express. */
+static bool encodeBinary(const char *line,std::vector<uint8_t> &out,bool &hasText)
+{
+    uint16_t bits = 128,bits2 = 0;
+    long m = 0,g = 0,t = 0,s = 0,p = 0;
+    float x = 0,y = 0,z = 0,e = 0,f = 0,i = 0,j = 0,r = 0;
+    std::string text;
+    const char *pos = line;
+    hasText = false;
+    while(*pos)
+    {
+        char letter = *pos++;
+        if(letter == ' ' || letter == '\t') continue;
+        if(letter >= 'a' && letter <= 'z') letter -= 32;
+        char *end;
+        double value = strtod(pos,&end);
+        if(end == pos) return false;
+        pos = end;
+        switch(letter)
+        {
+        case 'M':
+            m = (long)value;
+            bits |= 2;
+            if(m == 23 || m == 28 || m == 29 || m == 30 || m == 32 || m == 117)
+            {
+                while(*pos == ' ') pos++;
+                text = pos;
+                if(text.size() > 79) return false;
+                hasText = true;
+                bits |= 32768;
+                pos += strlen(pos);
+            }
+            break;
+        case 'G': g = (long)value; bits |= 4; break;
+        case 'X': x = value; bits |= 8; break;
+        case 'Y': y = value; bits |= 16; break;
+        case 'Z': z = value; bits |= 32; break;
+        case 'E': e = value; bits |= 64; break;
+        case 'F': f = value; bits |= 256; break;
+        case 'T': t = (long)value; bits |= 512; break;
+        case 'S': s = (long)value; bits |= 1024; break;
+        case 'P': p = (long)value; bits |= 2048; break;
+        case 'I': i = value; bits2 |= 1; break;
+        case 'J': j = value; bits2 |= 2; break;
+        case 'R': r = value; bits2 |= 4; break;
+        default: return false;
+        }
+    }
+    bool v2 = bits2 || hasText || m > 255 || g > 255;
+    if(v2) bits |= 4096;
+    out.clear();
+    append(out,bits);
+    if(v2)
+    {
+        append(out,bits2);
+        if(hasText) append(out,(uint8_t)text.size());
+    }
+    if(bits & 2)
+    {
+        if(v2) append(out,(uint16_t)m);
+        else append(out,(uint8_t)m);
+    }
+    if(bits & 4)
+    {
+        if(v2) append(out,(uint16_t)g);
+        else append(out,(uint8_t)g);
+    }
+    if(bits & 8) append(out,x);
+    if(bits & 16) append(out,y);
+    if(bits & 32) append(out,z);
+    if(bits & 64) append(out,e);
+    if(bits & 256) append(out,f);
+    if(bits & 512) append(out,(uint8_t)t);
+    if(bits & 1024) append(out,(int32_t)s);
+    if(bits & 2048) append(out,(int32_t)p);
+    if(bits2 & 1) append(out,i);
+    if(bits2 & 2) append(out,j);
+    if(bits2 & 4) append(out,r);
+    out.insert(out.end(),text.begin(),text.end());
+    return true;
+}
+
+/** Reads the file like repetier-sim does: comments and empty lines are removed and commands
+waiting for temperatures are not sent, because heaters are not simulated. */
+static bool readCommands(const char *name)
+{
+    FILE *in = fopen(name,"r");
+    if(in == NULL)
+    {
+        perror(name);
+        return false;
+    }
+    char line[256];
+    while(fgets(line,sizeof(line),in))
+    {
+        char *comment = strchr(line,';');
+        if(comment) *comment = 0;
+        int len = strlen(line);
+        while(len > 0 && (unsigned char)line[len-1] <= ' ') len--;
+        line[len] = 0;
+        char *start = line;
+        while(*start == ' ' || *start == '\t') start++;
+        if(*start == 0) continue;
+        if(*start == 'M' && (atoi(start+1) == 109 || atoi(start+1) == 190 || atoi(start+1) == 116)) continue;
+        Command c;
+        c.ascii = start;
+        if(!encodeBinary(start,c.fields,c.hasText))
+        {
+            if(mode == BINARY || mode == FRAMES)
+            {
+                fprintf(stderr,"Can not encode %s\n",start);
+                fclose(in);
+                return false;
+            }
+        }
+        commands.push_back(c);
+    }
+    fclose(in);
+    return true;
+}
+
+static void appendFletcher16(std::vector<uint8_t> &v)
+{
+    unsigned int sum1 = 0,sum2 = 0;
+    for(size_t i = 0; i < v.size(); i++)
+    {
+        sum1 = (sum1+v[i]) % 255;
+        sum2 = (sum2+sum1) % 255;
+    }
+    v.push_back(sum1);
+    v.push_back(sum2);
+}
+
+static void send(std::vector<uint8_t> &data)
+{
+    if(errorEvery && ++transmissions % errorEvery == 0)
+        data[data.size()/2] ^= 0x55; // simulate a transmission error
+    for(size_t pos = 0; pos < data.size();)
+    {
+        ssize_t n = write(port,&data[pos],data.size()-pos);
+        if(n < 0)
+        {
+            if(errno == EAGAIN)
+            {
+                struct pollfd p = {port,POLLOUT,0};
+                poll(&p,1,100);
+                continue;
+            }
+            perror("write");
+            exit(1);
+        }
+        pos += n;
+    }
+    bytesSent += data.size();
+}
+
+static std::vector<uint8_t> formatAscii(const std::string &cmd,unsigned long line)
+{
+    char buf[300];
+    int len = snprintf(buf,sizeof(buf)-6,"N%lu %s",line,cmd.c_str());
+    uint8_t checksum = 0;
+    for(int i = 0; i < len; i++) checksum ^= buf[i];
+    len += sprintf(buf+len,"*%u\n",checksum);
+    return std::vector<uint8_t>(buf,buf+len);
+}
+
+static void sendAscii(const std::string &cmd,unsigned long line)
+{
+    std::vector<uint8_t> data = formatAscii(cmd,line);
+    send(data);
+}
+
+static void sendBinary(unsigned long line)
+{
+    const std::vector<uint8_t> &f = commands[line-1].fields;
+    std::vector<uint8_t> data;
+    uint16_t bits = f[0] | (f[1] << 8) | 1; // add line number
+    append(data,bits);
+    size_t head = (bits & 4096) ? 4+((bits & 32768) ? 1 : 0) : 2; // N follows bitfields and text length
+    data.insert(data.end(),f.begin()+2,f.begin()+head);
+    append(data,(uint16_t)line);
+    data.insert(data.end(),f.begin()+head,f.end());
+    appendFletcher16(data);
+    send(data);
+}
+
+/** Sends lines first.. in one frame as far as count, the frame size and text commands allow.
+Returns the number of lines sent. */
+static int sendFrame(unsigned long first,int count)
+{
+    std::vector<uint8_t> data;
+    append(data,(uint16_t)0x2080);
+    data.push_back(0);
+    append(data,(uint16_t)first);
+    data.push_back(0);
+    int n = 0;
+    while(n < count && n < maxFrameCommands && first+n <= commands.size())
+    {
+        const Command &c = commands[first+n-1];
+        if(data.size()+c.fields.size()+2 > (size_t)maxFrameSize) break;
+        data.insert(data.end(),c.fields.begin(),c.fields.end());
+        n++;
+        if(c.hasText) break; // string terminator overwrites the checksum
+    }
+    if(n == 0)
+    {
+        fprintf(stderr,"Line %lu does not fit into a frame of %d bytes\n",first,maxFrameSize);
+        exit(1);
+    }
+    data[2] = n;
+    data[5] = data.size()-6;
+    appendFletcher16(data);
+    send(data);
+    frames++;
+    return n;
+}
+
+/** Checks a binary report of FEATURE_AUTO_REPORT and prints it in verbose mode. */
+static void binaryReport()
+{
+    unsigned int sum1 = 0,sum2 = 0;
+    for(size_t i = 0; i+2 < report.size(); i++)
+    {
+        sum1 = (sum1+report[i]) % 255;
+        sum2 = (sum2+sum1) % 255;
+    }
+    if(sum1 != report[report.size()-2] || sum2 != report[report.size()-1])
+    {
+        badReports++;
+        return;
+    }
+    int type = report[0]-0x81;
+    binaryReports[type]++;
+    if(!verbose) return;
+    if(type == 0)
+    {
+        printf("Binary temperatures:");
+        for(size_t i = 2; i+5 <= report.size()-2; i += 5)
+        {
+            int16_t current,target;
+            memcpy(&current,&report[i],2);
+            memcpy(&target,&report[i+2],2);
+            printf(" %.1f/%.1f@%d",current/10.0,target/10.0,report[i+4]);
+        }
+        printf("\n");
+    }
+    else
+    {
+        float pos[4];
+        memcpy(pos,&report[2],16);
+        printf("Binary position: X:%.2f Y:%.2f Z:%.2f E:%.2f\n",pos[0],pos[1],pos[2],pos[3]);
+    }
+}
+
+/** Collects answers. Each line becomes visible latency nanoseconds after it arrived.
+Binary reports start with 0x81 or 0x82 where a line starts and are handled at once. */
+static void readAnswers(int timeout)
+{
+    struct pollfd p = {port,POLLIN,0};
+    if(poll(&p,1,timeout) <= 0) return;
+    char buf[512];
+    ssize_t n = read(port,buf,sizeof(buf));
+    if(n <= 0) return;
+    uint64_t now = nanos();
+    for(ssize_t i = 0; i < n; i++)
+    {
+        uint8_t c = buf[i];
+        if(!report.empty() || (inLine.empty() && (c == 0x81 || c == 0x82)))
+        {
+            report.push_back(c);
+            if(report.size() >= 2 && report.size() == report[1]+4u)
+            {
+                binaryReport();
+                report.clear();
+            }
+            continue;
+        }
+        if(buf[i] == '\r') continue;
+        if(buf[i] != '\n')
+        {
+            inLine += buf[i];
+            continue;
+        }
+        if(verbose) printf("%s\n",inLine.c_str());
+        if(inLine.compare(0,2,"T:") == 0) textReports[0]++;
+        if(inLine.compare(0,2,"X:") == 0) textReports[1]++;
+        Received r = {now+latency,inLine};
+        received.push_back(r);
+        inLine.clear();
+    }
+}
+
+/** Returns the next answer that passed its latency, waiting at most until a line arrives. */
+static bool nextAnswer(std::string &line)
+{
+    if(received.empty()) readAnswers(20);
+    if(received.empty()) return false;
+    uint64_t now = nanos();
+    if(received.front().time > now)
+    {
+        uint64_t wait = received.front().time-now;
+        if(wait > 1000000)
+        {
+            readAnswers(wait/1000000);
+            return false;
+        }
+        struct timespec ts = {0,(long)wait};
+        nanosleep(&ts,NULL);
+    }
+    line = received.front().line;
+    received.pop_front();
+    return true;
+}
+
+/** Full line number of a 16 bit line number at or after base. */
+static unsigned long unwrap(unsigned long base,unsigned long line)
+{
+    return base+((line-base) & 0xffff);
+}
+
+static void usage()
+{
+    fprintf(stderr,"Usage: repetier-send [options] device file.gcode\n"
+            " -m mode    ascii, extended, binary or v3 (default v3)\n"
+            " -b baud    Set the baudrate of a serial device\n"
+            " -l us      Delay every answer by us microseconds\n"
+            " -f n       At most n commands per v3 frame\n"
+            " -s bytes   Largest v3 frame, default 128 like PROTOCOL_V3_FRAME_SIZE\n"
+            " -r bytes   Unacknowledged bytes in extended mode, default 127\n"
+            " -a seconds Request temperature and position reports every seconds with M155 and M154,\n"
+            "            binary for the binary and v3 mode\n"
+            " -e n       Corrupt every nth transmission\n"
+            " -v         Print all answers\n"
+            "Exits with 2 if the firmware lacks a feature the options need.\n");
+    exit(1);
+}
+
+static speed_t baudrate(long baud)
+{
+    switch(baud)
+    {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    }
+    fprintf(stderr,"Unsupported baudrate %ld\n",baud);
+    exit(1);
+}
+
+int main(int argc,char **argv)
+{
+    int opt;
+    long baud = 0;
+    while((opt = getopt(argc,argv,"m:b:l:f:s:r:a:e:v")) != -1)
+    {
+        switch(opt)
+        {
+        case 'm':
+            if(strcmp(optarg,"ascii") == 0) mode = ASCII;
+            else if(strcmp(optarg,"extended") == 0) mode = EXTENDED;
+            else if(strcmp(optarg,"binary") == 0) mode = BINARY;
+            else if(strcmp(optarg,"v3") == 0) mode = FRAMES;
+            else usage();
+            break;
+        case 'b':
+            baud = atol(optarg);
+            break;
+        case 'l':
+            latency = (uint64_t)(atof(optarg)*1000.0);
+            break;
+        case 'f':
+            maxFrameCommands = atoi(optarg);
+            if(maxFrameCommands < 1 || maxFrameCommands > 255) usage();
+            break;
+        case 's':
+            maxFrameSize = atoi(optarg);
+            if(maxFrameSize < 16 || maxFrameSize > 255) usage();
+            break;
+        case 'r':
+            receiveBuffer = atoi(optarg);
+            if(receiveBuffer < 16) usage();
+            break;
+        case 'a':
+            autoReport = atoi(optarg);
+            break;
+        case 'e':
+            errorEvery = atoi(optarg);
+            break;
+        case 'v':
+            verbose = true;
+            break;
+        default:
+            usage();
+        }
+    }
+    if(optind+2 != argc) usage();
+    if(!readCommands(argv[optind+1])) return 1;
+    port = open(argv[optind],O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if(port < 0)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+    struct termios t;
+    if(tcgetattr(port,&t) == 0)
+    {
+        cfmakeraw(&t);
+        if(baud) cfsetspeed(&t,baudrate(baud));
+        tcsetattr(port,TCSANOW,&t);
+    }
+    // Ask for the protocol version, then line numbers start with 1 after N0 M110
+    std::vector<uint8_t> m115((const uint8_t *)"M115\n",(const uint8_t *)"M115\n"+5);
+    send(m115);
+    int expectedOks = 2;
+    if(autoReport)
+    {
+        char request[40];
+        bool binary = (mode == BINARY || mode == FRAMES);
+        for(int m = 154; m <= 155; m++)
+        {
+            int len = sprintf(request,"M%d S%d P%d\n",m,autoReport,binary ? 1 : 0);
+            std::vector<uint8_t> data(request,request+len);
+            send(data);
+        }
+        expectedOks += 2;
+    }
+    sendAscii("M110",0);
+    std::string line;
+    int protocol = 0,oks = 0;
+    bool extendedOk = false,autoReports = false;
+    uint64_t lastProgress = nanos();
+    while(oks < expectedOks)
+    {
+        if(nanos()-lastProgress > 5000000000ULL)
+        {
+            fprintf(stderr,"No answer\n");
+            return 1;
+        }
+        if(!nextAnswer(line)) continue;
+        size_t pos = line.find("REPETIER_PROTOCOL:");
+        if(pos != std::string::npos) protocol = atoi(line.c_str()+pos+18);
+        if(line.find("EXTENDED_OK:1") != std::string::npos) extendedOk = true;
+        if(line.find("AUTOREPORT:1") != std::string::npos) autoReports = true;
+        if(line.compare(0,2,"ok") == 0) oks++;
+    }
+    if(mode == FRAMES && protocol < 3)
+    {
+        fprintf(stderr,"Firmware does not support protocol version 3, compile it with FEATURE_PROTOCOL_V3\n");
+        return 2;
+    }
+    if(autoReport && !autoReports)
+    {
+        fprintf(stderr,"Firmware does not send reports automatically, compile it with FEATURE_AUTO_REPORT\n");
+        return 2;
+    }
+    if(mode == EXTENDED && !extendedOk)
+    {
+        fprintf(stderr,"Firmware does not send the extended ok, compile it with FEATURE_EXTENDED_OK\n");
+        return 2;
+    }
+    bytesSent = 0;
+    uint64_t start = nanos();
+    unsigned long total = commands.size();
+    unsigned long acked = 0;  // last acknowledged line
+    unsigned long next = 1;   // next line to send
+    unsigned long window = 1; // free command buffers reported by the last ok
+    std::vector<size_t> lengths(total+1,0); // bytes of each ASCII line sent in extended mode
+    size_t pending = 0;       // bytes of the lines after acked
+    bool resendPending = false;
+    std::vector<uint8_t> zeros(32,0);
+    lastProgress = nanos();
+    while(acked < total)
+    {
+        if(mode == FRAMES)
+        {
+            while(next <= total && next-1-acked < window)
+                next += sendFrame(next,window-(next-1-acked));
+        }
+        else if(mode == EXTENDED)
+        {
+            // B more lines and always one, as long as they fit into the receive buffer
+            while(next <= total && (next == acked+1 || next-1-acked < window))
+            {
+                std::vector<uint8_t> data = formatAscii(commands[next-1].ascii,next);
+                if(next > acked+1 && pending+data.size() > (size_t)receiveBuffer) break;
+                lengths[next] = data.size();
+                pending += data.size();
+                send(data);
+                next++;
+            }
+        }
+        else if(next == acked+1 && next <= total)
+        {
+            if(mode == ASCII) sendAscii(commands[next-1].ascii,next);
+            else sendBinary(next);
+            next++;
+        }
+        if(!nextAnswer(line))
+        {
+            if(nanos()-lastProgress > 5000000000ULL)
+            {
+                fprintf(stderr,"No answer after line %lu\n",acked);
+                return 1;
+            }
+            continue;
+        }
+        if(line.compare(0,7,"Resend:") == 0)
+        {
+            acked = unwrap(acked,strtoul(line.c_str()+7,NULL,10)-1);
+            next = acked+1;
+            pending = 0;
+            window = 1;
+            resends++;
+            resendPending = true;
+            if(mode != ASCII)
+                send(zeros); // binary input only syncs again after 30 zeros
+            continue;
+        }
+        if(line.compare(0,2,"ok") != 0) continue;
+        lastProgress = nanos();
+        if(mode == FRAMES || mode == EXTENDED)
+        {
+            char *end;
+            unsigned long n = strtoul(line.c_str()+4,&end,10);
+            const char *b = strstr(end,"B");
+            if(line.compare(0,4,"ok N") != 0 || b == NULL) continue; // ok of a resend request
+            n = unwrap(acked,n);
+            while(acked < n && acked+1 < next) pending -= lengths[++acked];
+            acked = n;
+            window = strtoul(b+1,NULL,10);
+        }
+        else if(resendPending) // the ok belongs to the resend request
+            resendPending = false;
+        else
+            acked = next-1;
+        if(next <= acked) next = acked+1;
+    }
+    double seconds = (nanos()-start)/1e9;
+    printf("%lu lines, %lu bytes in %.3f s: %.0f lines/s, %lu frames, %lu resends\n",total,bytesSent,seconds,
+           total/seconds,frames,resends);
+    if(autoReport)
+        printf("Reports: %lu temperature and %lu position as text, %lu and %lu binary, %lu with wrong checksum\n",
+               textReports[0],textReports[1],binaryReports[0],binaryReports[1],badReports);
+    close(port);
+    return 0;
+}
@@ -0,0 +1,1138 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+  Host simulation and G-code replay benchmark.
+
+  Runs the unmodified firmware loop against a G-code file and reports planner and
+  stepper interrupt costs, queue underruns and the simulated print time.
+  See README.txt in this directory for usage.
+*/
+
+#include "Repetier.h"
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <termios.h>
+#include <string>
+#include <vector>
+
+uint64_t Simulation::clock = 0;
+uint8_t Simulation::interruptsEnabled = 1;
+uint8_t Simulation::insideInterrupt = 0;
+uint8_t Simulation::pins[SIM_NUM_PINS];
+uint8_t Simulation::endstopPins[SIM_NUM_PINS];
+uint8_t Simulation::eeprom[SIM_EEPROM_SIZE];
+SimulationSerial Simulation::serial;
+FILE *Simulation::stepLog = NULL;
+FILE *Simulation::isrLog = NULL;
+uint64_t Simulation::pollTicks = 20*(F_CPU/1000000);
+float Simulation::cpuFactor = 0;
+uint64_t Simulation::timer1Next = ~(uint64_t)0;
+uint64_t Simulation::pwmNext = ~(uint64_t)0;
+uint64_t Simulation::timer1Last = 0;
+uint8_t Simulation::speedUpdatePending = 0;
+uint64_t Simulation::extruderNext = ~(uint64_t)0;
+uint64_t Simulation::probeTime[PROBE_COUNT];
+uint64_t Simulation::probeMax[PROBE_COUNT];
+unsigned long Simulation::probeCalls[PROBE_COUNT];
+uint64_t Simulation::probeStartTime[PROBE_COUNT];
+uint64_t Simulation::depthTime[SIM_QUEUE_DEPTHS];
+unsigned long Simulation::depthCalls[SIM_QUEUE_DEPTHS];
+unsigned long Simulation::depthSegments[SIM_QUEUE_DEPTHS];
+unsigned long Simulation::depthUpdates[SIM_QUEUE_DEPTHS];
+unsigned long Simulation::plannerSegments = 0;
+unsigned long Simulation::parameterUpdates = 0;
+unsigned long Simulation::deltaSegments = 0;
+double Simulation::deltaDeviationMax = 0;
+double Simulation::deltaDeviationSum = 0;
+long Simulation::deltaSegmentStartSteps[3];
+unsigned long Simulation::deltaSegmentsComputed = 0;
+unsigned long Simulation::deltaSegmentsLate = 0;
+unsigned long Simulation::deltaSegmentClamps = 0;
+unsigned long Simulation::rampChecks = 0;
+unsigned long Simulation::rampViolations = 0;
+double Simulation::rampAccelerationMax = 0;
+unsigned long Simulation::sCurveRamps = 0;
+unsigned long Simulation::sCurveJerkRaised = 0;
+unsigned long Simulation::sCurveUnshaped = 0;
+PrintLine *Simulation::rampLine = NULL;
+long Simulation::rampTimer = 0;
+unsigned int Simulation::rampV = 0;
+uint64_t Simulation::isrTime = 0;
+uint64_t Simulation::isrMax = 0;
+unsigned long Simulation::isrCalls = 0;
+uint64_t Simulation::speedUpdateTime = 0;
+uint64_t Simulation::speedUpdateMax = 0;
+unsigned long Simulation::speedUpdates = 0;
+unsigned long Simulation::speedUpdatesDropped = 0;
+unsigned long Simulation::steps[4];
+uint64_t Simulation::lastStep[4];
+uint64_t Simulation::lastStepInterval[4];
+uint8_t Simulation::lastStepDir[4];
+double Simulation::stepJitter[4];
+unsigned long Simulation::jitterCount[4];
+unsigned long Simulation::underruns = 0;
+uint64_t Simulation::stallTime = 0;
+bool Simulation::stalled = false;
+unsigned long Simulation::stepPulses = 0;
+unsigned long Simulation::multiAxisPulses = 0;
+unsigned long Simulation::stepPortWrites = 0;
+uint64_t Simulation::stepPortCycles = 0;
+uint64_t Simulation::stepSkewSum = 0;
+unsigned long Simulation::stepSkewMax = 0;
+uint64_t Simulation::pulseFirstRise = 0;
+uint64_t Simulation::pulseLastRise = 0;
+uint8_t Simulation::pulseRises = 0;
+unsigned long Simulation::endstopReads = 0;
+unsigned long Simulation::intervalLookups = 0;
+unsigned long Simulation::intervalDivisions = 0;
+unsigned long Simulation::extruderCalls = 0;
+int Simulation::advancePendingMax = 0;
+bool Simulation::moving = false;
+uint64_t Simulation::firstMove = 0;
+uint64_t Simulation::lastMove = 0;
+uint64_t Simulation::lastPoll = 0;
+uint64_t Simulation::hostExcluded = 0;
+
+static unsigned long forcedBaudrate = 0;
+
+uint64_t Simulation::hostNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+
+void Simulation::init()
+{
+    memset(pins,0,sizeof(pins));
+    memset(eeprom,255,sizeof(eeprom));
+    // Endstops are never triggered
+#if X_MIN_PIN>-1
+    pins[X_MIN_PIN] = ENDSTOP_X_MIN_INVERTING;
+    endstopPins[X_MIN_PIN] = 1;
+#endif
+#if Y_MIN_PIN>-1
+    pins[Y_MIN_PIN] = ENDSTOP_Y_MIN_INVERTING;
+    endstopPins[Y_MIN_PIN] = 1;
+#endif
+#if Z_MIN_PIN>-1
+    pins[Z_MIN_PIN] = ENDSTOP_Z_MIN_INVERTING;
+    endstopPins[Z_MIN_PIN] = 1;
+#endif
+#if X_MAX_PIN>-1
+    pins[X_MAX_PIN] = ENDSTOP_X_MAX_INVERTING;
+    endstopPins[X_MAX_PIN] = 1;
+#endif
+#if Y_MAX_PIN>-1
+    pins[Y_MAX_PIN] = ENDSTOP_Y_MAX_INVERTING;
+    endstopPins[Y_MAX_PIN] = 1;
+#endif
+#if Z_MAX_PIN>-1
+    pins[Z_MAX_PIN] = ENDSTOP_Z_MAX_INVERTING;
+    endstopPins[Z_MAX_PIN] = 1;
+#endif
+#if FEATURE_Z_PROBE && Z_PROBE_PIN>-1
+    pins[Z_PROBE_PIN] = !Z_PROBE_ON_HIGH;
+    endstopPins[Z_PROBE_PIN] = 1;
+#endif
+    lastPoll = hostNanos();
+}
+
+/** Ports and bits of the ATmega2560 pins as in fastio.h, used to group the step pins into ports. */
+static const char megaPinPorts[] = "EEEEGEHHHHBBBBJJHHDDDDAAAAAAAACCCCCCCCDGGGLLLLLLLLBBBBFFFFFFFFKKKKKKKKGGJJJJJJEEJJJJJH";
+static const char megaPinBits[] =  "01455334564567101032100123456776543210721076543210321001234567012345674323745626245677";
+
+static inline char pinPort(int pin)
+{
+    return pin >= 0 && pin < (int)sizeof(megaPinPorts)-1 ? megaPinPorts[pin] : 0;
+}
+
+static inline bool isStepPin(int pin)
+{
+    return pin == X_STEP_PIN || pin == Y_STEP_PIN || pin == Z_STEP_PIN || pin == EXT0_STEP_PIN;
+}
+
+void Simulation::writePin(int pin,uint8_t value)
+{
+    pin &= SIM_NUM_PINS-1;
+    uint8_t rising = setPin(pin,value);
+    if(isStepPin(pin))
+        stepPortWrite(pin,false,rising);
+}
+
+/** The step port is the port of Y_STEP_PIN if Y and Z share a port without X, otherwise the port of X_STEP_PIN. */
+static inline char stepPort()
+{
+    char port = pinPort(Y_STEP_PIN);
+    return port == pinPort(Z_STEP_PIN) && port != pinPort(X_STEP_PIN) ? port : pinPort(X_STEP_PIN);
+}
+
+uint8_t Simulation::stepPortMask(int pin)
+{
+    char port = pinPort(pin);
+    return port && port == stepPort() ? 1 << (megaPinBits[pin]-'0') : 0;
+}
+
+/** Writes all step pins of the step port in mask at once. */
+void Simulation::writeStepPort(uint8_t mask,uint8_t value)
+{
+    const int stepPins[4] = {X_STEP_PIN,Y_STEP_PIN,Z_STEP_PIN,EXT0_STEP_PIN};
+    uint8_t rising = 0;
+    for(int i=0; i<4; i++)
+        if(stepPortMask(stepPins[i]) & mask)
+            rising += setPin(stepPins[i],value);
+    stepPortWrite(stepPort() == pinPort(X_STEP_PIN) ? X_STEP_PIN : Y_STEP_PIN,true,rising);
+}
+
+/**
+  Counts a port write of step pins with the AVR cycles of its instructions: sbi/cbi for one pin on
+  ports A-G (2), in/or/out for a mask (3), lds/or/sts on the extended ports H-L (5). The skew of a
+  pulse is the time between its first and its last rising edge, counting only these writes.
+*/
+void Simulation::stepPortWrite(int pin,bool masked,uint8_t rising)
+{
+    uint8_t cost = pinPort(pin) >= 'H' ? 5 : (masked ? 3 : 2);
+    if(rising)
+    {
+        if(!pulseRises) pulseFirstRise = stepPortCycles;
+        pulseLastRise = stepPortCycles;
+        pulseRises += rising;
+    }
+    stepPortWrites++;
+    stepPortCycles += cost;
+    if(pulseRises && !pins[X_STEP_PIN] && !pins[Y_STEP_PIN] && !pins[Z_STEP_PIN] && !pins[EXT0_STEP_PIN])
+    {
+        stepPulses++;
+        if(pulseRises > 1)
+        {
+            unsigned long skew = pulseLastRise-pulseFirstRise;
+            multiAxisPulses++;
+            stepSkewSum += skew;
+            if(skew > stepSkewMax) stepSkewMax = skew;
+        }
+        pulseRises = 0;
+    }
+}
+
+/** Sets a pin and logs the step, if it is a rising step pin. Returns 1 for a logged step. */
+uint8_t Simulation::setPin(int pin,uint8_t value)
+{
+    uint8_t old = pins[pin];
+    pins[pin] = value;
+    if(!value || old) return 0;
+    int8_t axis = -1;
+    uint8_t dir = 0;
+    if(pin == X_STEP_PIN) {axis = X_AXIS;dir = pins[X_DIR_PIN];}
+    else if(pin == Y_STEP_PIN) {axis = Y_AXIS;dir = pins[Y_DIR_PIN];}
+    else if(pin == Z_STEP_PIN) {axis = Z_AXIS;dir = pins[Z_DIR_PIN];}
+    else if(pin == EXT0_STEP_PIN) {axis = E_AXIS;dir = pins[EXT0_DIR_PIN];}
+    if(axis < 0) return 0;
+    steps[axis]++;
+    // Step jitter compares consecutive intervals of an axis. Direction changes and pauses
+    // longer than 50 ms start a new measurement.
+    uint64_t interval = clock-lastStep[axis];
+    if(dir == lastStepDir[axis] && interval < F_CPU/20 && lastStepInterval[axis] < F_CPU/20)
+    {
+        double last = (double)lastStepInterval[axis];
+        stepJitter[axis] += fabs((double)interval-last)*2.0/((double)interval+last);
+        jitterCount[axis]++;
+    }
+    lastStep[axis] = clock;
+    lastStepInterval[axis] = (dir == lastStepDir[axis] ? interval : F_CPU);
+    lastStepDir[axis] = dir;
+    if(stepLog)
+        fprintf(stepLog,"%llu %c %d\n",(unsigned long long)clock,"XYZE"[axis],dir);
+    return 1;
+}
+
+/** Compares the ramp speed v with the speed at least 1 ms earlier in the same ramp. The time is
+Printer::timer, the time since the ramp start computed by the firmware itself, so step buffers
+and deferred speed updates do not change the result. Speeds are whole steps/s and the ramps
+use the time in units of 256 ticks, so a check only fails if the speed changed by more than the
+acceleration of the line allows in the window plus 512 ticks, plus 2 steps/s. */
+void Simulation::rampSpeed(unsigned int v)
+{
+    PrintLine *line = PrintLine::cur;
+    long timer = Printer::timer;
+    if(line == NULL) return;
+    if(line != rampLine || timer < rampTimer) // next ramp
+    {
+        rampLine = line;
+        rampTimer = timer;
+        rampV = v;
+        return;
+    }
+    if(timer - rampTimer < (long)(F_CPU / 1000)) return;
+    double dt = (double)(timer - rampTimer) / F_CPU;
+    double deltaV = fabs((double)v - (double)rampV);
+    double configured = (double)(line->fAcceleration + 1) * F_CPU / 262144.0; // upper bound of accelerationPrim
+    rampChecks++;
+    if(deltaV / dt > rampAccelerationMax * configured) rampAccelerationMax = deltaV / dt / configured;
+    if(deltaV > configured * (dt + 512.0 / F_CPU) + 2) rampViolations++;
+    rampTimer = timer;
+    rampV = v;
+}
+
+void Simulation::probeEnd(Probe p)
+{
+    uint64_t duration = hostNanos()-probeStartTime[p];
+    probeTime[p] += duration;
+    if(duration > probeMax[p]) probeMax[p] = duration;
+    probeCalls[p]++;
+    if(p == PATH_PLANNER)
+    {
+        depthTime[PrintLine::linesCount] += duration;
+        depthCalls[PrintLine::linesCount]++;
+        depthSegments[PrintLine::linesCount] += plannerSegments;
+        depthUpdates[PrintLine::linesCount] += parameterUpdates;
+        plannerSegments = parameterUpdates = 0;
+    }
+}
+
+/** Moves the virtual clock forward and calls all interrupts that became due. Interrupts
+wait while they are disabled or another interrupt is running, like on the real hardware. */
+void Simulation::advance(uint64_t ticks)
+{
+    uint64_t target = clock+ticks;
+    while(interruptsEnabled && !insideInterrupt)
+    {
+        uint64_t next = timer1Next;
+        if(pwmNext < next) next = pwmNext;
+        if(extruderNext < next) next = extruderNext;
+        if(next > target) break;
+        if(next > clock) clock = next;
+        insideInterrupt = 1;
+        interruptsEnabled = 0;
+        if(next == timer1Next) timer1Interrupt();
+        else if(next == pwmNext) pwmInterrupt();
+        else extruderInterrupt();
+#if FEATURE_DEFERRED_SPEED_UPDATE
+        if(speedUpdatePending) speedUpdateInterrupt(); // next in priority, before further timer interrupts
+#endif
+        interruptsEnabled = 1;
+        insideInterrupt = 0;
+    }
+    if(target > clock) clock = target;
+}
+
+/** Called whenever the firmware checks time or serial input. Each call costs
+pollTicks. With a cpu factor the host time used since the last poll is added,
+scaled to the speed of the simulated processor. */
+void Simulation::poll()
+{
+    if(insideInterrupt) return;
+    uint64_t ticks = pollTicks;
+    uint64_t now = hostNanos();
+    if(cpuFactor > 0)
+    {
+        uint64_t used = now-lastPoll;
+        used = (used > hostExcluded ? used-hostExcluded : 0);
+        ticks += (uint64_t)((double)used*cpuFactor*(F_CPU/1000000)/1000.0);
+    }
+    hostExcluded = 0;
+    advance(ticks);
+    serial.transfer();
+    lastPoll = hostNanos();
+    if(serial.finished() && GCode::peekCurrentCommand() == NULL && !PrintLine::hasLines() && !moving)
+    {
+        report();
+        exit(rampViolations ? 1 : 0);
+    }
+}
+
+void Simulation::delay(uint64_t ticks)
+{
+    if(insideInterrupt) return; // Busy waits inside interrupts are not part of the virtual time
+    advance(ticks);
+    serial.transfer();
+}
+
+void Simulation::report()
+{
+    const char *names[PROBE_COUNT] = {"Planner:","Path planner:","Parser:"};
+    unsigned long totalSteps = steps[0]+steps[1]+steps[2]+steps[3];
+    fprintf(stderr,"Lines sent:           %lu (%lu filtered)\n",serial.linesSent,serial.linesFiltered);
+    for(uint8_t i=0; i<PROBE_COUNT; i++)
+        fprintf(stderr,"%-22s%lu calls, %.2f us mean, %.2f us max\n",names[i],probeCalls[i],
+                probeCalls[i] ? (double)probeTime[i]/probeCalls[i]/1000.0 : 0.0,(double)probeMax[i]/1000.0);
+    fprintf(stderr,"Path planner by depth: queued moves: us mean/moves visited/parameter updates");
+    for(unsigned int i=0, n=0; i<SIM_QUEUE_DEPTHS; i++)
+        if(depthCalls[i])
+            fprintf(stderr,"%s%u: %.2f/%.1f/%.1f",(n++ % 6) ? ", " : "\n  ",i,(double)depthTime[i]/depthCalls[i]/1000.0,
+                    (double)depthSegments[i]/depthCalls[i],(double)depthUpdates[i]/depthCalls[i]);
+    fprintf(stderr,"\n");
+#if DRIVE_SYSTEM==3
+    if(deltaSegments)
+        fprintf(stderr,"Delta segmentation:   %lu segments, carriage deviation %.4f mm max, %.4f mm mean\n",deltaSegments,
+                deltaDeviationMax*Printer::invAxisStepsPerMM[Z_AXIS],deltaDeviationSum/deltaSegments*Printer::invAxisStepsPerMM[Z_AXIS]);
+#endif
+#if FEATURE_DELTA_SEGMENTS_ON_THE_FLY
+    fprintf(stderr,"Delta segments:       %lu computed, %lu by the stepper interrupt, %lu tower moves clamped\n",
+            deltaSegmentsComputed,deltaSegmentsLate,deltaSegmentClamps);
+#endif
+    fprintf(stderr,"Timer 1 interrupt:    %lu calls, %.1f ns mean, %.1f ns max\n",isrCalls,
+            isrCalls ? (double)isrTime/isrCalls : 0.0,(double)isrMax);
+#if FEATURE_DEFERRED_SPEED_UPDATE
+    fprintf(stderr,"Speed update int.:    %lu calls, %lu dropped, %.1f ns mean, %.1f ns max\n",speedUpdates,speedUpdatesDropped,
+            speedUpdates ? (double)speedUpdateTime/speedUpdates : 0.0,(double)speedUpdateMax);
+#endif
+    fprintf(stderr,"Steps X/Y/Z/E:        %lu/%lu/%lu/%lu, %.1f ns interrupt time per step\n",steps[0],steps[1],steps[2],steps[3],
+            totalSteps ? (double)isrTime/totalSteps : 0.0);
+    fprintf(stderr,"Step jitter X/Y/Z/E:  %.1f/%.1f/%.1f/%.1f %% mean change of consecutive step intervals\n",
+            jitterCount[0] ? 100.0*stepJitter[0]/jitterCount[0] : 0.0,jitterCount[1] ? 100.0*stepJitter[1]/jitterCount[1] : 0.0,
+            jitterCount[2] ? 100.0*stepJitter[2]/jitterCount[2] : 0.0,jitterCount[3] ? 100.0*stepJitter[3]/jitterCount[3] : 0.0);
+    fprintf(stderr,"Step pins:            %lu pulses, %.2f port writes and %.1f AVR cycles per pulse, skew of %lu multi axis pulses %.1f mean, %lu max cycles\n",
+            stepPulses,stepPulses ? (double)stepPortWrites/stepPulses : 0.0,stepPulses ? (double)stepPortCycles/stepPulses : 0.0,
+            multiAxisPulses,multiAxisPulses ? (double)stepSkewSum/multiAxisPulses : 0.0,stepSkewMax);
+    fprintf(stderr,"Endstop reads:        %lu pin reads, %.2f per timer interrupt\n",endstopReads,
+            isrCalls ? (double)endstopReads/isrCalls : 0.0);
+    if(rampChecks)
+        fprintf(stderr,"Ramp acceleration:    %lu checks, peak %.1f %% of the configured, %lu above it\n",rampChecks,
+                100.0*rampAccelerationMax,rampViolations);
+#if FEATURE_S_CURVE_ACCELERATION
+    fprintf(stderr,"S-curve ramps:        %lu computed, %lu with raised jerk, %lu with constant acceleration\n",sCurveRamps,
+            sCurveJerkRaised,sCurveUnshaped);
+#endif
+    fprintf(stderr,"Interval updates:     %lu table, %lu division, %.3f divisions per interrupt\n",intervalLookups,intervalDivisions,
+            isrCalls ? (double)intervalDivisions/isrCalls : 0.0);
+#if defined(USE_ADVANCE)
+    fprintf(stderr,"Advance:              %lu extruder interrupts, %d extruder steps pending max\n",extruderCalls,advancePendingMax);
+#endif
+    fprintf(stderr,"Queue underruns:      %lu, %.3f s stalled, firmware counted %u, min queue %.1f ms\n",underruns,
+            (double)stallTime/F_CPU,PrintLine::underruns,
+            PrintLine::minQueuedTicks == 0x7fffffff ? 0.0 : (double)PrintLine::minQueuedTicks*1000.0/F_CPU);
+    if(serial.modelOutput)
+        fprintf(stderr,"Output buffer full:   %lu writes waited %.3f s\n",serial.outputWaits,(double)serial.outputWaitTime/F_CPU);
+    fprintf(stderr,"Moving time:          %.3f s\n",lastMove > firstMove ? (double)(lastMove-firstMove)/F_CPU : 0.0);
+    fprintf(stderr,"Simulated print time: %.3f s\n",(double)clock/F_CPU);
+    if(stepLog) fflush(stepLog);
+    if(isrLog) fflush(isrLog);
+    if(serial.echo) fflush(serial.echo);
+}
+
+// ================== Serial port ======================
+
+void SimulationSerial::begin(unsigned long baud)
+{
+    if(forcedBaudrate) baud = forcedBaudrate;
+    ticksPerByte = (uint64_t)F_CPU*10/baud; // 8N1 = 10 bit per byte
+    nextByteTime = Simulation::clock;
+}
+
+int SimulationSerial::available()
+{
+    return (SIM_SERIAL_IN_SIZE+rxHead-rxTail) & (SIM_SERIAL_IN_SIZE-1);
+}
+
+int SimulationSerial::read()
+{
+    if(rxHead == rxTail) return -1;
+    uint8_t c = rxBuffer[rxTail];
+    rxTail = (rxTail+1) & (SIM_SERIAL_IN_SIZE-1);
+    return c;
+}
+
+/** Reads the next line to send from the input file. Comments, empty lines and commands
+waiting for temperatures are removed, because heaters are not simulated. */
+bool SimulationSerial::nextLine()
+{
+    while(!inputFinished)
+    {
+        if(fgets(line,SIM_SERIAL_LINE_SIZE-1,input) == NULL)
+        {
+            inputFinished = true;
+            lineLength = linePos = 0;
+            return false;
+        }
+        char *comment = strchr(line,';');
+        if(comment) *comment = 0;
+        lineLength = strlen(line);
+        while(lineLength > 0 && (unsigned char)line[lineLength-1] <= ' ') lineLength--;
+        if(lineLength == 0) continue;
+        line[lineLength] = 0;
+        int start = 0;
+        while(line[start] == ' ' || line[start] == '\t') start++;
+        if(line[start] == 'M' && (atoi(line+start+1) == 109 || atoi(line+start+1) == 190 || atoi(line+start+1) == 116))
+        {
+            linesFiltered++;
+            continue;
+        }
+        if(lineLength > SIM_SERIAL_IN_SIZE-2) lineLength = SIM_SERIAL_IN_SIZE-2;
+        line[lineLength++] = '\n';
+        linePos = 0;
+        lineQueued = false;
+        return true;
+    }
+    return false;
+}
+
+/** Creates a pseudo terminal in raw mode and a symbolic link named link to its slave
+device, which a host program opens like the serial port of a printer. */
+bool SimulationSerial::openTerminal(const char *link)
+{
+    terminal = posix_openpt(O_RDWR | O_NOCTTY);
+    if(terminal < 0 || grantpt(terminal) || unlockpt(terminal)) return false;
+    const char *name = ptsname(terminal);
+    int slave = open(name,O_RDWR | O_NOCTTY);
+    if(slave < 0) return false;
+    struct termios t;
+    tcgetattr(slave,&t);
+    cfmakeraw(&t);
+    tcsetattr(slave,TCSANOW,&t);
+    close(slave);
+    fcntl(terminal,F_SETFL,O_NONBLOCK);
+    unlink(link);
+    return symlink(name,link) == 0;
+}
+
+/** Reads what the host has written, as far as it fits into the receive buffer. Reading
+fails until the host opens the terminal and again after it closed it. */
+void SimulationSerial::transferTerminal()
+{
+    uint8_t buf[SIM_SERIAL_IN_SIZE];
+    int n = SIM_SERIAL_IN_SIZE-1-available();
+    if(n <= 0 || hostClosed) return;
+    n = ::read(terminal,buf,n);
+    if(n < 0)
+    {
+        if(errno != EIO) return;
+        if(hostConnected)
+            hostClosed = true;
+        else
+            usleep(1000); // wait for the host without burning cpu time
+        return;
+    }
+    hostConnected = true;
+    for(int i=0; i<n; i++)
+    {
+        rxBuffer[rxHead] = buf[i];
+        rxHead = (rxHead+1) & (SIM_SERIAL_IN_SIZE-1);
+    }
+}
+
+/** Transfers bytes that arrived until now into the receive buffer. */
+void SimulationSerial::transfer()
+{
+    if(terminal >= 0)
+    {
+        transferTerminal();
+        return;
+    }
+    if(!input) return;
+    while(nextByteTime <= Simulation::clock)
+    {
+        if(linePos >= lineLength && !nextLine())
+        {
+            nextByteTime = Simulation::clock+ticksPerByte;
+            return;
+        }
+        if(!lineQueued)
+        {
+            if(unacknowledgedBytes+lineLength > SIM_SERIAL_IN_SIZE-1)   // wait for ok
+            {
+                nextByteTime = Simulation::clock+ticksPerByte;
+                return;
+            }
+            unacknowledged[ackHead] = lineLength;
+            ackHead = (ackHead+1) & (SIM_SERIAL_IN_SIZE-1);
+            unacknowledgedBytes += lineLength;
+            lineQueued = true;
+            linesSent++;
+        }
+        uint8_t next = (rxHead+1) & (SIM_SERIAL_IN_SIZE-1);
+        if(next == rxTail) // firmware does not read
+        {
+            nextByteTime = Simulation::clock+ticksPerByte;
+            return;
+        }
+        rxBuffer[rxHead] = line[linePos++];
+        rxHead = next;
+        nextByteTime += ticksPerByte;
+    }
+}
+
+/** Writes the outPos bytes of outLine to the pseudo terminal. */
+void SimulationSerial::sendToHost()
+{
+    if(!hostConnected || hostClosed) return;
+    for(int pos=0; pos<outPos;)
+    {
+        int n = ::write(terminal,outLine+pos,outPos-pos);
+        if(n > 0)
+            pos += n;
+        else if(errno == EAGAIN)
+            usleep(100); // host does not read fast enough
+        else
+            return;
+    }
+}
+
+void SimulationSerial::lineReceived()
+{
+    if(echo) fprintf(echo,"%s\n",outLine);
+    if(terminal >= 0)
+    {
+        outLine[outPos++] = '\n';
+        sendToHost();
+        return;
+    }
+    if(strncmp(outLine,"ok",2) == 0 && ackHead != ackTail)
+    {
+        unacknowledgedBytes -= unacknowledged[ackTail];
+        ackTail = (ackTail+1) & (SIM_SERIAL_IN_SIZE-1);
+    }
+}
+
+/** Free bytes of the modelled output buffer, 255 if writes never wait. */
+int SimulationSerial::outputUnused()
+{
+    if(!modelOutput) return 255;
+    if(outputEndTime <= Simulation::clock) return SIM_SERIAL_OUT_SIZE-1;
+    int queued = (outputEndTime-Simulation::clock+ticksPerByte-1)/ticksPerByte;
+    return queued >= SIM_SERIAL_OUT_SIZE-1 ? 0 : SIM_SERIAL_OUT_SIZE-1-queued;
+}
+
+void SimulationSerial::write(uint8_t c)
+{
+    if(modelOutput)
+    {
+        if(outputUnused() == 0)   // wait until one byte has left, interrupts keep running
+        {
+            uint64_t wait = outputEndTime-(SIM_SERIAL_OUT_SIZE-2)*ticksPerByte-Simulation::clock;
+            outputWaitTime += wait;
+            outputWaits++;
+            Simulation::advance(wait);
+        }
+        if(outputEndTime < Simulation::clock) outputEndTime = Simulation::clock;
+        outputEndTime += ticksPerByte;
+    }
+    if(binaryLeft != 0)   // report records can contain any byte, also \r, \n and 0
+    {
+        outLine[outPos++] = c;
+        binaryLeft = (binaryLeft < 0 ? c+2 : binaryLeft-1); // payload and checksum follow the length
+        if(binaryLeft == 0) binaryReceived();
+        return;
+    }
+    if(outPos == 0 && (c == 0x81 || c == 0x82))   // binary report of M154/M155 P1
+    {
+        outLine[outPos++] = c;
+        binaryLeft = -1;
+        return;
+    }
+    if(c == '\r') return;
+    if(c == '\n' || outPos >= SIM_SERIAL_LINE_SIZE-1)
+    {
+        outLine[outPos] = 0;
+        lineReceived();
+        outPos = 0;
+        if(c == '\n') return;
+    }
+    outLine[outPos++] = c;
+}
+
+/** Passes a binary report on unchanged. It is no answer, so the built in host ignores it. */
+void SimulationSerial::binaryReceived()
+{
+    if(echo)
+    {
+        fprintf(echo,"binary report");
+        for(int i=0; i<outPos; i++)
+            fprintf(echo," %02x",(uint8_t)outLine[i]);
+        fprintf(echo,"\n");
+    }
+    if(terminal >= 0)
+        sendToHost();
+    outPos = 0;
+}
+
+bool SimulationSerial::finished()
+{
+    if(terminal >= 0) return hostClosed;
+    return inputFinished && ackHead == ackTail;
+}
+
+// ================== Arduino functions used by the firmware ======================
+
+void pinMode(uint8_t pin,uint8_t mode) {}
+void digitalWrite(uint8_t pin,uint8_t value)
+{
+    Simulation::writePin(pin,value);
+}
+int digitalRead(uint8_t pin)
+{
+    return Simulation::readPin(pin);
+}
+void analogWrite(uint8_t pin,int value)
+{
+    Simulation::writePin(pin,value!=0);
+}
+#if DRIVE_SYSTEM==3
+/** The float version of transformCartesianStepsToDeltaSteps used for large machines before. */
+static uint8_t floatDeltaSteps(long cartesianPosSteps[], long deltaPosSteps[])
+{
+    const long towerX[3] = {Printer::deltaAPosXSteps,Printer::deltaBPosXSteps,Printer::deltaCPosXSteps};
+    const long towerY[3] = {Printer::deltaAPosYSteps,Printer::deltaBPosYSteps,Printer::deltaCPosYSteps};
+    float rod2 = float(Printer::deltaDiagonalSteps)*float(Printer::deltaDiagonalSteps);
+    for(uint8_t i=0; i<3; i++)
+    {
+        float temp = towerY[i] - cartesianPosSteps[Y_AXIS];
+        float opt = rod2 - temp*temp;
+        float temp2 = towerX[i] - cartesianPosSteps[X_AXIS];
+        if ((temp = opt - temp2*temp2) < 0)
+            return 0;
+        deltaPosSteps[i] = sqrtf(temp) + cartesianPosSteps[Z_AXIS];
+    }
+    return 1;
+}
+
+/** Carriage height above the effector in steps, computed in double precision. */
+static double exactCarriageHeight(long towerX, long towerY, double x, double y)
+{
+    double dx = towerX - x, dy = towerY - y, rod = Printer::deltaDiagonalSteps;
+    double r = rod*rod - dx*dx - dy*dy;
+    return r > 0 ? sqrt(r) : 0;
+}
+
+void Simulation::deltaSegmentStart(long cartesianPosSteps[])
+{
+    for(int i=0; i<3; i++)
+        deltaSegmentStartSteps[i] = cartesianPosSteps[i];
+}
+
+/** Compares the carriage positions in the middle of the segment with the mean of both ends. */
+void Simulation::deltaSegmentEnd(long cartesianPosSteps[])
+{
+    const long towerX[3] = {Printer::deltaAPosXSteps,Printer::deltaBPosXSteps,Printer::deltaCPosXSteps};
+    const long towerY[3] = {Printer::deltaAPosYSteps,Printer::deltaBPosYSteps,Printer::deltaCPosYSteps};
+    double midX = 0.5*(deltaSegmentStartSteps[X_AXIS]+cartesianPosSteps[X_AXIS]);
+    double midY = 0.5*(deltaSegmentStartSteps[Y_AXIS]+cartesianPosSteps[Y_AXIS]);
+    double deviation = 0;
+    for(int i=0; i<3; i++)
+    {
+        double chord = 0.5*(exactCarriageHeight(towerX[i],towerY[i],deltaSegmentStartSteps[X_AXIS],deltaSegmentStartSteps[Y_AXIS])
+                            + exactCarriageHeight(towerX[i],towerY[i],cartesianPosSteps[X_AXIS],cartesianPosSteps[Y_AXIS]));
+        double d = fabs(exactCarriageHeight(towerX[i],towerY[i],midX,midY) - chord);
+        if(d > deviation) deviation = d;
+    }
+    deltaSegments++;
+    deltaDeviationSum += deviation;
+    if(deviation > deltaDeviationMax) deltaDeviationMax = deviation;
+}
+
+/**
+  Compares transformCartesianStepsToDeltaSteps with a double precision solution on a grid
+  covering everything the rods can reach, for the configured resolution and with 2 and 4
+  times the steps per mm, which use the large machine code. Also times the fixed point and
+  the float version on the host.
+*/
+void Simulation::checkDeltaKinematics()
+{
+    const int gridXY = 121, gridZ = 6;
+    float stepsPerMM = Printer::axisStepsPerMM[Z_AXIS];
+    for(int factor = 1; factor <= 4; factor <<= 1)
+    {
+        Printer::axisStepsPerMM[Z_AXIS] = stepsPerMM*factor;
+        Printer::updateDerivedParameter();
+        long radius = (long)(EEPROM::deltaHorizontalRadius()*Printer::axisStepsPerMM[Z_AXIS]);
+        const long towerX[3] = {Printer::deltaAPosXSteps,Printer::deltaBPosXSteps,Printer::deltaCPosXSteps};
+        const long towerY[3] = {Printer::deltaAPosYSteps,Printer::deltaBPosYSteps,Printer::deltaCPosYSteps};
+        double rod = Printer::deltaDiagonalSteps;
+        unsigned long points = 0, mismatches = 0, floatMismatches = 0;
+        double maxError = 0, sumError = 0, maxFloatError = 0;
+        long cart[3], delta[3], floatDelta[3];
+        for(int ix=0; ix<gridXY; ix++)
+            for(int iy=0; iy<gridXY; iy++)
+                for(int iz=0; iz<gridZ; iz++)
+                {
+                    cart[X_AXIS] = -radius + 2*radius*ix/(gridXY-1);
+                    cart[Y_AXIS] = -radius + 2*radius*iy/(gridXY-1);
+                    cart[Z_AXIS] = Printer::zMaxSteps*iz/(gridZ-1);
+                    double exact[3];
+                    bool valid = true;
+                    for(int i=0; i<3; i++)
+                    {
+                        double dx = towerX[i]-cart[X_AXIS], dy = towerY[i]-cart[Y_AXIS];
+                        double r = rod*rod-dx*dx-dy*dy;
+                        if(r < 0) valid = false;
+                        else exact[i] = sqrt(r)+cart[Z_AXIS];
+                    }
+                    uint8_t ok = transformCartesianStepsToDeltaSteps(cart,delta);
+                    uint8_t floatOk = floatDeltaSteps(cart,floatDelta);
+                    if(ok != valid) mismatches++;
+                    if(floatOk != valid) floatMismatches++;
+                    if(!valid || !ok || !floatOk) continue;
+                    points++;
+                    for(int i=0; i<3; i++)
+                    {
+                        double error = fabs(delta[i]-exact[i]);
+                        sumError += error;
+                        if(error > maxError) maxError = error;
+                        if(fabs(floatDelta[i]-exact[i]) > maxFloatError) maxFloatError = fabs(floatDelta[i]-exact[i]);
+                    }
+                }
+        // Timing over the reachable part of the grid
+        volatile long sink = 0;
+        uint64_t fixedTime = 0, floatTime = 0;
+        unsigned long calls = 0;
+        for(int pass=0; pass<2; pass++)
+        {
+            uint64_t start = hostNanos();
+            for(int ix=0; ix<gridXY; ix++)
+                for(int iy=0; iy<gridXY; iy++)
+                {
+                    cart[X_AXIS] = -radius/2 + radius*ix/(gridXY-1);
+                    cart[Y_AXIS] = -radius/2 + radius*iy/(gridXY-1);
+                    cart[Z_AXIS] = 0;
+                    if(pass == 0)
+                        transformCartesianStepsToDeltaSteps(cart,delta);
+                    else
+                        floatDeltaSteps(cart,delta);
+                    sink += delta[0];
+                    if(pass == 0) calls++;
+                }
+            if(pass == 0) fixedTime = hostNanos()-start;
+            else floatTime = hostNanos()-start;
+        }
+        fprintf(stderr,"Delta kinematics x%d:  rod %ld steps%s, %lu points, max error %.2f steps, mean %.3f, %lu validity mismatches\n",
+                factor,Printer::deltaDiagonalSteps,Printer::isLargeMachine() ? " (large machine)" : "",points,maxError,
+                points ? sumError/(3*points) : 0.0,mismatches);
+        fprintf(stderr,"  float version: max error %.2f steps, %lu validity mismatches\n",maxFloatError,floatMismatches);
+        fprintf(stderr,"  host time: fixed point %.1f ns, float %.1f ns per position\n",(double)fixedTime/calls,(double)floatTime/calls);
+    }
+    Printer::axisStepsPerMM[Z_AXIS] = stepsPerMM;
+    Printer::updateDerivedParameter();
+}
+#endif
+
+/** Result of the former strtod based GCode::parseAscii. */
+struct ReferenceCode
+{
+    unsigned int params,params2;
+    uint32_t lineNumber;
+    unsigned int M,G;
+    float X,Y,Z,E,F,I,J,R;
+    uint8_t T;
+    long S,P;
+    char *text;
+};
+
+static float referenceFloat(ReferenceCode &code,char *s)
+{
+    char *endPtr;
+    float f = (strtod(s, &endPtr));
+    if(s == endPtr) code.params2 |= 32768;
+    return f;
+}
+
+static long referenceLong(ReferenceCode &code,char *s)
+{
+    char *endPtr;
+    long l = (strtol(s, &endPtr, 10));
+    if(s == endPtr) code.params2 |= 32768;
+    return l;
+}
+
+/** GCode::parseAscii before the single pass parser, without the error counter. Returns false
+for a wrong checksum or a format error. */
+static bool referenceParseAscii(ReferenceCode &code,char *line)
+{
+    char *pos;
+    code.params = 0;
+    code.params2 = 0;
+    if((pos = strchr(line,'N'))!=0) { code.lineNumber = referenceLong(code,++pos); code.params |= 1; }
+    if((pos = strchr(line,'M'))!=0)
+    {
+        code.M = referenceLong(code,++pos) & 0xffff;
+        code.params |= 2;
+        if(code.M>255) code.params |= 4096;
+    }
+    if((code.params & 2) && (code.M == 23 || code.M == 28 || code.M == 29 || code.M == 30 || code.M == 32 || code.M == 117))
+    {
+        char *sp = line;
+        while(*sp!='M') sp++;
+        while(*sp!=' ') sp++;
+        while(*sp==' ') sp++;
+        code.text = sp;
+        while(*sp)
+        {
+            if(code.M != 117 && (*sp==' ' || *sp=='*')) break;
+            sp++;
+        }
+        *sp = 0;
+        code.params |= 32768;
+    }
+    else
+    {
+        if((pos = strchr(line,'G'))!=0) { code.G = referenceLong(code,++pos) & 0xffff; code.params |= 4; if(code.G>255) code.params |= 4096; }
+        if((pos = strchr(line,'X'))!=0) { code.X = referenceFloat(code,++pos); code.params |= 8; }
+        if((pos = strchr(line,'Y'))!=0) { code.Y = referenceFloat(code,++pos); code.params |= 16; }
+        if((pos = strchr(line,'Z'))!=0) { code.Z = referenceFloat(code,++pos); code.params |= 32; }
+        if((pos = strchr(line,'E'))!=0) { code.E = referenceFloat(code,++pos); code.params |= 64; }
+        if((pos = strchr(line,'F'))!=0) { code.F = referenceFloat(code,++pos); code.params |= 256; }
+        if((pos = strchr(line,'T'))!=0) { code.T = referenceLong(code,++pos) & 0xff; code.params |= 512; }
+        if((pos = strchr(line,'S'))!=0) { code.S = referenceLong(code,++pos); code.params |= 1024; }
+        if((pos = strchr(line,'P'))!=0) { code.P = referenceLong(code,++pos); code.params |= 2048; }
+        if((pos = strchr(line,'I'))!=0) { code.I = referenceFloat(code,++pos); code.params2 |= 1; code.params |= 4096; }
+        if((pos = strchr(line,'J'))!=0) { code.J = referenceFloat(code,++pos); code.params2 |= 2; code.params |= 4096; }
+        if((pos = strchr(line,'R'))!=0) { code.R = referenceFloat(code,++pos); code.params2 |= 4; code.params |= 4096; }
+    }
+    if((pos = strchr(line,'*'))!=0)
+    {
+        uint8_t checksum_given = referenceLong(code,pos+1);
+        uint8_t checksum = 0;
+        while(line!=pos) checksum ^= *line++;
+        if(checksum!=checksum_given) return false;
+    }
+    return (code.params2 & 32768)==0 && (code.params & 518)!=0;
+}
+
+/** Number of differences between the reference result and code, floats are compared bitwise. */
+static int compareParsed(ReferenceCode &ref,GCode &code)
+{
+    unsigned int params = code.hasN() | code.hasM()<<1 | code.hasG()<<2 | code.hasX()<<3 | code.hasY()<<4 | code.hasZ()<<5 |
+                          code.hasE()<<6 | code.hasF()<<8 | code.hasT()<<9 | code.hasS()<<10 | code.hasP()<<11 | code.isV2()<<12 |
+                          code.hasString()<<15;
+    unsigned int params2 = code.hasI() | code.hasJ()<<1 | code.hasR()<<2 | code.hasFormatError()<<15;
+    if(params != ref.params || params2 != ref.params2) return 1;
+    int errors = 0;
+    if(code.hasN() && (ref.lineNumber & 0xffff) != code.N) errors++;
+    if(code.hasM() && ref.M != code.M) errors++;
+    if(code.hasG() && ref.G != code.G) errors++;
+    if(code.hasX() && memcmp(&ref.X,&code.X,sizeof(float))) errors++;
+    if(code.hasY() && memcmp(&ref.Y,&code.Y,sizeof(float))) errors++;
+    if(code.hasZ() && memcmp(&ref.Z,&code.Z,sizeof(float))) errors++;
+    if(code.hasE() && memcmp(&ref.E,&code.E,sizeof(float))) errors++;
+    if(code.hasF() && memcmp(&ref.F,&code.F,sizeof(float))) errors++;
+    if(code.hasT() && ref.T != code.T) errors++;
+    if(code.hasS() && ref.S != code.S) errors++;
+    if(code.hasP() && ref.P != code.P) errors++;
+    if(code.hasI() && memcmp(&ref.I,&code.I,sizeof(float))) errors++;
+    if(code.hasJ() && memcmp(&ref.J,&code.J,sizeof(float))) errors++;
+    if(code.hasR() && memcmp(&ref.R,&code.R,sizeof(float))) errors++;
+    if(code.hasString() && strcmp(ref.text,code.text)) errors++;
+    return errors;
+}
+
+/**
+  Parses all lines of the file and 200000 generated moves with GCode::parseAscii and the former
+  strtod based parser, counts results that are not bitwise identical and times both parsers.
+*/
+void Simulation::checkParser(FILE *in)
+{
+    std::vector<std::string> lines;
+    char buf[SIM_SERIAL_LINE_SIZE];
+    while(fgets(buf,sizeof(buf),in))
+    {
+        char *comment = strchr(buf,';');
+        if(comment) *comment = 0;
+        int len = strlen(buf);
+        while(len > 0 && (unsigned char)buf[len-1] <= ' ') len--;
+        buf[len] = 0;
+        if(len) lines.push_back(buf);
+    }
+    size_t fileLines = lines.size();
+    srand(1);
+    for(int i=0; i<200000; i++)
+    {
+        int decimals = rand() % 7;
+        double scale = pow(10.0,decimals);
+        sprintf(buf,"N%d G1 X%.*f Y%.*f E%.*f F%d",i,decimals,(rand()-RAND_MAX/2)/scale,decimals,(rand() % 3000000)/scale,
+                decimals,(rand() % 100000)/scale,rand() % 12000);
+        uint8_t checksum = 0;
+        for(char *p = buf; *p; p++) checksum ^= *p;
+        sprintf(buf+strlen(buf),"*%d",checksum);
+        lines.push_back(buf);
+    }
+    for(int part=0; part<2; part++)
+    {
+        size_t first = part ? fileLines : 0, last = part ? lines.size() : fileLines;
+        unsigned long mismatches = 0,repeats = 1;
+        for(size_t i=first; i<last; i++)
+        {
+            ReferenceCode ref;
+            GCode code;
+            strcpy(buf,lines[i].c_str());
+            bool refOk = referenceParseAscii(ref,buf);
+            strcpy(buf,lines[i].c_str());
+            bool ok = code.parseAscii(buf,false);
+            if(compareParsed(ref,code) || (ok != refOk && !code.hasFormatError() && (code.hasG() || code.hasM() || code.hasT())))
+            {
+                if(mismatches++ < 10) fprintf(stderr,"Parser mismatch: %s\n",lines[i].c_str());
+            }
+        }
+        if(last > first) repeats = 2000000/(last-first)+1;
+        uint64_t parseTime = 0,referenceTime = 0;
+        volatile float sink = 0;
+        for(int pass=0; pass<2; pass++)
+        {
+            uint64_t start = hostNanos();
+            for(unsigned long r=0; r<repeats; r++)
+                for(size_t i=first; i<last; i++)
+                {
+                    strcpy(buf,lines[i].c_str());
+                    if(pass == 0)
+                    {
+                        GCode code;
+                        code.parseAscii(buf,false);
+                        sink += code.X;
+                    }
+                    else
+                    {
+                        ReferenceCode ref;
+                        referenceParseAscii(ref,buf);
+                        sink += ref.X;
+                    }
+                }
+            if(pass == 0) parseTime = hostNanos()-start;
+            else referenceTime = hostNanos()-start;
+        }
+        double commands = (double)repeats*(last-first);
+        fprintf(stderr,"%-22s%lu lines, %lu not identical, %.0f commands/s, strtod parser %.0f commands/s\n",
+                part ? "Parser generated:" : "Parser file:",(unsigned long)(last-first),mismatches,
+                parseTime ? commands*1e9/parseTime : 0.0,referenceTime ? commands*1e9/referenceTime : 0.0);
+    }
+}
+
+unsigned long millis()
+{
+    return HAL::timeInMilliseconds();
+}
+void delay(unsigned long ms)
+{
+    HAL::delayMilliseconds(ms);
+}
+
+extern void setup();
+extern void loop();
+
+static void interrupted(int sig)
+{
+    fprintf(stderr,"Simulation interrupted\n");
+    Simulation::report();
+    _exit(2);
+}
+
+static void usage()
+{
+    fprintf(stderr,"Usage: repetier-sim [options] file.gcode\n"
+            "       repetier-sim [options] -t link\n"
+            " -b baud    Serial speed, default is the configured baudrate\n"
+            " -c factor  Add host cpu time multiplied with factor to the virtual time, default 0\n"
+            " -p us      Virtual time each poll of the main loop costs, default 20\n"
+            " -o file    Write firmware output to file\n"
+            " -w         Writes wait while the 64 byte output buffer is full\n"
+            " -s file    Write step events (ticks axis direction) to file\n"
+            " -l file    Write interrupt times (ticks T|S host-ns) to file\n"
+            " -t link    Connect the serial port to a pseudo terminal linked to link\n"
+            " -k         Check and time the delta kinematics instead of running file.gcode\n"
+            " -g         Check and time the ASCII parser on file.gcode instead of running it\n");
+    exit(1);
+}
+
+int main(int argc,char **argv)
+{
+    int opt;
+    bool kinematics = false,parser = false;
+    const char *link = NULL;
+    while((opt = getopt(argc,argv,"b:c:p:o:ws:l:t:kg")) != -1)
+    {
+        switch(opt)
+        {
+        case 'b':
+            forcedBaudrate = atol(optarg);
+            break;
+        case 'c':
+            Simulation::cpuFactor = atof(optarg);
+            break;
+        case 'p':
+            Simulation::pollTicks = (uint64_t)(atof(optarg)*(F_CPU/1000000));
+            break;
+        case 'o':
+            Simulation::serial.echo = fopen(optarg,"w");
+            if(Simulation::serial.echo) setvbuf(Simulation::serial.echo,NULL,_IOLBF,0);
+            break;
+        case 'w':
+            Simulation::serial.modelOutput = true;
+            break;
+        case 's':
+            Simulation::stepLog = fopen(optarg,"w");
+            break;
+        case 'l':
+            Simulation::isrLog = fopen(optarg,"w");
+            break;
+        case 't':
+            link = optarg;
+            break;
+        case 'k':
+            kinematics = true;
+            break;
+        case 'g':
+            parser = true;
+            break;
+        default:
+            usage();
+        }
+    }
+    if(kinematics)
+    {
+#if DRIVE_SYSTEM==3
+        Simulation::init();
+        setup();
+        Simulation::checkDeltaKinematics();
+        return 0;
+#else
+        fprintf(stderr,"The configuration is not a delta printer\n");
+        return 1;
+#endif
+    }
+    if(link)
+    {
+        if(!Simulation::serial.openTerminal(link))
+        {
+            perror(link);
+            return 1;
+        }
+    }
+    else
+    {
+        if(optind >= argc) usage();
+        Simulation::serial.input = fopen(argv[optind],"r");
+        if(Simulation::serial.input == NULL)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+    if(parser)
+    {
+        Simulation::init();
+        setup();
+        Simulation::checkParser(Simulation::serial.input);
+        return 0;
+    }
+    signal(SIGINT,interrupted);
+    signal(SIGTERM,interrupted);
+    Simulation::init();
+    setup();
+    for(;;)
+        loop();
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*
+    This file is part of Repetier-Firmware.
+
+    Repetier-Firmware is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Repetier-Firmware is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Repetier-Firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#define SIM_NUM_PINS 256
+#define SIM_EEPROM_SIZE 4096
+#define SIM_SERIAL_IN_SIZE 128
+#define SIM_SERIAL_LINE_SIZE 256
+#define SIM_SERIAL_OUT_SIZE 64 // like SERIAL_TX_BUFFER_SIZE of the AVR serial driver
+#define SIM_QUEUE_DEPTHS 256
+
+class PrintLine;
+
+/** \brief File backed serial port.
+
+Input comes from a G-code file. Like a host using character counting, the next line is only
+sent if it fits into the firmware receive buffer together with all unacknowledged lines.
+Bytes arrive with the speed given by the baudrate, measured in virtual time.
+Output is parsed for ok and optionally copied to a log file. With a modelled output buffer each
+byte leaves it after the time of one byte and writes wait while it is full, like the AVR serial
+driver. Lines still reach the host when they are written.
+Alternatively a pseudo terminal connects the firmware to a real host program. Then bytes
+arrive as soon as the host writes them and the host does all flow control.
+*/
+class SimulationSerial
+{
+public:
+    FILE *input;
+    FILE *echo;
+    uint8_t rxBuffer[SIM_SERIAL_IN_SIZE];
+    uint8_t rxHead,rxTail;
+    char line[SIM_SERIAL_LINE_SIZE]; ///< Line currently transmitted
+    int linePos,lineLength;
+    bool lineQueued;                ///< Current line is counted as unacknowledged
+    int unacknowledged[SIM_SERIAL_IN_SIZE]; ///< Length of lines sent but not acknowledged
+    uint8_t ackHead,ackTail;
+    int unacknowledgedBytes;
+    char outLine[SIM_SERIAL_LINE_SIZE];
+    int outPos;
+    int binaryLeft;                 ///< Bytes missing of a binary report in outLine, -1 = length byte follows
+    uint64_t ticksPerByte;
+    uint64_t nextByteTime;
+    unsigned long linesSent;
+    unsigned long linesFiltered;
+    bool inputFinished;
+    int terminal;                   ///< Master side of the pseudo terminal, -1 = read from input
+    bool modelOutput;               ///< Writes wait for room in an output buffer of SIM_SERIAL_OUT_SIZE
+    uint64_t outputEndTime;         ///< Time the last written byte has left the output buffer
+    uint64_t outputWaitTime;        ///< Time writes waited for a full output buffer
+    unsigned long outputWaits;
+    bool hostConnected,hostClosed;
+
+    SimulationSerial() : binaryLeft(0),terminal(-1),modelOutput(false),outputEndTime(0),outputWaitTime(0),outputWaits(0) {}
+    bool openTerminal(const char *link);
+    void begin(unsigned long baud);
+    int available();
+    int read();
+    void write(uint8_t c);
+    int outputUnused();
+    void flush() {}
+    void transfer();
+    bool finished();
+private:
+    bool nextLine();
+    void lineReceived();
+    void binaryReceived();
+    void sendToHost();
+    void transferTerminal();
+};
+
+class Simulation
+{
+public:
+    enum Probe {PLANNER,PATH_PLANNER,PARSER,PROBE_COUNT};
+    static uint64_t clock;           ///< Virtual time in F_CPU ticks
+    static uint8_t interruptsEnabled;
+    static uint8_t insideInterrupt;
+    static uint8_t pins[SIM_NUM_PINS];
+    static uint8_t endstopPins[SIM_NUM_PINS]; ///< 1 for endstop and z-probe pins
+    static uint8_t eeprom[SIM_EEPROM_SIZE];
+    static SimulationSerial serial;
+    static FILE *stepLog;
+    static FILE *isrLog;             ///< Host time of every stepper and speed update interrupt
+    static uint64_t pollTicks;       ///< Virtual ticks each poll costs
+    static float cpuFactor;          ///< Host nanoseconds are multiplied with this for virtual time, 0 = deterministic
+    static uint64_t timer1Next;
+    static uint64_t pwmNext;
+    static uint64_t timer1Last;      ///< Time of the last stepper interrupt
+    static uint8_t speedUpdatePending;
+    static uint64_t extruderNext;
+    // Statistics
+    static uint64_t probeTime[PROBE_COUNT];
+    static uint64_t probeMax[PROBE_COUNT];
+    static unsigned long probeCalls[PROBE_COUNT];
+    static uint64_t probeStartTime[PROBE_COUNT];
+    static uint64_t depthTime[SIM_QUEUE_DEPTHS];       ///< Path planner time by number of queued moves
+    static unsigned long depthCalls[SIM_QUEUE_DEPTHS];
+    static unsigned long depthSegments[SIM_QUEUE_DEPTHS];
+    static unsigned long depthUpdates[SIM_QUEUE_DEPTHS];
+    static unsigned long plannerSegments; ///< Moves visited by the path planner
+    static unsigned long parameterUpdates; ///< Moves getting new step parameters
+    static unsigned long deltaSegments;      ///< Delta segments measured by SIM_DELTA_SEGMENT_END
+    static double deltaDeviationMax;         ///< Largest carriage deviation in the middle of a segment in steps
+    static double deltaDeviationSum;
+    static long deltaSegmentStartSteps[3];
+    static unsigned long deltaSegmentsComputed;
+    static unsigned long deltaSegmentsLate;  ///< Delta segments the stepper interrupt had to compute itself
+    static unsigned long deltaSegmentClamps; ///< Tower moves limited to the steps per segment of their line
+    static unsigned long rampChecks;         ///< Speed changes of ramps compared with the acceleration of their line
+    static unsigned long rampViolations;     ///< Checks with a higher acceleration than configured
+    static double rampAccelerationMax;       ///< Highest measured acceleration relative to the configured one
+    static unsigned long sCurveRamps;        ///< S-curve ramps computed by updateStepsParameter
+    static unsigned long sCurveJerkRaised;   ///< Ramps of lines too short for the jerk limit
+    static unsigned long sCurveUnshaped;     ///< Ramps too short or too long for an S-curve, with constant acceleration
+    static uint64_t isrTime;
+    static uint64_t isrMax;
+    static unsigned long isrCalls;
+    static uint64_t speedUpdateTime;
+    static uint64_t speedUpdateMax;
+    static unsigned long speedUpdates;        ///< Calls of the speed update interrupt
+    static unsigned long speedUpdatesDropped; ///< Speed updates replaced by a newer request
+    static unsigned long steps[4];
+    static uint64_t lastStep[4];         ///< Time of the last step of each axis
+    static uint64_t lastStepInterval[4];
+    static uint8_t lastStepDir[4];
+    static double stepJitter[4];         ///< Sum of the relative changes of consecutive step intervals
+    static unsigned long jitterCount[4];
+    static unsigned long underruns;
+    static uint64_t stallTime;              ///< Time without moves after underruns until the next move started
+    static bool stalled;
+    static unsigned long stepPulses;        ///< Step pulses: from the first rising step pin until all are low again
+    static unsigned long multiAxisPulses;   ///< Pulses with more than one rising step pin
+    static unsigned long stepPortWrites;    ///< Port writes changing step pins
+    static uint64_t stepPortCycles;         ///< AVR cycles of the instructions of these writes
+    static uint64_t stepSkewSum;            ///< Cycles between first and last rising edge of multi axis pulses
+    static unsigned long stepSkewMax;
+    static unsigned long endstopReads;      ///< Reads of endstop and z-probe pins
+    static unsigned long intervalLookups;   ///< HAL::CPUDivU2 calls served by the interval tables
+    static unsigned long intervalDivisions; ///< HAL::CPUDivU2 calls needing a long division
+    static unsigned long extruderCalls;     ///< Extruder timer interrupts with advance activated
+    static int advancePendingMax;           ///< Most extruder steps waiting after a stepper interrupt
+    static bool moving;
+    static uint64_t firstMove;
+    static uint64_t lastMove;
+
+    static void init();
+    static void poll();
+    static void delay(uint64_t ticks);
+    static void report();
+    static void checkParser(FILE *in);
+    static void rampSpeed(unsigned int v);
+#if DRIVE_SYSTEM==3
+    static void checkDeltaKinematics();
+    static void deltaSegmentStart(long cartesianPosSteps[]);
+    static void deltaSegmentEnd(long cartesianPosSteps[]);
+#endif
+    static uint64_t hostNanos();
+    static void writePin(int pin,uint8_t value);
+    static uint8_t stepPortMask(int pin);
+    static void writeStepPort(uint8_t mask,uint8_t value);
+    static inline uint8_t readPin(int pin)
+    {
+        pin &= SIM_NUM_PINS-1;
+        endstopReads += endstopPins[pin];
+        return pins[pin];
+    }
+    static inline void probeStart(Probe p)
+    {
+        probeStartTime[p] = hostNanos();
+    }
+    static void probeEnd(Probe p);
+private:
+    friend class SimulationSerial; // waits for the output buffer in virtual time
+    static uint64_t lastPoll;
+    static uint64_t hostExcluded;
+    static void advance(uint64_t ticks);
+    static void timer1Interrupt();
+    static uint64_t pulseFirstRise;         ///< stepPortCycles at the first rising edge of the current pulse
+    static uint64_t pulseLastRise;
+    static uint8_t pulseRises;
+    static PrintLine *rampLine;             ///< Line and ramp time of the last checked ramp speed
+    static long rampTimer;
+    static unsigned int rampV;
+    static uint8_t setPin(int pin,uint8_t value);
+    static void stepPortWrite(int pin,bool masked,uint8_t rising);
+    static void pwmInterrupt();
+    static void speedUpdateInterrupt();
+    static void extruderInterrupt();
+};
+
+#endif // SIMULATION_H
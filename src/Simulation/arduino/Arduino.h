@@ -0,0 +1,36 @@
+/*
+  Minimal replacement of the Arduino core header for the host simulation.
+  Only the parts used by the firmware are declared.
+*/
+#ifndef _SIM_ARDUINO_H
+#define _SIM_ARDUINO_H
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define ARDUINO 100
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define _BV(bit) (1 << (bit))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+
+typedef uint8_t boolean;
+typedef uint8_t byte;
+
+extern void pinMode(uint8_t pin,uint8_t mode);
+extern void digitalWrite(uint8_t pin,uint8_t value);
+extern int digitalRead(uint8_t pin);
+extern void analogWrite(uint8_t pin,int value);
+extern unsigned long millis();
+extern void delay(unsigned long ms);
+
+#endif
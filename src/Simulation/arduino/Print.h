@@ -0,0 +1,6 @@
+/*
+  Empty replacement of the Arduino Print class header for the host simulation.
+*/
+#ifndef _SIM_PRINT_H
+#define _SIM_PRINT_H
+#endif
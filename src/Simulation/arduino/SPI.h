@@ -0,0 +1,3 @@
+/*
+  Empty replacement of the Arduino SPI library header for the host simulation.
+*/
@@ -0,0 +1,3 @@
+/*
+  Empty replacement of the Arduino pin header for the host simulation.
+*/
@@ -0,0 +1,1765 @@
+; Sample for the host simulation: spiral of short segments like a sliced perimeter
+G21
+G90
+M82
+M104 S200
+M109 S200
+G92 E0
+G1 Z0.3 F3000
+G1 Z0.30 F3000
+G1 X40.000 Y0.000 F9000
+G1 X39.848 Y3.486 E0.11516 F2400
+G1 X39.392 Y6.946 E0.23031 F2400
+G1 X38.637 Y10.353 E0.34547 F2400
+G1 X37.588 Y13.681 E0.46062 F2400
+G1 X36.252 Y16.905 E0.57578 F2400
+G1 X34.641 Y20.000 E0.69093 F2400
+G1 X32.766 Y22.943 E0.80609 F2400
+G1 X30.642 Y25.712 E0.92124 F2400
+G1 X28.284 Y28.284 E1.03640 F2400
+G1 X25.712 Y30.642 E1.15155 F2400
+G1 X22.943 Y32.766 E1.26671 F2400
+G1 X20.000 Y34.641 E1.38186 F2400
+G1 X16.905 Y36.252 E1.49702 F2400
+G1 X13.681 Y37.588 E1.61217 F2400
+G1 X10.353 Y38.637 E1.72733 F2400
+G1 X6.946 Y39.392 E1.84248 F2400
+G1 X3.486 Y39.848 E1.95764 F2400
+G1 X0.000 Y40.000 E2.07279 F2400
+G1 X-3.486 Y39.848 E2.18795 F2400
+G1 X-6.946 Y39.392 E2.30310 F2400
+G1 X-10.353 Y38.637 E2.41826 F2400
+G1 X-13.681 Y37.588 E2.53341 F2400
+G1 X-16.905 Y36.252 E2.64857 F2400
+G1 X-20.000 Y34.641 E2.76372 F2400
+G1 X-22.943 Y32.766 E2.87888 F2400
+G1 X-25.712 Y30.642 E2.99403 F2400
+G1 X-28.284 Y28.284 E3.10919 F2400
+G1 X-30.642 Y25.712 E3.22435 F2400
+G1 X-32.766 Y22.943 E3.33950 F2400
+G1 X-34.641 Y20.000 E3.45466 F2400
+G1 X-36.252 Y16.905 E3.56981 F2400
+G1 X-37.588 Y13.681 E3.68497 F2400
+G1 X-38.637 Y10.353 E3.80012 F2400
+G1 X-39.392 Y6.946 E3.91528 F2400
+G1 X-39.848 Y3.486 E4.03043 F2400
+G1 X-40.000 Y0.000 E4.14559 F2400
+G1 X-39.848 Y-3.486 E4.26074 F2400
+G1 X-39.392 Y-6.946 E4.37590 F2400
+G1 X-38.637 Y-10.353 E4.49105 F2400
+G1 X-37.588 Y-13.681 E4.60621 F2400
+G1 X-36.252 Y-16.905 E4.72136 F2400
+G1 X-34.641 Y-20.000 E4.83652 F2400
+G1 X-32.766 Y-22.943 E4.95167 F2400
+G1 X-30.642 Y-25.712 E5.06683 F2400
+G1 X-28.284 Y-28.284 E5.18198 F2400
+G1 X-25.712 Y-30.642 E5.29714 F2400
+G1 X-22.943 Y-32.766 E5.41229 F2400
+G1 X-20.000 Y-34.641 E5.52745 F2400
+G1 X-16.905 Y-36.252 E5.64260 F2400
+G1 X-13.681 Y-37.588 E5.75776 F2400
+G1 X-10.353 Y-38.637 E5.87291 F2400
+G1 X-6.946 Y-39.392 E5.98807 F2400
+G1 X-3.486 Y-39.848 E6.10322 F2400
+G1 X-0.000 Y-40.000 E6.21838 F2400
+G1 X3.486 Y-39.848 E6.33354 F2400
+G1 X6.946 Y-39.392 E6.44869 F2400
+G1 X10.353 Y-38.637 E6.56385 F2400
+G1 X13.681 Y-37.588 E6.67900 F2400
+G1 X16.905 Y-36.252 E6.79416 F2400
+G1 X20.000 Y-34.641 E6.90931 F2400
+G1 X22.943 Y-32.766 E7.02447 F2400
+G1 X25.712 Y-30.642 E7.13962 F2400
+G1 X28.284 Y-28.284 E7.25478 F2400
+G1 X30.642 Y-25.712 E7.36993 F2400
+G1 X32.766 Y-22.943 E7.48509 F2400
+G1 X34.641 Y-20.000 E7.60024 F2400
+G1 X36.252 Y-16.905 E7.71540 F2400
+G1 X37.588 Y-13.681 E7.83055 F2400
+G1 X38.637 Y-10.353 E7.94571 F2400
+G1 X39.392 Y-6.946 E8.06086 F2400
+G1 X39.848 Y-3.486 E8.17602 F2400
+G1 X40.000 Y-0.000 E8.29117 F2400
+G1 X36.000 Y0.000 F9000
+G1 X35.863 Y3.138 E8.39481 F2400
+G1 X35.453 Y6.251 E8.49845 F2400
+G1 X34.773 Y9.317 E8.60209 F2400
+G1 X33.829 Y12.313 E8.70573 F2400
+G1 X32.627 Y15.214 E8.80937 F2400
+G1 X31.177 Y18.000 E8.91301 F2400
+G1 X29.489 Y20.649 E9.01665 F2400
+G1 X27.578 Y23.140 E9.12029 F2400
+G1 X25.456 Y25.456 E9.22393 F2400
+G1 X23.140 Y27.578 E9.32757 F2400
+G1 X20.649 Y29.489 E9.43121 F2400
+G1 X18.000 Y31.177 E9.53485 F2400
+G1 X15.214 Y32.627 E9.63849 F2400
+G1 X12.313 Y33.829 E9.74213 F2400
+G1 X9.317 Y34.773 E9.84577 F2400
+G1 X6.251 Y35.453 E9.94941 F2400
+G1 X3.138 Y35.863 E10.05305 F2400
+G1 X0.000 Y36.000 E10.15669 F2400
+G1 X-3.138 Y35.863 E10.26033 F2400
+G1 X-6.251 Y35.453 E10.36397 F2400
+G1 X-9.317 Y34.773 E10.46761 F2400
+G1 X-12.313 Y33.829 E10.57125 F2400
+G1 X-15.214 Y32.627 E10.67489 F2400
+G1 X-18.000 Y31.177 E10.77853 F2400
+G1 X-20.649 Y29.489 E10.88216 F2400
+G1 X-23.140 Y27.578 E10.98580 F2400
+G1 X-25.456 Y25.456 E11.08944 F2400
+G1 X-27.578 Y23.140 E11.19308 F2400
+G1 X-29.489 Y20.649 E11.29672 F2400
+G1 X-31.177 Y18.000 E11.40036 F2400
+G1 X-32.627 Y15.214 E11.50400 F2400
+G1 X-33.829 Y12.313 E11.60764 F2400
+G1 X-34.773 Y9.317 E11.71128 F2400
+G1 X-35.453 Y6.251 E11.81492 F2400
+G1 X-35.863 Y3.138 E11.91856 F2400
+G1 X-36.000 Y0.000 E12.02220 F2400
+G1 X-35.863 Y-3.138 E12.12584 F2400
+G1 X-35.453 Y-6.251 E12.22948 F2400
+G1 X-34.773 Y-9.317 E12.33312 F2400
+G1 X-33.829 Y-12.313 E12.43676 F2400
+G1 X-32.627 Y-15.214 E12.54040 F2400
+G1 X-31.177 Y-18.000 E12.64404 F2400
+G1 X-29.489 Y-20.649 E12.74768 F2400
+G1 X-27.578 Y-23.140 E12.85132 F2400
+G1 X-25.456 Y-25.456 E12.95496 F2400
+G1 X-23.140 Y-27.578 E13.05860 F2400
+G1 X-20.649 Y-29.489 E13.16224 F2400
+G1 X-18.000 Y-31.177 E13.26588 F2400
+G1 X-15.214 Y-32.627 E13.36952 F2400
+G1 X-12.313 Y-33.829 E13.47316 F2400
+G1 X-9.317 Y-34.773 E13.57680 F2400
+G1 X-6.251 Y-35.453 E13.68044 F2400
+G1 X-3.138 Y-35.863 E13.78408 F2400
+G1 X-0.000 Y-36.000 E13.88772 F2400
+G1 X3.138 Y-35.863 E13.99135 F2400
+G1 X6.251 Y-35.453 E14.09499 F2400
+G1 X9.317 Y-34.773 E14.19863 F2400
+G1 X12.313 Y-33.829 E14.30227 F2400
+G1 X15.214 Y-32.627 E14.40591 F2400
+G1 X18.000 Y-31.177 E14.50955 F2400
+G1 X20.649 Y-29.489 E14.61319 F2400
+G1 X23.140 Y-27.578 E14.71683 F2400
+G1 X25.456 Y-25.456 E14.82047 F2400
+G1 X27.578 Y-23.140 E14.92411 F2400
+G1 X29.489 Y-20.649 E15.02775 F2400
+G1 X31.177 Y-18.000 E15.13139 F2400
+G1 X32.627 Y-15.214 E15.23503 F2400
+G1 X33.829 Y-12.313 E15.33867 F2400
+G1 X34.773 Y-9.317 E15.44231 F2400
+G1 X35.453 Y-6.251 E15.54595 F2400
+G1 X35.863 Y-3.138 E15.64959 F2400
+G1 X36.000 Y-0.000 E15.75323 F2400
+G1 X32.000 Y0.000 F9000
+G1 X31.878 Y2.789 E15.84535 F2400
+G1 X31.514 Y5.557 E15.93748 F2400
+G1 X30.910 Y8.282 E16.02960 F2400
+G1 X30.070 Y10.945 E16.12173 F2400
+G1 X29.002 Y13.524 E16.21385 F2400
+G1 X27.713 Y16.000 E16.30597 F2400
+G1 X26.213 Y18.354 E16.39810 F2400
+G1 X24.513 Y20.569 E16.49022 F2400
+G1 X22.627 Y22.627 E16.58235 F2400
+G1 X20.569 Y24.513 E16.67447 F2400
+G1 X18.354 Y26.213 E16.76659 F2400
+G1 X16.000 Y27.713 E16.85872 F2400
+G1 X13.524 Y29.002 E16.95084 F2400
+G1 X10.945 Y30.070 E17.04297 F2400
+G1 X8.282 Y30.910 E17.13509 F2400
+G1 X5.557 Y31.514 E17.22722 F2400
+G1 X2.789 Y31.878 E17.31934 F2400
+G1 X0.000 Y32.000 E17.41146 F2400
+G1 X-2.789 Y31.878 E17.50359 F2400
+G1 X-5.557 Y31.514 E17.59571 F2400
+G1 X-8.282 Y30.910 E17.68784 F2400
+G1 X-10.945 Y30.070 E17.77996 F2400
+G1 X-13.524 Y29.002 E17.87208 F2400
+G1 X-16.000 Y27.713 E17.96421 F2400
+G1 X-18.354 Y26.213 E18.05633 F2400
+G1 X-20.569 Y24.513 E18.14846 F2400
+G1 X-22.627 Y22.627 E18.24058 F2400
+G1 X-24.513 Y20.569 E18.33271 F2400
+G1 X-26.213 Y18.354 E18.42483 F2400
+G1 X-27.713 Y16.000 E18.51695 F2400
+G1 X-29.002 Y13.524 E18.60908 F2400
+G1 X-30.070 Y10.945 E18.70120 F2400
+G1 X-30.910 Y8.282 E18.79333 F2400
+G1 X-31.514 Y5.557 E18.88545 F2400
+G1 X-31.878 Y2.789 E18.97757 F2400
+G1 X-32.000 Y0.000 E19.06970 F2400
+G1 X-31.878 Y-2.789 E19.16182 F2400
+G1 X-31.514 Y-5.557 E19.25395 F2400
+G1 X-30.910 Y-8.282 E19.34607 F2400
+G1 X-30.070 Y-10.945 E19.43819 F2400
+G1 X-29.002 Y-13.524 E19.53032 F2400
+G1 X-27.713 Y-16.000 E19.62244 F2400
+G1 X-26.213 Y-18.354 E19.71457 F2400
+G1 X-24.513 Y-20.569 E19.80669 F2400
+G1 X-22.627 Y-22.627 E19.89882 F2400
+G1 X-20.569 Y-24.513 E19.99094 F2400
+G1 X-18.354 Y-26.213 E20.08306 F2400
+G1 X-16.000 Y-27.713 E20.17519 F2400
+G1 X-13.524 Y-29.002 E20.26731 F2400
+G1 X-10.945 Y-30.070 E20.35944 F2400
+G1 X-8.282 Y-30.910 E20.45156 F2400
+G1 X-5.557 Y-31.514 E20.54368 F2400
+G1 X-2.789 Y-31.878 E20.63581 F2400
+G1 X-0.000 Y-32.000 E20.72793 F2400
+G1 X2.789 Y-31.878 E20.82006 F2400
+G1 X5.557 Y-31.514 E20.91218 F2400
+G1 X8.282 Y-30.910 E21.00431 F2400
+G1 X10.945 Y-30.070 E21.09643 F2400
+G1 X13.524 Y-29.002 E21.18855 F2400
+G1 X16.000 Y-27.713 E21.28068 F2400
+G1 X18.354 Y-26.213 E21.37280 F2400
+G1 X20.569 Y-24.513 E21.46493 F2400
+G1 X22.627 Y-22.627 E21.55705 F2400
+G1 X24.513 Y-20.569 E21.64917 F2400
+G1 X26.213 Y-18.354 E21.74130 F2400
+G1 X27.713 Y-16.000 E21.83342 F2400
+G1 X29.002 Y-13.524 E21.92555 F2400
+G1 X30.070 Y-10.945 E22.01767 F2400
+G1 X30.910 Y-8.282 E22.10980 F2400
+G1 X31.514 Y-5.557 E22.20192 F2400
+G1 X31.878 Y-2.789 E22.29404 F2400
+G1 X32.000 Y-0.000 E22.38617 F2400
+G1 X28.000 Y0.000 F9000
+G1 X27.893 Y2.440 E22.46678 F2400
+G1 X27.575 Y4.862 E22.54738 F2400
+G1 X27.046 Y7.247 E22.62799 F2400
+G1 X26.311 Y9.577 E22.70860 F2400
+G1 X25.377 Y11.833 E22.78921 F2400
+G1 X24.249 Y14.000 E22.86982 F2400
+G1 X22.936 Y16.060 E22.95043 F2400
+G1 X21.449 Y17.998 E23.03104 F2400
+G1 X19.799 Y19.799 E23.11165 F2400
+G1 X17.998 Y21.449 E23.19225 F2400
+G1 X16.060 Y22.936 E23.27286 F2400
+G1 X14.000 Y24.249 E23.35347 F2400
+G1 X11.833 Y25.377 E23.43408 F2400
+G1 X9.577 Y26.311 E23.51469 F2400
+G1 X7.247 Y27.046 E23.59530 F2400
+G1 X4.862 Y27.575 E23.67591 F2400
+G1 X2.440 Y27.893 E23.75651 F2400
+G1 X0.000 Y28.000 E23.83712 F2400
+G1 X-2.440 Y27.893 E23.91773 F2400
+G1 X-4.862 Y27.575 E23.99834 F2400
+G1 X-7.247 Y27.046 E24.07895 F2400
+G1 X-9.577 Y26.311 E24.15956 F2400
+G1 X-11.833 Y25.377 E24.24017 F2400
+G1 X-14.000 Y24.249 E24.32077 F2400
+G1 X-16.060 Y22.936 E24.40138 F2400
+G1 X-17.998 Y21.449 E24.48199 F2400
+G1 X-19.799 Y19.799 E24.56260 F2400
+G1 X-21.449 Y17.998 E24.64321 F2400
+G1 X-22.936 Y16.060 E24.72382 F2400
+G1 X-24.249 Y14.000 E24.80443 F2400
+G1 X-25.377 Y11.833 E24.88503 F2400
+G1 X-26.311 Y9.577 E24.96564 F2400
+G1 X-27.046 Y7.247 E25.04625 F2400
+G1 X-27.575 Y4.862 E25.12686 F2400
+G1 X-27.893 Y2.440 E25.20747 F2400
+G1 X-28.000 Y0.000 E25.28808 F2400
+G1 X-27.893 Y-2.440 E25.36869 F2400
+G1 X-27.575 Y-4.862 E25.44930 F2400
+G1 X-27.046 Y-7.247 E25.52990 F2400
+G1 X-26.311 Y-9.577 E25.61051 F2400
+G1 X-25.377 Y-11.833 E25.69112 F2400
+G1 X-24.249 Y-14.000 E25.77173 F2400
+G1 X-22.936 Y-16.060 E25.85234 F2400
+G1 X-21.449 Y-17.998 E25.93295 F2400
+G1 X-19.799 Y-19.799 E26.01356 F2400
+G1 X-17.998 Y-21.449 E26.09416 F2400
+G1 X-16.060 Y-22.936 E26.17477 F2400
+G1 X-14.000 Y-24.249 E26.25538 F2400
+G1 X-11.833 Y-25.377 E26.33599 F2400
+G1 X-9.577 Y-26.311 E26.41660 F2400
+G1 X-7.247 Y-27.046 E26.49721 F2400
+G1 X-4.862 Y-27.575 E26.57782 F2400
+G1 X-2.440 Y-27.893 E26.65842 F2400
+G1 X-0.000 Y-28.000 E26.73903 F2400
+G1 X2.440 Y-27.893 E26.81964 F2400
+G1 X4.862 Y-27.575 E26.90025 F2400
+G1 X7.247 Y-27.046 E26.98086 F2400
+G1 X9.577 Y-26.311 E27.06147 F2400
+G1 X11.833 Y-25.377 E27.14208 F2400
+G1 X14.000 Y-24.249 E27.22269 F2400
+G1 X16.060 Y-22.936 E27.30329 F2400
+G1 X17.998 Y-21.449 E27.38390 F2400
+G1 X19.799 Y-19.799 E27.46451 F2400
+G1 X21.449 Y-17.998 E27.54512 F2400
+G1 X22.936 Y-16.060 E27.62573 F2400
+G1 X24.249 Y-14.000 E27.70634 F2400
+G1 X25.377 Y-11.833 E27.78695 F2400
+G1 X26.311 Y-9.577 E27.86755 F2400
+G1 X27.046 Y-7.247 E27.94816 F2400
+G1 X27.575 Y-4.862 E28.02877 F2400
+G1 X27.893 Y-2.440 E28.10938 F2400
+G1 X28.000 Y-0.000 E28.18999 F2400
+G1 X24.000 Y0.000 F9000
+G1 X23.909 Y2.092 E28.25908 F2400
+G1 X23.635 Y4.168 E28.32817 F2400
+G1 X23.182 Y6.212 E28.39727 F2400
+G1 X22.553 Y8.208 E28.46636 F2400
+G1 X21.751 Y10.143 E28.53545 F2400
+G1 X20.785 Y12.000 E28.60455 F2400
+G1 X19.660 Y13.766 E28.67364 F2400
+G1 X18.385 Y15.427 E28.74273 F2400
+G1 X16.971 Y16.971 E28.81183 F2400
+G1 X15.427 Y18.385 E28.88092 F2400
+G1 X13.766 Y19.660 E28.95001 F2400
+G1 X12.000 Y20.785 E29.01911 F2400
+G1 X10.143 Y21.751 E29.08820 F2400
+G1 X8.208 Y22.553 E29.15729 F2400
+G1 X6.212 Y23.182 E29.22639 F2400
+G1 X4.168 Y23.635 E29.29548 F2400
+G1 X2.092 Y23.909 E29.36457 F2400
+G1 X0.000 Y24.000 E29.43366 F2400
+G1 X-2.092 Y23.909 E29.50276 F2400
+G1 X-4.168 Y23.635 E29.57185 F2400
+G1 X-6.212 Y23.182 E29.64094 F2400
+G1 X-8.208 Y22.553 E29.71004 F2400
+G1 X-10.143 Y21.751 E29.77913 F2400
+G1 X-12.000 Y20.785 E29.84822 F2400
+G1 X-13.766 Y19.660 E29.91732 F2400
+G1 X-15.427 Y18.385 E29.98641 F2400
+G1 X-16.971 Y16.971 E30.05550 F2400
+G1 X-18.385 Y15.427 E30.12460 F2400
+G1 X-19.660 Y13.766 E30.19369 F2400
+G1 X-20.785 Y12.000 E30.26278 F2400
+G1 X-21.751 Y10.143 E30.33188 F2400
+G1 X-22.553 Y8.208 E30.40097 F2400
+G1 X-23.182 Y6.212 E30.47006 F2400
+G1 X-23.635 Y4.168 E30.53915 F2400
+G1 X-23.909 Y2.092 E30.60825 F2400
+G1 X-24.000 Y0.000 E30.67734 F2400
+G1 X-23.909 Y-2.092 E30.74643 F2400
+G1 X-23.635 Y-4.168 E30.81553 F2400
+G1 X-23.182 Y-6.212 E30.88462 F2400
+G1 X-22.553 Y-8.208 E30.95371 F2400
+G1 X-21.751 Y-10.143 E31.02281 F2400
+G1 X-20.785 Y-12.000 E31.09190 F2400
+G1 X-19.660 Y-13.766 E31.16099 F2400
+G1 X-18.385 Y-15.427 E31.23009 F2400
+G1 X-16.971 Y-16.971 E31.29918 F2400
+G1 X-15.427 Y-18.385 E31.36827 F2400
+G1 X-13.766 Y-19.660 E31.43736 F2400
+G1 X-12.000 Y-20.785 E31.50646 F2400
+G1 X-10.143 Y-21.751 E31.57555 F2400
+G1 X-8.208 Y-22.553 E31.64464 F2400
+G1 X-6.212 Y-23.182 E31.71374 F2400
+G1 X-4.168 Y-23.635 E31.78283 F2400
+G1 X-2.092 Y-23.909 E31.85192 F2400
+G1 X-0.000 Y-24.000 E31.92102 F2400
+G1 X2.092 Y-23.909 E31.99011 F2400
+G1 X4.168 Y-23.635 E32.05920 F2400
+G1 X6.212 Y-23.182 E32.12830 F2400
+G1 X8.208 Y-22.553 E32.19739 F2400
+G1 X10.143 Y-21.751 E32.26648 F2400
+G1 X12.000 Y-20.785 E32.33558 F2400
+G1 X13.766 Y-19.660 E32.40467 F2400
+G1 X15.427 Y-18.385 E32.47376 F2400
+G1 X16.971 Y-16.971 E32.54285 F2400
+G1 X18.385 Y-15.427 E32.61195 F2400
+G1 X19.660 Y-13.766 E32.68104 F2400
+G1 X20.785 Y-12.000 E32.75013 F2400
+G1 X21.751 Y-10.143 E32.81923 F2400
+G1 X22.553 Y-8.208 E32.88832 F2400
+G1 X23.182 Y-6.212 E32.95741 F2400
+G1 X23.635 Y-4.168 E33.02651 F2400
+G1 X23.909 Y-2.092 E33.09560 F2400
+G1 X24.000 Y-0.000 E33.16469 F2400
+G1 X20.000 Y0.000 F9000
+G1 X19.924 Y1.743 E33.22227 F2400
+G1 X19.696 Y3.473 E33.27985 F2400
+G1 X19.319 Y5.176 E33.33743 F2400
+G1 X18.794 Y6.840 E33.39500 F2400
+G1 X18.126 Y8.452 E33.45258 F2400
+G1 X17.321 Y10.000 E33.51016 F2400
+G1 X16.383 Y11.472 E33.56774 F2400
+G1 X15.321 Y12.856 E33.62531 F2400
+G1 X14.142 Y14.142 E33.68289 F2400
+G1 X12.856 Y15.321 E33.74047 F2400
+G1 X11.472 Y16.383 E33.79805 F2400
+G1 X10.000 Y17.321 E33.85562 F2400
+G1 X8.452 Y18.126 E33.91320 F2400
+G1 X6.840 Y18.794 E33.97078 F2400
+G1 X5.176 Y19.319 E34.02836 F2400
+G1 X3.473 Y19.696 E34.08593 F2400
+G1 X1.743 Y19.924 E34.14351 F2400
+G1 X0.000 Y20.000 E34.20109 F2400
+G1 X-1.743 Y19.924 E34.25867 F2400
+G1 X-3.473 Y19.696 E34.31624 F2400
+G1 X-5.176 Y19.319 E34.37382 F2400
+G1 X-6.840 Y18.794 E34.43140 F2400
+G1 X-8.452 Y18.126 E34.48898 F2400
+G1 X-10.000 Y17.321 E34.54655 F2400
+G1 X-11.472 Y16.383 E34.60413 F2400
+G1 X-12.856 Y15.321 E34.66171 F2400
+G1 X-14.142 Y14.142 E34.71929 F2400
+G1 X-15.321 Y12.856 E34.77687 F2400
+G1 X-16.383 Y11.472 E34.83444 F2400
+G1 X-17.321 Y10.000 E34.89202 F2400
+G1 X-18.126 Y8.452 E34.94960 F2400
+G1 X-18.794 Y6.840 E35.00718 F2400
+G1 X-19.319 Y5.176 E35.06475 F2400
+G1 X-19.696 Y3.473 E35.12233 F2400
+G1 X-19.924 Y1.743 E35.17991 F2400
+G1 X-20.000 Y0.000 E35.23749 F2400
+G1 X-19.924 Y-1.743 E35.29506 F2400
+G1 X-19.696 Y-3.473 E35.35264 F2400
+G1 X-19.319 Y-5.176 E35.41022 F2400
+G1 X-18.794 Y-6.840 E35.46780 F2400
+G1 X-18.126 Y-8.452 E35.52537 F2400
+G1 X-17.321 Y-10.000 E35.58295 F2400
+G1 X-16.383 Y-11.472 E35.64053 F2400
+G1 X-15.321 Y-12.856 E35.69811 F2400
+G1 X-14.142 Y-14.142 E35.75568 F2400
+G1 X-12.856 Y-15.321 E35.81326 F2400
+G1 X-11.472 Y-16.383 E35.87084 F2400
+G1 X-10.000 Y-17.321 E35.92842 F2400
+G1 X-8.452 Y-18.126 E35.98599 F2400
+G1 X-6.840 Y-18.794 E36.04357 F2400
+G1 X-5.176 Y-19.319 E36.10115 F2400
+G1 X-3.473 Y-19.696 E36.15873 F2400
+G1 X-1.743 Y-19.924 E36.21630 F2400
+G1 X-0.000 Y-20.000 E36.27388 F2400
+G1 X1.743 Y-19.924 E36.33146 F2400
+G1 X3.473 Y-19.696 E36.38904 F2400
+G1 X5.176 Y-19.319 E36.44662 F2400
+G1 X6.840 Y-18.794 E36.50419 F2400
+G1 X8.452 Y-18.126 E36.56177 F2400
+G1 X10.000 Y-17.321 E36.61935 F2400
+G1 X11.472 Y-16.383 E36.67693 F2400
+G1 X12.856 Y-15.321 E36.73450 F2400
+G1 X14.142 Y-14.142 E36.79208 F2400
+G1 X15.321 Y-12.856 E36.84966 F2400
+G1 X16.383 Y-11.472 E36.90724 F2400
+G1 X17.321 Y-10.000 E36.96481 F2400
+G1 X18.126 Y-8.452 E37.02239 F2400
+G1 X18.794 Y-6.840 E37.07997 F2400
+G1 X19.319 Y-5.176 E37.13755 F2400
+G1 X19.696 Y-3.473 E37.19512 F2400
+G1 X19.924 Y-1.743 E37.25270 F2400
+G1 X20.000 Y-0.000 E37.31028 F2400
+G1 X16.000 Y0.000 F9000
+G1 X15.939 Y1.394 E37.35634 F2400
+G1 X15.757 Y2.778 E37.40240 F2400
+G1 X15.455 Y4.141 E37.44847 F2400
+G1 X15.035 Y5.472 E37.49453 F2400
+G1 X14.501 Y6.762 E37.54059 F2400
+G1 X13.856 Y8.000 E37.58665 F2400
+G1 X13.106 Y9.177 E37.63271 F2400
+G1 X12.257 Y10.285 E37.67878 F2400
+G1 X11.314 Y11.314 E37.72484 F2400
+G1 X10.285 Y12.257 E37.77090 F2400
+G1 X9.177 Y13.106 E37.81696 F2400
+G1 X8.000 Y13.856 E37.86302 F2400
+G1 X6.762 Y14.501 E37.90909 F2400
+G1 X5.472 Y15.035 E37.95515 F2400
+G1 X4.141 Y15.455 E38.00121 F2400
+G1 X2.778 Y15.757 E38.04727 F2400
+G1 X1.394 Y15.939 E38.09333 F2400
+G1 X0.000 Y16.000 E38.13940 F2400
+G1 X-1.394 Y15.939 E38.18546 F2400
+G1 X-2.778 Y15.757 E38.23152 F2400
+G1 X-4.141 Y15.455 E38.27758 F2400
+G1 X-5.472 Y15.035 E38.32364 F2400
+G1 X-6.762 Y14.501 E38.36971 F2400
+G1 X-8.000 Y13.856 E38.41577 F2400
+G1 X-9.177 Y13.106 E38.46183 F2400
+G1 X-10.285 Y12.257 E38.50789 F2400
+G1 X-11.314 Y11.314 E38.55396 F2400
+G1 X-12.257 Y10.285 E38.60002 F2400
+G1 X-13.106 Y9.177 E38.64608 F2400
+G1 X-13.856 Y8.000 E38.69214 F2400
+G1 X-14.501 Y6.762 E38.73820 F2400
+G1 X-15.035 Y5.472 E38.78427 F2400
+G1 X-15.455 Y4.141 E38.83033 F2400
+G1 X-15.757 Y2.778 E38.87639 F2400
+G1 X-15.939 Y1.394 E38.92245 F2400
+G1 X-16.000 Y0.000 E38.96851 F2400
+G1 X-15.939 Y-1.394 E39.01458 F2400
+G1 X-15.757 Y-2.778 E39.06064 F2400
+G1 X-15.455 Y-4.141 E39.10670 F2400
+G1 X-15.035 Y-5.472 E39.15276 F2400
+G1 X-14.501 Y-6.762 E39.19882 F2400
+G1 X-13.856 Y-8.000 E39.24489 F2400
+G1 X-13.106 Y-9.177 E39.29095 F2400
+G1 X-12.257 Y-10.285 E39.33701 F2400
+G1 X-11.314 Y-11.314 E39.38307 F2400
+G1 X-10.285 Y-12.257 E39.42913 F2400
+G1 X-9.177 Y-13.106 E39.47520 F2400
+G1 X-8.000 Y-13.856 E39.52126 F2400
+G1 X-6.762 Y-14.501 E39.56732 F2400
+G1 X-5.472 Y-15.035 E39.61338 F2400
+G1 X-4.141 Y-15.455 E39.65944 F2400
+G1 X-2.778 Y-15.757 E39.70551 F2400
+G1 X-1.394 Y-15.939 E39.75157 F2400
+G1 X-0.000 Y-16.000 E39.79763 F2400
+G1 X1.394 Y-15.939 E39.84369 F2400
+G1 X2.778 Y-15.757 E39.88976 F2400
+G1 X4.141 Y-15.455 E39.93582 F2400
+G1 X5.472 Y-15.035 E39.98188 F2400
+G1 X6.762 Y-14.501 E40.02794 F2400
+G1 X8.000 Y-13.856 E40.07400 F2400
+G1 X9.177 Y-13.106 E40.12007 F2400
+G1 X10.285 Y-12.257 E40.16613 F2400
+G1 X11.314 Y-11.314 E40.21219 F2400
+G1 X12.257 Y-10.285 E40.25825 F2400
+G1 X13.106 Y-9.177 E40.30431 F2400
+G1 X13.856 Y-8.000 E40.35038 F2400
+G1 X14.501 Y-6.762 E40.39644 F2400
+G1 X15.035 Y-5.472 E40.44250 F2400
+G1 X15.455 Y-4.141 E40.48856 F2400
+G1 X15.757 Y-2.778 E40.53462 F2400
+G1 X15.939 Y-1.394 E40.58069 F2400
+G1 X16.000 Y-0.000 E40.62675 F2400
+G1 X12.000 Y0.000 F9000
+G1 X11.954 Y1.046 E40.66129 F2400
+G1 X11.818 Y2.084 E40.69584 F2400
+G1 X11.591 Y3.106 E40.73039 F2400
+G1 X11.276 Y4.104 E40.76493 F2400
+G1 X10.876 Y5.071 E40.79948 F2400
+G1 X10.392 Y6.000 E40.83403 F2400
+G1 X9.830 Y6.883 E40.86857 F2400
+G1 X9.193 Y7.713 E40.90312 F2400
+G1 X8.485 Y8.485 E40.93767 F2400
+G1 X7.713 Y9.193 E40.97221 F2400
+G1 X6.883 Y9.830 E41.00676 F2400
+G1 X6.000 Y10.392 E41.04131 F2400
+G1 X5.071 Y10.876 E41.07585 F2400
+G1 X4.104 Y11.276 E41.11040 F2400
+G1 X3.106 Y11.591 E41.14495 F2400
+G1 X2.084 Y11.818 E41.17949 F2400
+G1 X1.046 Y11.954 E41.21404 F2400
+G1 X0.000 Y12.000 E41.24859 F2400
+G1 X-1.046 Y11.954 E41.28313 F2400
+G1 X-2.084 Y11.818 E41.31768 F2400
+G1 X-3.106 Y11.591 E41.35223 F2400
+G1 X-4.104 Y11.276 E41.38677 F2400
+G1 X-5.071 Y10.876 E41.42132 F2400
+G1 X-6.000 Y10.392 E41.45587 F2400
+G1 X-6.883 Y9.830 E41.49041 F2400
+G1 X-7.713 Y9.193 E41.52496 F2400
+G1 X-8.485 Y8.485 E41.55951 F2400
+G1 X-9.193 Y7.713 E41.59405 F2400
+G1 X-9.830 Y6.883 E41.62860 F2400
+G1 X-10.392 Y6.000 E41.66315 F2400
+G1 X-10.876 Y5.071 E41.69769 F2400
+G1 X-11.276 Y4.104 E41.73224 F2400
+G1 X-11.591 Y3.106 E41.76678 F2400
+G1 X-11.818 Y2.084 E41.80133 F2400
+G1 X-11.954 Y1.046 E41.83588 F2400
+G1 X-12.000 Y0.000 E41.87042 F2400
+G1 X-11.954 Y-1.046 E41.90497 F2400
+G1 X-11.818 Y-2.084 E41.93952 F2400
+G1 X-11.591 Y-3.106 E41.97406 F2400
+G1 X-11.276 Y-4.104 E42.00861 F2400
+G1 X-10.876 Y-5.071 E42.04316 F2400
+G1 X-10.392 Y-6.000 E42.07770 F2400
+G1 X-9.830 Y-6.883 E42.11225 F2400
+G1 X-9.193 Y-7.713 E42.14680 F2400
+G1 X-8.485 Y-8.485 E42.18134 F2400
+G1 X-7.713 Y-9.193 E42.21589 F2400
+G1 X-6.883 Y-9.830 E42.25044 F2400
+G1 X-6.000 Y-10.392 E42.28498 F2400
+G1 X-5.071 Y-10.876 E42.31953 F2400
+G1 X-4.104 Y-11.276 E42.35408 F2400
+G1 X-3.106 Y-11.591 E42.38862 F2400
+G1 X-2.084 Y-11.818 E42.42317 F2400
+G1 X-1.046 Y-11.954 E42.45772 F2400
+G1 X-0.000 Y-12.000 E42.49226 F2400
+G1 X1.046 Y-11.954 E42.52681 F2400
+G1 X2.084 Y-11.818 E42.56136 F2400
+G1 X3.106 Y-11.591 E42.59590 F2400
+G1 X4.104 Y-11.276 E42.63045 F2400
+G1 X5.071 Y-10.876 E42.66500 F2400
+G1 X6.000 Y-10.392 E42.69954 F2400
+G1 X6.883 Y-9.830 E42.73409 F2400
+G1 X7.713 Y-9.193 E42.76863 F2400
+G1 X8.485 Y-8.485 E42.80318 F2400
+G1 X9.193 Y-7.713 E42.83773 F2400
+G1 X9.830 Y-6.883 E42.87227 F2400
+G1 X10.392 Y-6.000 E42.90682 F2400
+G1 X10.876 Y-5.071 E42.94137 F2400
+G1 X11.276 Y-4.104 E42.97591 F2400
+G1 X11.591 Y-3.106 E43.01046 F2400
+G1 X11.818 Y-2.084 E43.04501 F2400
+G1 X11.954 Y-1.046 E43.07955 F2400
+G1 X12.000 Y-0.000 E43.11410 F2400
+G1 Z0.50 F3000
+G1 X40.000 Y0.000 F9000
+G1 X39.848 Y3.486 E43.22926 F2400
+G1 X39.392 Y6.946 E43.34441 F2400
+G1 X38.637 Y10.353 E43.45957 F2400
+G1 X37.588 Y13.681 E43.57472 F2400
+G1 X36.252 Y16.905 E43.68988 F2400
+G1 X34.641 Y20.000 E43.80503 F2400
+G1 X32.766 Y22.943 E43.92019 F2400
+G1 X30.642 Y25.712 E44.03534 F2400
+G1 X28.284 Y28.284 E44.15050 F2400
+G1 X25.712 Y30.642 E44.26565 F2400
+G1 X22.943 Y32.766 E44.38081 F2400
+G1 X20.000 Y34.641 E44.49596 F2400
+G1 X16.905 Y36.252 E44.61112 F2400
+G1 X13.681 Y37.588 E44.72627 F2400
+G1 X10.353 Y38.637 E44.84143 F2400
+G1 X6.946 Y39.392 E44.95658 F2400
+G1 X3.486 Y39.848 E45.07174 F2400
+G1 X0.000 Y40.000 E45.18689 F2400
+G1 X-3.486 Y39.848 E45.30205 F2400
+G1 X-6.946 Y39.392 E45.41720 F2400
+G1 X-10.353 Y38.637 E45.53236 F2400
+G1 X-13.681 Y37.588 E45.64751 F2400
+G1 X-16.905 Y36.252 E45.76267 F2400
+G1 X-20.000 Y34.641 E45.87782 F2400
+G1 X-22.943 Y32.766 E45.99298 F2400
+G1 X-25.712 Y30.642 E46.10814 F2400
+G1 X-28.284 Y28.284 E46.22329 F2400
+G1 X-30.642 Y25.712 E46.33845 F2400
+G1 X-32.766 Y22.943 E46.45360 F2400
+G1 X-34.641 Y20.000 E46.56876 F2400
+G1 X-36.252 Y16.905 E46.68391 F2400
+G1 X-37.588 Y13.681 E46.79907 F2400
+G1 X-38.637 Y10.353 E46.91422 F2400
+G1 X-39.392 Y6.946 E47.02938 F2400
+G1 X-39.848 Y3.486 E47.14453 F2400
+G1 X-40.000 Y0.000 E47.25969 F2400
+G1 X-39.848 Y-3.486 E47.37484 F2400
+G1 X-39.392 Y-6.946 E47.49000 F2400
+G1 X-38.637 Y-10.353 E47.60515 F2400
+G1 X-37.588 Y-13.681 E47.72031 F2400
+G1 X-36.252 Y-16.905 E47.83546 F2400
+G1 X-34.641 Y-20.000 E47.95062 F2400
+G1 X-32.766 Y-22.943 E48.06577 F2400
+G1 X-30.642 Y-25.712 E48.18093 F2400
+G1 X-28.284 Y-28.284 E48.29608 F2400
+G1 X-25.712 Y-30.642 E48.41124 F2400
+G1 X-22.943 Y-32.766 E48.52639 F2400
+G1 X-20.000 Y-34.641 E48.64155 F2400
+G1 X-16.905 Y-36.252 E48.75670 F2400
+G1 X-13.681 Y-37.588 E48.87186 F2400
+G1 X-10.353 Y-38.637 E48.98701 F2400
+G1 X-6.946 Y-39.392 E49.10217 F2400
+G1 X-3.486 Y-39.848 E49.21733 F2400
+G1 X-0.000 Y-40.000 E49.33248 F2400
+G1 X3.486 Y-39.848 E49.44764 F2400
+G1 X6.946 Y-39.392 E49.56279 F2400
+G1 X10.353 Y-38.637 E49.67795 F2400
+G1 X13.681 Y-37.588 E49.79310 F2400
+G1 X16.905 Y-36.252 E49.90826 F2400
+G1 X20.000 Y-34.641 E50.02341 F2400
+G1 X22.943 Y-32.766 E50.13857 F2400
+G1 X25.712 Y-30.642 E50.25372 F2400
+G1 X28.284 Y-28.284 E50.36888 F2400
+G1 X30.642 Y-25.712 E50.48403 F2400
+G1 X32.766 Y-22.943 E50.59919 F2400
+G1 X34.641 Y-20.000 E50.71434 F2400
+G1 X36.252 Y-16.905 E50.82950 F2400
+G1 X37.588 Y-13.681 E50.94465 F2400
+G1 X38.637 Y-10.353 E51.05981 F2400
+G1 X39.392 Y-6.946 E51.17496 F2400
+G1 X39.848 Y-3.486 E51.29012 F2400
+G1 X40.000 Y-0.000 E51.40527 F2400
+G1 X36.000 Y0.000 F9000
+G1 X35.863 Y3.138 E51.50891 F2400
+G1 X35.453 Y6.251 E51.61255 F2400
+G1 X34.773 Y9.317 E51.71619 F2400
+G1 X33.829 Y12.313 E51.81983 F2400
+G1 X32.627 Y15.214 E51.92347 F2400
+G1 X31.177 Y18.000 E52.02711 F2400
+G1 X29.489 Y20.649 E52.13075 F2400
+G1 X27.578 Y23.140 E52.23439 F2400
+G1 X25.456 Y25.456 E52.33803 F2400
+G1 X23.140 Y27.578 E52.44167 F2400
+G1 X20.649 Y29.489 E52.54531 F2400
+G1 X18.000 Y31.177 E52.64895 F2400
+G1 X15.214 Y32.627 E52.75259 F2400
+G1 X12.313 Y33.829 E52.85623 F2400
+G1 X9.317 Y34.773 E52.95987 F2400
+G1 X6.251 Y35.453 E53.06351 F2400
+G1 X3.138 Y35.863 E53.16715 F2400
+G1 X0.000 Y36.000 E53.27079 F2400
+G1 X-3.138 Y35.863 E53.37443 F2400
+G1 X-6.251 Y35.453 E53.47807 F2400
+G1 X-9.317 Y34.773 E53.58171 F2400
+G1 X-12.313 Y33.829 E53.68535 F2400
+G1 X-15.214 Y32.627 E53.78899 F2400
+G1 X-18.000 Y31.177 E53.89263 F2400
+G1 X-20.649 Y29.489 E53.99627 F2400
+G1 X-23.140 Y27.578 E54.09990 F2400
+G1 X-25.456 Y25.456 E54.20354 F2400
+G1 X-27.578 Y23.140 E54.30718 F2400
+G1 X-29.489 Y20.649 E54.41082 F2400
+G1 X-31.177 Y18.000 E54.51446 F2400
+G1 X-32.627 Y15.214 E54.61810 F2400
+G1 X-33.829 Y12.313 E54.72174 F2400
+G1 X-34.773 Y9.317 E54.82538 F2400
+G1 X-35.453 Y6.251 E54.92902 F2400
+G1 X-35.863 Y3.138 E55.03266 F2400
+G1 X-36.000 Y0.000 E55.13630 F2400
+G1 X-35.863 Y-3.138 E55.23994 F2400
+G1 X-35.453 Y-6.251 E55.34358 F2400
+G1 X-34.773 Y-9.317 E55.44722 F2400
+G1 X-33.829 Y-12.313 E55.55086 F2400
+G1 X-32.627 Y-15.214 E55.65450 F2400
+G1 X-31.177 Y-18.000 E55.75814 F2400
+G1 X-29.489 Y-20.649 E55.86178 F2400
+G1 X-27.578 Y-23.140 E55.96542 F2400
+G1 X-25.456 Y-25.456 E56.06906 F2400
+G1 X-23.140 Y-27.578 E56.17270 F2400
+G1 X-20.649 Y-29.489 E56.27634 F2400
+G1 X-18.000 Y-31.177 E56.37998 F2400
+G1 X-15.214 Y-32.627 E56.48362 F2400
+G1 X-12.313 Y-33.829 E56.58726 F2400
+G1 X-9.317 Y-34.773 E56.69090 F2400
+G1 X-6.251 Y-35.453 E56.79454 F2400
+G1 X-3.138 Y-35.863 E56.89818 F2400
+G1 X-0.000 Y-36.000 E57.00182 F2400
+G1 X3.138 Y-35.863 E57.10546 F2400
+G1 X6.251 Y-35.453 E57.20909 F2400
+G1 X9.317 Y-34.773 E57.31273 F2400
+G1 X12.313 Y-33.829 E57.41637 F2400
+G1 X15.214 Y-32.627 E57.52001 F2400
+G1 X18.000 Y-31.177 E57.62365 F2400
+G1 X20.649 Y-29.489 E57.72729 F2400
+G1 X23.140 Y-27.578 E57.83093 F2400
+G1 X25.456 Y-25.456 E57.93457 F2400
+G1 X27.578 Y-23.140 E58.03821 F2400
+G1 X29.489 Y-20.649 E58.14185 F2400
+G1 X31.177 Y-18.000 E58.24549 F2400
+G1 X32.627 Y-15.214 E58.34913 F2400
+G1 X33.829 Y-12.313 E58.45277 F2400
+G1 X34.773 Y-9.317 E58.55641 F2400
+G1 X35.453 Y-6.251 E58.66005 F2400
+G1 X35.863 Y-3.138 E58.76369 F2400
+G1 X36.000 Y-0.000 E58.86733 F2400
+G1 X32.000 Y0.000 F9000
+G1 X31.878 Y2.789 E58.95945 F2400
+G1 X31.514 Y5.557 E59.05158 F2400
+G1 X30.910 Y8.282 E59.14370 F2400
+G1 X30.070 Y10.945 E59.23583 F2400
+G1 X29.002 Y13.524 E59.32795 F2400
+G1 X27.713 Y16.000 E59.42007 F2400
+G1 X26.213 Y18.354 E59.51220 F2400
+G1 X24.513 Y20.569 E59.60432 F2400
+G1 X22.627 Y22.627 E59.69645 F2400
+G1 X20.569 Y24.513 E59.78857 F2400
+G1 X18.354 Y26.213 E59.88069 F2400
+G1 X16.000 Y27.713 E59.97282 F2400
+G1 X13.524 Y29.002 E60.06494 F2400
+G1 X10.945 Y30.070 E60.15707 F2400
+G1 X8.282 Y30.910 E60.24919 F2400
+G1 X5.557 Y31.514 E60.34132 F2400
+G1 X2.789 Y31.878 E60.43344 F2400
+G1 X0.000 Y32.000 E60.52556 F2400
+G1 X-2.789 Y31.878 E60.61769 F2400
+G1 X-5.557 Y31.514 E60.70981 F2400
+G1 X-8.282 Y30.910 E60.80194 F2400
+G1 X-10.945 Y30.070 E60.89406 F2400
+G1 X-13.524 Y29.002 E60.98618 F2400
+G1 X-16.000 Y27.713 E61.07831 F2400
+G1 X-18.354 Y26.213 E61.17043 F2400
+G1 X-20.569 Y24.513 E61.26256 F2400
+G1 X-22.627 Y22.627 E61.35468 F2400
+G1 X-24.513 Y20.569 E61.44681 F2400
+G1 X-26.213 Y18.354 E61.53893 F2400
+G1 X-27.713 Y16.000 E61.63105 F2400
+G1 X-29.002 Y13.524 E61.72318 F2400
+G1 X-30.070 Y10.945 E61.81530 F2400
+G1 X-30.910 Y8.282 E61.90743 F2400
+G1 X-31.514 Y5.557 E61.99955 F2400
+G1 X-31.878 Y2.789 E62.09167 F2400
+G1 X-32.000 Y0.000 E62.18380 F2400
+G1 X-31.878 Y-2.789 E62.27592 F2400
+G1 X-31.514 Y-5.557 E62.36805 F2400
+G1 X-30.910 Y-8.282 E62.46017 F2400
+G1 X-30.070 Y-10.945 E62.55230 F2400
+G1 X-29.002 Y-13.524 E62.64442 F2400
+G1 X-27.713 Y-16.000 E62.73654 F2400
+G1 X-26.213 Y-18.354 E62.82867 F2400
+G1 X-24.513 Y-20.569 E62.92079 F2400
+G1 X-22.627 Y-22.627 E63.01292 F2400
+G1 X-20.569 Y-24.513 E63.10504 F2400
+G1 X-18.354 Y-26.213 E63.19716 F2400
+G1 X-16.000 Y-27.713 E63.28929 F2400
+G1 X-13.524 Y-29.002 E63.38141 F2400
+G1 X-10.945 Y-30.070 E63.47354 F2400
+G1 X-8.282 Y-30.910 E63.56566 F2400
+G1 X-5.557 Y-31.514 E63.65778 F2400
+G1 X-2.789 Y-31.878 E63.74991 F2400
+G1 X-0.000 Y-32.000 E63.84203 F2400
+G1 X2.789 Y-31.878 E63.93416 F2400
+G1 X5.557 Y-31.514 E64.02628 F2400
+G1 X8.282 Y-30.910 E64.11841 F2400
+G1 X10.945 Y-30.070 E64.21053 F2400
+G1 X13.524 Y-29.002 E64.30265 F2400
+G1 X16.000 Y-27.713 E64.39478 F2400
+G1 X18.354 Y-26.213 E64.48690 F2400
+G1 X20.569 Y-24.513 E64.57903 F2400
+G1 X22.627 Y-22.627 E64.67115 F2400
+G1 X24.513 Y-20.569 E64.76327 F2400
+G1 X26.213 Y-18.354 E64.85540 F2400
+G1 X27.713 Y-16.000 E64.94752 F2400
+G1 X29.002 Y-13.524 E65.03965 F2400
+G1 X30.070 Y-10.945 E65.13177 F2400
+G1 X30.910 Y-8.282 E65.22390 F2400
+G1 X31.514 Y-5.557 E65.31602 F2400
+G1 X31.878 Y-2.789 E65.40814 F2400
+G1 X32.000 Y-0.000 E65.50027 F2400
+G1 X28.000 Y0.000 F9000
+G1 X27.893 Y2.440 E65.58088 F2400
+G1 X27.575 Y4.862 E65.66149 F2400
+G1 X27.046 Y7.247 E65.74209 F2400
+G1 X26.311 Y9.577 E65.82270 F2400
+G1 X25.377 Y11.833 E65.90331 F2400
+G1 X24.249 Y14.000 E65.98392 F2400
+G1 X22.936 Y16.060 E66.06453 F2400
+G1 X21.449 Y17.998 E66.14514 F2400
+G1 X19.799 Y19.799 E66.22575 F2400
+G1 X17.998 Y21.449 E66.30635 F2400
+G1 X16.060 Y22.936 E66.38696 F2400
+G1 X14.000 Y24.249 E66.46757 F2400
+G1 X11.833 Y25.377 E66.54818 F2400
+G1 X9.577 Y26.311 E66.62879 F2400
+G1 X7.247 Y27.046 E66.70940 F2400
+G1 X4.862 Y27.575 E66.79001 F2400
+G1 X2.440 Y27.893 E66.87061 F2400
+G1 X0.000 Y28.000 E66.95122 F2400
+G1 X-2.440 Y27.893 E67.03183 F2400
+G1 X-4.862 Y27.575 E67.11244 F2400
+G1 X-7.247 Y27.046 E67.19305 F2400
+G1 X-9.577 Y26.311 E67.27366 F2400
+G1 X-11.833 Y25.377 E67.35427 F2400
+G1 X-14.000 Y24.249 E67.43487 F2400
+G1 X-16.060 Y22.936 E67.51548 F2400
+G1 X-17.998 Y21.449 E67.59609 F2400
+G1 X-19.799 Y19.799 E67.67670 F2400
+G1 X-21.449 Y17.998 E67.75731 F2400
+G1 X-22.936 Y16.060 E67.83792 F2400
+G1 X-24.249 Y14.000 E67.91853 F2400
+G1 X-25.377 Y11.833 E67.99914 F2400
+G1 X-26.311 Y9.577 E68.07974 F2400
+G1 X-27.046 Y7.247 E68.16035 F2400
+G1 X-27.575 Y4.862 E68.24096 F2400
+G1 X-27.893 Y2.440 E68.32157 F2400
+G1 X-28.000 Y0.000 E68.40218 F2400
+G1 X-27.893 Y-2.440 E68.48279 F2400
+G1 X-27.575 Y-4.862 E68.56340 F2400
+G1 X-27.046 Y-7.247 E68.64400 F2400
+G1 X-26.311 Y-9.577 E68.72461 F2400
+G1 X-25.377 Y-11.833 E68.80522 F2400
+G1 X-24.249 Y-14.000 E68.88583 F2400
+G1 X-22.936 Y-16.060 E68.96644 F2400
+G1 X-21.449 Y-17.998 E69.04705 F2400
+G1 X-19.799 Y-19.799 E69.12766 F2400
+G1 X-17.998 Y-21.449 E69.20826 F2400
+G1 X-16.060 Y-22.936 E69.28887 F2400
+G1 X-14.000 Y-24.249 E69.36948 F2400
+G1 X-11.833 Y-25.377 E69.45009 F2400
+G1 X-9.577 Y-26.311 E69.53070 F2400
+G1 X-7.247 Y-27.046 E69.61131 F2400
+G1 X-4.862 Y-27.575 E69.69192 F2400
+G1 X-2.440 Y-27.893 E69.77253 F2400
+G1 X-0.000 Y-28.000 E69.85313 F2400
+G1 X2.440 Y-27.893 E69.93374 F2400
+G1 X4.862 Y-27.575 E70.01435 F2400
+G1 X7.247 Y-27.046 E70.09496 F2400
+G1 X9.577 Y-26.311 E70.17557 F2400
+G1 X11.833 Y-25.377 E70.25618 F2400
+G1 X14.000 Y-24.249 E70.33679 F2400
+G1 X16.060 Y-22.936 E70.41739 F2400
+G1 X17.998 Y-21.449 E70.49800 F2400
+G1 X19.799 Y-19.799 E70.57861 F2400
+G1 X21.449 Y-17.998 E70.65922 F2400
+G1 X22.936 Y-16.060 E70.73983 F2400
+G1 X24.249 Y-14.000 E70.82044 F2400
+G1 X25.377 Y-11.833 E70.90105 F2400
+G1 X26.311 Y-9.577 E70.98165 F2400
+G1 X27.046 Y-7.247 E71.06226 F2400
+G1 X27.575 Y-4.862 E71.14287 F2400
+G1 X27.893 Y-2.440 E71.22348 F2400
+G1 X28.000 Y-0.000 E71.30409 F2400
+G1 X24.000 Y0.000 F9000
+G1 X23.909 Y2.092 E71.37318 F2400
+G1 X23.635 Y4.168 E71.44228 F2400
+G1 X23.182 Y6.212 E71.51137 F2400
+G1 X22.553 Y8.208 E71.58046 F2400
+G1 X21.751 Y10.143 E71.64955 F2400
+G1 X20.785 Y12.000 E71.71865 F2400
+G1 X19.660 Y13.766 E71.78774 F2400
+G1 X18.385 Y15.427 E71.85683 F2400
+G1 X16.971 Y16.971 E71.92593 F2400
+G1 X15.427 Y18.385 E71.99502 F2400
+G1 X13.766 Y19.660 E72.06411 F2400
+G1 X12.000 Y20.785 E72.13321 F2400
+G1 X10.143 Y21.751 E72.20230 F2400
+G1 X8.208 Y22.553 E72.27139 F2400
+G1 X6.212 Y23.182 E72.34049 F2400
+G1 X4.168 Y23.635 E72.40958 F2400
+G1 X2.092 Y23.909 E72.47867 F2400
+G1 X0.000 Y24.000 E72.54777 F2400
+G1 X-2.092 Y23.909 E72.61686 F2400
+G1 X-4.168 Y23.635 E72.68595 F2400
+G1 X-6.212 Y23.182 E72.75504 F2400
+G1 X-8.208 Y22.553 E72.82414 F2400
+G1 X-10.143 Y21.751 E72.89323 F2400
+G1 X-12.000 Y20.785 E72.96232 F2400
+G1 X-13.766 Y19.660 E73.03142 F2400
+G1 X-15.427 Y18.385 E73.10051 F2400
+G1 X-16.971 Y16.971 E73.16960 F2400
+G1 X-18.385 Y15.427 E73.23870 F2400
+G1 X-19.660 Y13.766 E73.30779 F2400
+G1 X-20.785 Y12.000 E73.37688 F2400
+G1 X-21.751 Y10.143 E73.44598 F2400
+G1 X-22.553 Y8.208 E73.51507 F2400
+G1 X-23.182 Y6.212 E73.58416 F2400
+G1 X-23.635 Y4.168 E73.65325 F2400
+G1 X-23.909 Y2.092 E73.72235 F2400
+G1 X-24.000 Y0.000 E73.79144 F2400
+G1 X-23.909 Y-2.092 E73.86053 F2400
+G1 X-23.635 Y-4.168 E73.92963 F2400
+G1 X-23.182 Y-6.212 E73.99872 F2400
+G1 X-22.553 Y-8.208 E74.06781 F2400
+G1 X-21.751 Y-10.143 E74.13691 F2400
+G1 X-20.785 Y-12.000 E74.20600 F2400
+G1 X-19.660 Y-13.766 E74.27509 F2400
+G1 X-18.385 Y-15.427 E74.34419 F2400
+G1 X-16.971 Y-16.971 E74.41328 F2400
+G1 X-15.427 Y-18.385 E74.48237 F2400
+G1 X-13.766 Y-19.660 E74.55147 F2400
+G1 X-12.000 Y-20.785 E74.62056 F2400
+G1 X-10.143 Y-21.751 E74.68965 F2400
+G1 X-8.208 Y-22.553 E74.75874 F2400
+G1 X-6.212 Y-23.182 E74.82784 F2400
+G1 X-4.168 Y-23.635 E74.89693 F2400
+G1 X-2.092 Y-23.909 E74.96602 F2400
+G1 X-0.000 Y-24.000 E75.03512 F2400
+G1 X2.092 Y-23.909 E75.10421 F2400
+G1 X4.168 Y-23.635 E75.17330 F2400
+G1 X6.212 Y-23.182 E75.24240 F2400
+G1 X8.208 Y-22.553 E75.31149 F2400
+G1 X10.143 Y-21.751 E75.38058 F2400
+G1 X12.000 Y-20.785 E75.44968 F2400
+G1 X13.766 Y-19.660 E75.51877 F2400
+G1 X15.427 Y-18.385 E75.58786 F2400
+G1 X16.971 Y-16.971 E75.65695 F2400
+G1 X18.385 Y-15.427 E75.72605 F2400
+G1 X19.660 Y-13.766 E75.79514 F2400
+G1 X20.785 Y-12.000 E75.86423 F2400
+G1 X21.751 Y-10.143 E75.93333 F2400
+G1 X22.553 Y-8.208 E76.00242 F2400
+G1 X23.182 Y-6.212 E76.07151 F2400
+G1 X23.635 Y-4.168 E76.14061 F2400
+G1 X23.909 Y-2.092 E76.20970 F2400
+G1 X24.000 Y-0.000 E76.27879 F2400
+G1 X20.000 Y0.000 F9000
+G1 X19.924 Y1.743 E76.33637 F2400
+G1 X19.696 Y3.473 E76.39395 F2400
+G1 X19.319 Y5.176 E76.45153 F2400
+G1 X18.794 Y6.840 E76.50910 F2400
+G1 X18.126 Y8.452 E76.56668 F2400
+G1 X17.321 Y10.000 E76.62426 F2400
+G1 X16.383 Y11.472 E76.68184 F2400
+G1 X15.321 Y12.856 E76.73941 F2400
+G1 X14.142 Y14.142 E76.79699 F2400
+G1 X12.856 Y15.321 E76.85457 F2400
+G1 X11.472 Y16.383 E76.91215 F2400
+G1 X10.000 Y17.321 E76.96972 F2400
+G1 X8.452 Y18.126 E77.02730 F2400
+G1 X6.840 Y18.794 E77.08488 F2400
+G1 X5.176 Y19.319 E77.14246 F2400
+G1 X3.473 Y19.696 E77.20003 F2400
+G1 X1.743 Y19.924 E77.25761 F2400
+G1 X0.000 Y20.000 E77.31519 F2400
+G1 X-1.743 Y19.924 E77.37277 F2400
+G1 X-3.473 Y19.696 E77.43034 F2400
+G1 X-5.176 Y19.319 E77.48792 F2400
+G1 X-6.840 Y18.794 E77.54550 F2400
+G1 X-8.452 Y18.126 E77.60308 F2400
+G1 X-10.000 Y17.321 E77.66066 F2400
+G1 X-11.472 Y16.383 E77.71823 F2400
+G1 X-12.856 Y15.321 E77.77581 F2400
+G1 X-14.142 Y14.142 E77.83339 F2400
+G1 X-15.321 Y12.856 E77.89097 F2400
+G1 X-16.383 Y11.472 E77.94854 F2400
+G1 X-17.321 Y10.000 E78.00612 F2400
+G1 X-18.126 Y8.452 E78.06370 F2400
+G1 X-18.794 Y6.840 E78.12128 F2400
+G1 X-19.319 Y5.176 E78.17885 F2400
+G1 X-19.696 Y3.473 E78.23643 F2400
+G1 X-19.924 Y1.743 E78.29401 F2400
+G1 X-20.000 Y0.000 E78.35159 F2400
+G1 X-19.924 Y-1.743 E78.40916 F2400
+G1 X-19.696 Y-3.473 E78.46674 F2400
+G1 X-19.319 Y-5.176 E78.52432 F2400
+G1 X-18.794 Y-6.840 E78.58190 F2400
+G1 X-18.126 Y-8.452 E78.63947 F2400
+G1 X-17.321 Y-10.000 E78.69705 F2400
+G1 X-16.383 Y-11.472 E78.75463 F2400
+G1 X-15.321 Y-12.856 E78.81221 F2400
+G1 X-14.142 Y-14.142 E78.86978 F2400
+G1 X-12.856 Y-15.321 E78.92736 F2400
+G1 X-11.472 Y-16.383 E78.98494 F2400
+G1 X-10.000 Y-17.321 E79.04252 F2400
+G1 X-8.452 Y-18.126 E79.10009 F2400
+G1 X-6.840 Y-18.794 E79.15767 F2400
+G1 X-5.176 Y-19.319 E79.21525 F2400
+G1 X-3.473 Y-19.696 E79.27283 F2400
+G1 X-1.743 Y-19.924 E79.33041 F2400
+G1 X-0.000 Y-20.000 E79.38798 F2400
+G1 X1.743 Y-19.924 E79.44556 F2400
+G1 X3.473 Y-19.696 E79.50314 F2400
+G1 X5.176 Y-19.319 E79.56072 F2400
+G1 X6.840 Y-18.794 E79.61829 F2400
+G1 X8.452 Y-18.126 E79.67587 F2400
+G1 X10.000 Y-17.321 E79.73345 F2400
+G1 X11.472 Y-16.383 E79.79103 F2400
+G1 X12.856 Y-15.321 E79.84860 F2400
+G1 X14.142 Y-14.142 E79.90618 F2400
+G1 X15.321 Y-12.856 E79.96376 F2400
+G1 X16.383 Y-11.472 E80.02134 F2400
+G1 X17.321 Y-10.000 E80.07891 F2400
+G1 X18.126 Y-8.452 E80.13649 F2400
+G1 X18.794 Y-6.840 E80.19407 F2400
+G1 X19.319 Y-5.176 E80.25165 F2400
+G1 X19.696 Y-3.473 E80.30922 F2400
+G1 X19.924 Y-1.743 E80.36680 F2400
+G1 X20.000 Y-0.000 E80.42438 F2400
+G1 X16.000 Y0.000 F9000
+G1 X15.939 Y1.394 E80.47044 F2400
+G1 X15.757 Y2.778 E80.51650 F2400
+G1 X15.455 Y4.141 E80.56257 F2400
+G1 X15.035 Y5.472 E80.60863 F2400
+G1 X14.501 Y6.762 E80.65469 F2400
+G1 X13.856 Y8.000 E80.70075 F2400
+G1 X13.106 Y9.177 E80.74681 F2400
+G1 X12.257 Y10.285 E80.79288 F2400
+G1 X11.314 Y11.314 E80.83894 F2400
+G1 X10.285 Y12.257 E80.88500 F2400
+G1 X9.177 Y13.106 E80.93106 F2400
+G1 X8.000 Y13.856 E80.97712 F2400
+G1 X6.762 Y14.501 E81.02319 F2400
+G1 X5.472 Y15.035 E81.06925 F2400
+G1 X4.141 Y15.455 E81.11531 F2400
+G1 X2.778 Y15.757 E81.16137 F2400
+G1 X1.394 Y15.939 E81.20743 F2400
+G1 X0.000 Y16.000 E81.25350 F2400
+G1 X-1.394 Y15.939 E81.29956 F2400
+G1 X-2.778 Y15.757 E81.34562 F2400
+G1 X-4.141 Y15.455 E81.39168 F2400
+G1 X-5.472 Y15.035 E81.43775 F2400
+G1 X-6.762 Y14.501 E81.48381 F2400
+G1 X-8.000 Y13.856 E81.52987 F2400
+G1 X-9.177 Y13.106 E81.57593 F2400
+G1 X-10.285 Y12.257 E81.62199 F2400
+G1 X-11.314 Y11.314 E81.66806 F2400
+G1 X-12.257 Y10.285 E81.71412 F2400
+G1 X-13.106 Y9.177 E81.76018 F2400
+G1 X-13.856 Y8.000 E81.80624 F2400
+G1 X-14.501 Y6.762 E81.85230 F2400
+G1 X-15.035 Y5.472 E81.89837 F2400
+G1 X-15.455 Y4.141 E81.94443 F2400
+G1 X-15.757 Y2.778 E81.99049 F2400
+G1 X-15.939 Y1.394 E82.03655 F2400
+G1 X-16.000 Y0.000 E82.08261 F2400
+G1 X-15.939 Y-1.394 E82.12868 F2400
+G1 X-15.757 Y-2.778 E82.17474 F2400
+G1 X-15.455 Y-4.141 E82.22080 F2400
+G1 X-15.035 Y-5.472 E82.26686 F2400
+G1 X-14.501 Y-6.762 E82.31292 F2400
+G1 X-13.856 Y-8.000 E82.35899 F2400
+G1 X-13.106 Y-9.177 E82.40505 F2400
+G1 X-12.257 Y-10.285 E82.45111 F2400
+G1 X-11.314 Y-11.314 E82.49717 F2400
+G1 X-10.285 Y-12.257 E82.54323 F2400
+G1 X-9.177 Y-13.106 E82.58930 F2400
+G1 X-8.000 Y-13.856 E82.63536 F2400
+G1 X-6.762 Y-14.501 E82.68142 F2400
+G1 X-5.472 Y-15.035 E82.72748 F2400
+G1 X-4.141 Y-15.455 E82.77355 F2400
+G1 X-2.778 Y-15.757 E82.81961 F2400
+G1 X-1.394 Y-15.939 E82.86567 F2400
+G1 X-0.000 Y-16.000 E82.91173 F2400
+G1 X1.394 Y-15.939 E82.95779 F2400
+G1 X2.778 Y-15.757 E83.00386 F2400
+G1 X4.141 Y-15.455 E83.04992 F2400
+G1 X5.472 Y-15.035 E83.09598 F2400
+G1 X6.762 Y-14.501 E83.14204 F2400
+G1 X8.000 Y-13.856 E83.18810 F2400
+G1 X9.177 Y-13.106 E83.23417 F2400
+G1 X10.285 Y-12.257 E83.28023 F2400
+G1 X11.314 Y-11.314 E83.32629 F2400
+G1 X12.257 Y-10.285 E83.37235 F2400
+G1 X13.106 Y-9.177 E83.41841 F2400
+G1 X13.856 Y-8.000 E83.46448 F2400
+G1 X14.501 Y-6.762 E83.51054 F2400
+G1 X15.035 Y-5.472 E83.55660 F2400
+G1 X15.455 Y-4.141 E83.60266 F2400
+G1 X15.757 Y-2.778 E83.64872 F2400
+G1 X15.939 Y-1.394 E83.69479 F2400
+G1 X16.000 Y-0.000 E83.74085 F2400
+G1 X12.000 Y0.000 F9000
+G1 X11.954 Y1.046 E83.77540 F2400
+G1 X11.818 Y2.084 E83.80994 F2400
+G1 X11.591 Y3.106 E83.84449 F2400
+G1 X11.276 Y4.104 E83.87904 F2400
+G1 X10.876 Y5.071 E83.91358 F2400
+G1 X10.392 Y6.000 E83.94813 F2400
+G1 X9.830 Y6.883 E83.98267 F2400
+G1 X9.193 Y7.713 E84.01722 F2400
+G1 X8.485 Y8.485 E84.05177 F2400
+G1 X7.713 Y9.193 E84.08631 F2400
+G1 X6.883 Y9.830 E84.12086 F2400
+G1 X6.000 Y10.392 E84.15541 F2400
+G1 X5.071 Y10.876 E84.18995 F2400
+G1 X4.104 Y11.276 E84.22450 F2400
+G1 X3.106 Y11.591 E84.25905 F2400
+G1 X2.084 Y11.818 E84.29359 F2400
+G1 X1.046 Y11.954 E84.32814 F2400
+G1 X0.000 Y12.000 E84.36269 F2400
+G1 X-1.046 Y11.954 E84.39723 F2400
+G1 X-2.084 Y11.818 E84.43178 F2400
+G1 X-3.106 Y11.591 E84.46633 F2400
+G1 X-4.104 Y11.276 E84.50087 F2400
+G1 X-5.071 Y10.876 E84.53542 F2400
+G1 X-6.000 Y10.392 E84.56997 F2400
+G1 X-6.883 Y9.830 E84.60451 F2400
+G1 X-7.713 Y9.193 E84.63906 F2400
+G1 X-8.485 Y8.485 E84.67361 F2400
+G1 X-9.193 Y7.713 E84.70815 F2400
+G1 X-9.830 Y6.883 E84.74270 F2400
+G1 X-10.392 Y6.000 E84.77725 F2400
+G1 X-10.876 Y5.071 E84.81179 F2400
+G1 X-11.276 Y4.104 E84.84634 F2400
+G1 X-11.591 Y3.106 E84.88089 F2400
+G1 X-11.818 Y2.084 E84.91543 F2400
+G1 X-11.954 Y1.046 E84.94998 F2400
+G1 X-12.000 Y0.000 E84.98452 F2400
+G1 X-11.954 Y-1.046 E85.01907 F2400
+G1 X-11.818 Y-2.084 E85.05362 F2400
+G1 X-11.591 Y-3.106 E85.08816 F2400
+G1 X-11.276 Y-4.104 E85.12271 F2400
+G1 X-10.876 Y-5.071 E85.15726 F2400
+G1 X-10.392 Y-6.000 E85.19180 F2400
+G1 X-9.830 Y-6.883 E85.22635 F2400
+G1 X-9.193 Y-7.713 E85.26090 F2400
+G1 X-8.485 Y-8.485 E85.29544 F2400
+G1 X-7.713 Y-9.193 E85.32999 F2400
+G1 X-6.883 Y-9.830 E85.36454 F2400
+G1 X-6.000 Y-10.392 E85.39908 F2400
+G1 X-5.071 Y-10.876 E85.43363 F2400
+G1 X-4.104 Y-11.276 E85.46818 F2400
+G1 X-3.106 Y-11.591 E85.50272 F2400
+G1 X-2.084 Y-11.818 E85.53727 F2400
+G1 X-1.046 Y-11.954 E85.57182 F2400
+G1 X-0.000 Y-12.000 E85.60636 F2400
+G1 X1.046 Y-11.954 E85.64091 F2400
+G1 X2.084 Y-11.818 E85.67546 F2400
+G1 X3.106 Y-11.591 E85.71000 F2400
+G1 X4.104 Y-11.276 E85.74455 F2400
+G1 X5.071 Y-10.876 E85.77910 F2400
+G1 X6.000 Y-10.392 E85.81364 F2400
+G1 X6.883 Y-9.830 E85.84819 F2400
+G1 X7.713 Y-9.193 E85.88274 F2400
+G1 X8.485 Y-8.485 E85.91728 F2400
+G1 X9.193 Y-7.713 E85.95183 F2400
+G1 X9.830 Y-6.883 E85.98637 F2400
+G1 X10.392 Y-6.000 E86.02092 F2400
+G1 X10.876 Y-5.071 E86.05547 F2400
+G1 X11.276 Y-4.104 E86.09001 F2400
+G1 X11.591 Y-3.106 E86.12456 F2400
+G1 X11.818 Y-2.084 E86.15911 F2400
+G1 X11.954 Y-1.046 E86.19365 F2400
+G1 X12.000 Y-0.000 E86.22820 F2400
+G1 Z0.70 F3000
+G1 X40.000 Y0.000 F9000
+G1 X39.848 Y3.486 E86.34336 F2400
+G1 X39.392 Y6.946 E86.45851 F2400
+G1 X38.637 Y10.353 E86.57367 F2400
+G1 X37.588 Y13.681 E86.68882 F2400
+G1 X36.252 Y16.905 E86.80398 F2400
+G1 X34.641 Y20.000 E86.91913 F2400
+G1 X32.766 Y22.943 E87.03429 F2400
+G1 X30.642 Y25.712 E87.14944 F2400
+G1 X28.284 Y28.284 E87.26460 F2400
+G1 X25.712 Y30.642 E87.37975 F2400
+G1 X22.943 Y32.766 E87.49491 F2400
+G1 X20.000 Y34.641 E87.61006 F2400
+G1 X16.905 Y36.252 E87.72522 F2400
+G1 X13.681 Y37.588 E87.84037 F2400
+G1 X10.353 Y38.637 E87.95553 F2400
+G1 X6.946 Y39.392 E88.07068 F2400
+G1 X3.486 Y39.848 E88.18584 F2400
+G1 X0.000 Y40.000 E88.30099 F2400
+G1 X-3.486 Y39.848 E88.41615 F2400
+G1 X-6.946 Y39.392 E88.53130 F2400
+G1 X-10.353 Y38.637 E88.64646 F2400
+G1 X-13.681 Y37.588 E88.76161 F2400
+G1 X-16.905 Y36.252 E88.87677 F2400
+G1 X-20.000 Y34.641 E88.99193 F2400
+G1 X-22.943 Y32.766 E89.10708 F2400
+G1 X-25.712 Y30.642 E89.22224 F2400
+G1 X-28.284 Y28.284 E89.33739 F2400
+G1 X-30.642 Y25.712 E89.45255 F2400
+G1 X-32.766 Y22.943 E89.56770 F2400
+G1 X-34.641 Y20.000 E89.68286 F2400
+G1 X-36.252 Y16.905 E89.79801 F2400
+G1 X-37.588 Y13.681 E89.91317 F2400
+G1 X-38.637 Y10.353 E90.02832 F2400
+G1 X-39.392 Y6.946 E90.14348 F2400
+G1 X-39.848 Y3.486 E90.25863 F2400
+G1 X-40.000 Y0.000 E90.37379 F2400
+G1 X-39.848 Y-3.486 E90.48894 F2400
+G1 X-39.392 Y-6.946 E90.60410 F2400
+G1 X-38.637 Y-10.353 E90.71925 F2400
+G1 X-37.588 Y-13.681 E90.83441 F2400
+G1 X-36.252 Y-16.905 E90.94956 F2400
+G1 X-34.641 Y-20.000 E91.06472 F2400
+G1 X-32.766 Y-22.943 E91.17987 F2400
+G1 X-30.642 Y-25.712 E91.29503 F2400
+G1 X-28.284 Y-28.284 E91.41018 F2400
+G1 X-25.712 Y-30.642 E91.52534 F2400
+G1 X-22.943 Y-32.766 E91.64049 F2400
+G1 X-20.000 Y-34.641 E91.75565 F2400
+G1 X-16.905 Y-36.252 E91.87080 F2400
+G1 X-13.681 Y-37.588 E91.98596 F2400
+G1 X-10.353 Y-38.637 E92.10112 F2400
+G1 X-6.946 Y-39.392 E92.21627 F2400
+G1 X-3.486 Y-39.848 E92.33143 F2400
+G1 X-0.000 Y-40.000 E92.44658 F2400
+G1 X3.486 Y-39.848 E92.56174 F2400
+G1 X6.946 Y-39.392 E92.67689 F2400
+G1 X10.353 Y-38.637 E92.79205 F2400
+G1 X13.681 Y-37.588 E92.90720 F2400
+G1 X16.905 Y-36.252 E93.02236 F2400
+G1 X20.000 Y-34.641 E93.13751 F2400
+G1 X22.943 Y-32.766 E93.25267 F2400
+G1 X25.712 Y-30.642 E93.36782 F2400
+G1 X28.284 Y-28.284 E93.48298 F2400
+G1 X30.642 Y-25.712 E93.59813 F2400
+G1 X32.766 Y-22.943 E93.71329 F2400
+G1 X34.641 Y-20.000 E93.82844 F2400
+G1 X36.252 Y-16.905 E93.94360 F2400
+G1 X37.588 Y-13.681 E94.05875 F2400
+G1 X38.637 Y-10.353 E94.17391 F2400
+G1 X39.392 Y-6.946 E94.28906 F2400
+G1 X39.848 Y-3.486 E94.40422 F2400
+G1 X40.000 Y-0.000 E94.51937 F2400
+G1 X36.000 Y0.000 F9000
+G1 X35.863 Y3.138 E94.62301 F2400
+G1 X35.453 Y6.251 E94.72665 F2400
+G1 X34.773 Y9.317 E94.83029 F2400
+G1 X33.829 Y12.313 E94.93393 F2400
+G1 X32.627 Y15.214 E95.03757 F2400
+G1 X31.177 Y18.000 E95.14121 F2400
+G1 X29.489 Y20.649 E95.24485 F2400
+G1 X27.578 Y23.140 E95.34849 F2400
+G1 X25.456 Y25.456 E95.45213 F2400
+G1 X23.140 Y27.578 E95.55577 F2400
+G1 X20.649 Y29.489 E95.65941 F2400
+G1 X18.000 Y31.177 E95.76305 F2400
+G1 X15.214 Y32.627 E95.86669 F2400
+G1 X12.313 Y33.829 E95.97033 F2400
+G1 X9.317 Y34.773 E96.07397 F2400
+G1 X6.251 Y35.453 E96.17761 F2400
+G1 X3.138 Y35.863 E96.28125 F2400
+G1 X0.000 Y36.000 E96.38489 F2400
+G1 X-3.138 Y35.863 E96.48853 F2400
+G1 X-6.251 Y35.453 E96.59217 F2400
+G1 X-9.317 Y34.773 E96.69581 F2400
+G1 X-12.313 Y33.829 E96.79945 F2400
+G1 X-15.214 Y32.627 E96.90309 F2400
+G1 X-18.000 Y31.177 E97.00673 F2400
+G1 X-20.649 Y29.489 E97.11037 F2400
+G1 X-23.140 Y27.578 E97.21401 F2400
+G1 X-25.456 Y25.456 E97.31764 F2400
+G1 X-27.578 Y23.140 E97.42128 F2400
+G1 X-29.489 Y20.649 E97.52492 F2400
+G1 X-31.177 Y18.000 E97.62856 F2400
+G1 X-32.627 Y15.214 E97.73220 F2400
+G1 X-33.829 Y12.313 E97.83584 F2400
+G1 X-34.773 Y9.317 E97.93948 F2400
+G1 X-35.453 Y6.251 E98.04312 F2400
+G1 X-35.863 Y3.138 E98.14676 F2400
+G1 X-36.000 Y0.000 E98.25040 F2400
+G1 X-35.863 Y-3.138 E98.35404 F2400
+G1 X-35.453 Y-6.251 E98.45768 F2400
+G1 X-34.773 Y-9.317 E98.56132 F2400
+G1 X-33.829 Y-12.313 E98.66496 F2400
+G1 X-32.627 Y-15.214 E98.76860 F2400
+G1 X-31.177 Y-18.000 E98.87224 F2400
+G1 X-29.489 Y-20.649 E98.97588 F2400
+G1 X-27.578 Y-23.140 E99.07952 F2400
+G1 X-25.456 Y-25.456 E99.18316 F2400
+G1 X-23.140 Y-27.578 E99.28680 F2400
+G1 X-20.649 Y-29.489 E99.39044 F2400
+G1 X-18.000 Y-31.177 E99.49408 F2400
+G1 X-15.214 Y-32.627 E99.59772 F2400
+G1 X-12.313 Y-33.829 E99.70136 F2400
+G1 X-9.317 Y-34.773 E99.80500 F2400
+G1 X-6.251 Y-35.453 E99.90864 F2400
+G1 X-3.138 Y-35.863 E100.01228 F2400
+G1 X-0.000 Y-36.000 E100.11592 F2400
+G1 X3.138 Y-35.863 E100.21956 F2400
+G1 X6.251 Y-35.453 E100.32320 F2400
+G1 X9.317 Y-34.773 E100.42683 F2400
+G1 X12.313 Y-33.829 E100.53047 F2400
+G1 X15.214 Y-32.627 E100.63411 F2400
+G1 X18.000 Y-31.177 E100.73775 F2400
+G1 X20.649 Y-29.489 E100.84139 F2400
+G1 X23.140 Y-27.578 E100.94503 F2400
+G1 X25.456 Y-25.456 E101.04867 F2400
+G1 X27.578 Y-23.140 E101.15231 F2400
+G1 X29.489 Y-20.649 E101.25595 F2400
+G1 X31.177 Y-18.000 E101.35959 F2400
+G1 X32.627 Y-15.214 E101.46323 F2400
+G1 X33.829 Y-12.313 E101.56687 F2400
+G1 X34.773 Y-9.317 E101.67051 F2400
+G1 X35.453 Y-6.251 E101.77415 F2400
+G1 X35.863 Y-3.138 E101.87779 F2400
+G1 X36.000 Y-0.000 E101.98143 F2400
+G1 X32.000 Y0.000 F9000
+G1 X31.878 Y2.789 E102.07355 F2400
+G1 X31.514 Y5.557 E102.16568 F2400
+G1 X30.910 Y8.282 E102.25780 F2400
+G1 X30.070 Y10.945 E102.34993 F2400
+G1 X29.002 Y13.524 E102.44205 F2400
+G1 X27.713 Y16.000 E102.53417 F2400
+G1 X26.213 Y18.354 E102.62630 F2400
+G1 X24.513 Y20.569 E102.71842 F2400
+G1 X22.627 Y22.627 E102.81055 F2400
+G1 X20.569 Y24.513 E102.90267 F2400
+G1 X18.354 Y26.213 E102.99480 F2400
+G1 X16.000 Y27.713 E103.08692 F2400
+G1 X13.524 Y29.002 E103.17904 F2400
+G1 X10.945 Y30.070 E103.27117 F2400
+G1 X8.282 Y30.910 E103.36329 F2400
+G1 X5.557 Y31.514 E103.45542 F2400
+G1 X2.789 Y31.878 E103.54754 F2400
+G1 X0.000 Y32.000 E103.63966 F2400
+G1 X-2.789 Y31.878 E103.73179 F2400
+G1 X-5.557 Y31.514 E103.82391 F2400
+G1 X-8.282 Y30.910 E103.91604 F2400
+G1 X-10.945 Y30.070 E104.00816 F2400
+G1 X-13.524 Y29.002 E104.10029 F2400
+G1 X-16.000 Y27.713 E104.19241 F2400
+G1 X-18.354 Y26.213 E104.28453 F2400
+G1 X-20.569 Y24.513 E104.37666 F2400
+G1 X-22.627 Y22.627 E104.46878 F2400
+G1 X-24.513 Y20.569 E104.56091 F2400
+G1 X-26.213 Y18.354 E104.65303 F2400
+G1 X-27.713 Y16.000 E104.74515 F2400
+G1 X-29.002 Y13.524 E104.83728 F2400
+G1 X-30.070 Y10.945 E104.92940 F2400
+G1 X-30.910 Y8.282 E105.02153 F2400
+G1 X-31.514 Y5.557 E105.11365 F2400
+G1 X-31.878 Y2.789 E105.20577 F2400
+G1 X-32.000 Y0.000 E105.29790 F2400
+G1 X-31.878 Y-2.789 E105.39002 F2400
+G1 X-31.514 Y-5.557 E105.48215 F2400
+G1 X-30.910 Y-8.282 E105.57427 F2400
+G1 X-30.070 Y-10.945 E105.66640 F2400
+G1 X-29.002 Y-13.524 E105.75852 F2400
+G1 X-27.713 Y-16.000 E105.85064 F2400
+G1 X-26.213 Y-18.354 E105.94277 F2400
+G1 X-24.513 Y-20.569 E106.03489 F2400
+G1 X-22.627 Y-22.627 E106.12702 F2400
+G1 X-20.569 Y-24.513 E106.21914 F2400
+G1 X-18.354 Y-26.213 E106.31126 F2400
+G1 X-16.000 Y-27.713 E106.40339 F2400
+G1 X-13.524 Y-29.002 E106.49551 F2400
+G1 X-10.945 Y-30.070 E106.58764 F2400
+G1 X-8.282 Y-30.910 E106.67976 F2400
+G1 X-5.557 Y-31.514 E106.77189 F2400
+G1 X-2.789 Y-31.878 E106.86401 F2400
+G1 X-0.000 Y-32.000 E106.95613 F2400
+G1 X2.789 Y-31.878 E107.04826 F2400
+G1 X5.557 Y-31.514 E107.14038 F2400
+G1 X8.282 Y-30.910 E107.23251 F2400
+G1 X10.945 Y-30.070 E107.32463 F2400
+G1 X13.524 Y-29.002 E107.41675 F2400
+G1 X16.000 Y-27.713 E107.50888 F2400
+G1 X18.354 Y-26.213 E107.60100 F2400
+G1 X20.569 Y-24.513 E107.69313 F2400
+G1 X22.627 Y-22.627 E107.78525 F2400
+G1 X24.513 Y-20.569 E107.87738 F2400
+G1 X26.213 Y-18.354 E107.96950 F2400
+G1 X27.713 Y-16.000 E108.06162 F2400
+G1 X29.002 Y-13.524 E108.15375 F2400
+G1 X30.070 Y-10.945 E108.24587 F2400
+G1 X30.910 Y-8.282 E108.33800 F2400
+G1 X31.514 Y-5.557 E108.43012 F2400
+G1 X31.878 Y-2.789 E108.52224 F2400
+G1 X32.000 Y-0.000 E108.61437 F2400
+G1 X28.000 Y0.000 F9000
+G1 X27.893 Y2.440 E108.69498 F2400
+G1 X27.575 Y4.862 E108.77559 F2400
+G1 X27.046 Y7.247 E108.85619 F2400
+G1 X26.311 Y9.577 E108.93680 F2400
+G1 X25.377 Y11.833 E109.01741 F2400
+G1 X24.249 Y14.000 E109.09802 F2400
+G1 X22.936 Y16.060 E109.17863 F2400
+G1 X21.449 Y17.998 E109.25924 F2400
+G1 X19.799 Y19.799 E109.33985 F2400
+G1 X17.998 Y21.449 E109.42045 F2400
+G1 X16.060 Y22.936 E109.50106 F2400
+G1 X14.000 Y24.249 E109.58167 F2400
+G1 X11.833 Y25.377 E109.66228 F2400
+G1 X9.577 Y26.311 E109.74289 F2400
+G1 X7.247 Y27.046 E109.82350 F2400
+G1 X4.862 Y27.575 E109.90411 F2400
+G1 X2.440 Y27.893 E109.98471 F2400
+G1 X0.000 Y28.000 E110.06532 F2400
+G1 X-2.440 Y27.893 E110.14593 F2400
+G1 X-4.862 Y27.575 E110.22654 F2400
+G1 X-7.247 Y27.046 E110.30715 F2400
+G1 X-9.577 Y26.311 E110.38776 F2400
+G1 X-11.833 Y25.377 E110.46837 F2400
+G1 X-14.000 Y24.249 E110.54898 F2400
+G1 X-16.060 Y22.936 E110.62958 F2400
+G1 X-17.998 Y21.449 E110.71019 F2400
+G1 X-19.799 Y19.799 E110.79080 F2400
+G1 X-21.449 Y17.998 E110.87141 F2400
+G1 X-22.936 Y16.060 E110.95202 F2400
+G1 X-24.249 Y14.000 E111.03263 F2400
+G1 X-25.377 Y11.833 E111.11324 F2400
+G1 X-26.311 Y9.577 E111.19384 F2400
+G1 X-27.046 Y7.247 E111.27445 F2400
+G1 X-27.575 Y4.862 E111.35506 F2400
+G1 X-27.893 Y2.440 E111.43567 F2400
+G1 X-28.000 Y0.000 E111.51628 F2400
+G1 X-27.893 Y-2.440 E111.59689 F2400
+G1 X-27.575 Y-4.862 E111.67750 F2400
+G1 X-27.046 Y-7.247 E111.75810 F2400
+G1 X-26.311 Y-9.577 E111.83871 F2400
+G1 X-25.377 Y-11.833 E111.91932 F2400
+G1 X-24.249 Y-14.000 E111.99993 F2400
+G1 X-22.936 Y-16.060 E112.08054 F2400
+G1 X-21.449 Y-17.998 E112.16115 F2400
+G1 X-19.799 Y-19.799 E112.24176 F2400
+G1 X-17.998 Y-21.449 E112.32237 F2400
+G1 X-16.060 Y-22.936 E112.40297 F2400
+G1 X-14.000 Y-24.249 E112.48358 F2400
+G1 X-11.833 Y-25.377 E112.56419 F2400
+G1 X-9.577 Y-26.311 E112.64480 F2400
+G1 X-7.247 Y-27.046 E112.72541 F2400
+G1 X-4.862 Y-27.575 E112.80602 F2400
+G1 X-2.440 Y-27.893 E112.88663 F2400
+G1 X-0.000 Y-28.000 E112.96723 F2400
+G1 X2.440 Y-27.893 E113.04784 F2400
+G1 X4.862 Y-27.575 E113.12845 F2400
+G1 X7.247 Y-27.046 E113.20906 F2400
+G1 X9.577 Y-26.311 E113.28967 F2400
+G1 X11.833 Y-25.377 E113.37028 F2400
+G1 X14.000 Y-24.249 E113.45089 F2400
+G1 X16.060 Y-22.936 E113.53149 F2400
+G1 X17.998 Y-21.449 E113.61210 F2400
+G1 X19.799 Y-19.799 E113.69271 F2400
+G1 X21.449 Y-17.998 E113.77332 F2400
+G1 X22.936 Y-16.060 E113.85393 F2400
+G1 X24.249 Y-14.000 E113.93454 F2400
+G1 X25.377 Y-11.833 E114.01515 F2400
+G1 X26.311 Y-9.577 E114.09575 F2400
+G1 X27.046 Y-7.247 E114.17636 F2400
+G1 X27.575 Y-4.862 E114.25697 F2400
+G1 X27.893 Y-2.440 E114.33758 F2400
+G1 X28.000 Y-0.000 E114.41819 F2400
+G1 X24.000 Y0.000 F9000
+G1 X23.909 Y2.092 E114.48728 F2400
+G1 X23.635 Y4.168 E114.55638 F2400
+G1 X23.182 Y6.212 E114.62547 F2400
+G1 X22.553 Y8.208 E114.69456 F2400
+G1 X21.751 Y10.143 E114.76366 F2400
+G1 X20.785 Y12.000 E114.83275 F2400
+G1 X19.660 Y13.766 E114.90184 F2400
+G1 X18.385 Y15.427 E114.97093 F2400
+G1 X16.971 Y16.971 E115.04003 F2400
+G1 X15.427 Y18.385 E115.10912 F2400
+G1 X13.766 Y19.660 E115.17821 F2400
+G1 X12.000 Y20.785 E115.24731 F2400
+G1 X10.143 Y21.751 E115.31640 F2400
+G1 X8.208 Y22.553 E115.38549 F2400
+G1 X6.212 Y23.182 E115.45459 F2400
+G1 X4.168 Y23.635 E115.52368 F2400
+G1 X2.092 Y23.909 E115.59277 F2400
+G1 X0.000 Y24.000 E115.66187 F2400
+G1 X-2.092 Y23.909 E115.73096 F2400
+G1 X-4.168 Y23.635 E115.80005 F2400
+G1 X-6.212 Y23.182 E115.86914 F2400
+G1 X-8.208 Y22.553 E115.93824 F2400
+G1 X-10.143 Y21.751 E116.00733 F2400
+G1 X-12.000 Y20.785 E116.07642 F2400
+G1 X-13.766 Y19.660 E116.14552 F2400
+G1 X-15.427 Y18.385 E116.21461 F2400
+G1 X-16.971 Y16.971 E116.28370 F2400
+G1 X-18.385 Y15.427 E116.35280 F2400
+G1 X-19.660 Y13.766 E116.42189 F2400
+G1 X-20.785 Y12.000 E116.49098 F2400
+G1 X-21.751 Y10.143 E116.56008 F2400
+G1 X-22.553 Y8.208 E116.62917 F2400
+G1 X-23.182 Y6.212 E116.69826 F2400
+G1 X-23.635 Y4.168 E116.76736 F2400
+G1 X-23.909 Y2.092 E116.83645 F2400
+G1 X-24.000 Y0.000 E116.90554 F2400
+G1 X-23.909 Y-2.092 E116.97463 F2400
+G1 X-23.635 Y-4.168 E117.04373 F2400
+G1 X-23.182 Y-6.212 E117.11282 F2400
+G1 X-22.553 Y-8.208 E117.18191 F2400
+G1 X-21.751 Y-10.143 E117.25101 F2400
+G1 X-20.785 Y-12.000 E117.32010 F2400
+G1 X-19.660 Y-13.766 E117.38919 F2400
+G1 X-18.385 Y-15.427 E117.45829 F2400
+G1 X-16.971 Y-16.971 E117.52738 F2400
+G1 X-15.427 Y-18.385 E117.59647 F2400
+G1 X-13.766 Y-19.660 E117.66557 F2400
+G1 X-12.000 Y-20.785 E117.73466 F2400
+G1 X-10.143 Y-21.751 E117.80375 F2400
+G1 X-8.208 Y-22.553 E117.87284 F2400
+G1 X-6.212 Y-23.182 E117.94194 F2400
+G1 X-4.168 Y-23.635 E118.01103 F2400
+G1 X-2.092 Y-23.909 E118.08012 F2400
+G1 X-0.000 Y-24.000 E118.14922 F2400
+G1 X2.092 Y-23.909 E118.21831 F2400
+G1 X4.168 Y-23.635 E118.28740 F2400
+G1 X6.212 Y-23.182 E118.35650 F2400
+G1 X8.208 Y-22.553 E118.42559 F2400
+G1 X10.143 Y-21.751 E118.49468 F2400
+G1 X12.000 Y-20.785 E118.56378 F2400
+G1 X13.766 Y-19.660 E118.63287 F2400
+G1 X15.427 Y-18.385 E118.70196 F2400
+G1 X16.971 Y-16.971 E118.77106 F2400
+G1 X18.385 Y-15.427 E118.84015 F2400
+G1 X19.660 Y-13.766 E118.90924 F2400
+G1 X20.785 Y-12.000 E118.97833 F2400
+G1 X21.751 Y-10.143 E119.04743 F2400
+G1 X22.553 Y-8.208 E119.11652 F2400
+G1 X23.182 Y-6.212 E119.18561 F2400
+G1 X23.635 Y-4.168 E119.25471 F2400
+G1 X23.909 Y-2.092 E119.32380 F2400
+G1 X24.000 Y-0.000 E119.39289 F2400
+G1 X20.000 Y0.000 F9000
+G1 X19.924 Y1.743 E119.45047 F2400
+G1 X19.696 Y3.473 E119.50805 F2400
+G1 X19.319 Y5.176 E119.56563 F2400
+G1 X18.794 Y6.840 E119.62320 F2400
+G1 X18.126 Y8.452 E119.68078 F2400
+G1 X17.321 Y10.000 E119.73836 F2400
+G1 X16.383 Y11.472 E119.79594 F2400
+G1 X15.321 Y12.856 E119.85351 F2400
+G1 X14.142 Y14.142 E119.91109 F2400
+G1 X12.856 Y15.321 E119.96867 F2400
+G1 X11.472 Y16.383 E120.02625 F2400
+G1 X10.000 Y17.321 E120.08382 F2400
+G1 X8.452 Y18.126 E120.14140 F2400
+G1 X6.840 Y18.794 E120.19898 F2400
+G1 X5.176 Y19.319 E120.25656 F2400
+G1 X3.473 Y19.696 E120.31413 F2400
+G1 X1.743 Y19.924 E120.37171 F2400
+G1 X0.000 Y20.000 E120.42929 F2400
+G1 X-1.743 Y19.924 E120.48687 F2400
+G1 X-3.473 Y19.696 E120.54445 F2400
+G1 X-5.176 Y19.319 E120.60202 F2400
+G1 X-6.840 Y18.794 E120.65960 F2400
+G1 X-8.452 Y18.126 E120.71718 F2400
+G1 X-10.000 Y17.321 E120.77476 F2400
+G1 X-11.472 Y16.383 E120.83233 F2400
+G1 X-12.856 Y15.321 E120.88991 F2400
+G1 X-14.142 Y14.142 E120.94749 F2400
+G1 X-15.321 Y12.856 E121.00507 F2400
+G1 X-16.383 Y11.472 E121.06264 F2400
+G1 X-17.321 Y10.000 E121.12022 F2400
+G1 X-18.126 Y8.452 E121.17780 F2400
+G1 X-18.794 Y6.840 E121.23538 F2400
+G1 X-19.319 Y5.176 E121.29295 F2400
+G1 X-19.696 Y3.473 E121.35053 F2400
+G1 X-19.924 Y1.743 E121.40811 F2400
+G1 X-20.000 Y0.000 E121.46569 F2400
+G1 X-19.924 Y-1.743 E121.52326 F2400
+G1 X-19.696 Y-3.473 E121.58084 F2400
+G1 X-19.319 Y-5.176 E121.63842 F2400
+G1 X-18.794 Y-6.840 E121.69600 F2400
+G1 X-18.126 Y-8.452 E121.75357 F2400
+G1 X-17.321 Y-10.000 E121.81115 F2400
+G1 X-16.383 Y-11.472 E121.86873 F2400
+G1 X-15.321 Y-12.856 E121.92631 F2400
+G1 X-14.142 Y-14.142 E121.98388 F2400
+G1 X-12.856 Y-15.321 E122.04146 F2400
+G1 X-11.472 Y-16.383 E122.09904 F2400
+G1 X-10.000 Y-17.321 E122.15662 F2400
+G1 X-8.452 Y-18.126 E122.21420 F2400
+G1 X-6.840 Y-18.794 E122.27177 F2400
+G1 X-5.176 Y-19.319 E122.32935 F2400
+G1 X-3.473 Y-19.696 E122.38693 F2400
+G1 X-1.743 Y-19.924 E122.44451 F2400
+G1 X-0.000 Y-20.000 E122.50208 F2400
+G1 X1.743 Y-19.924 E122.55966 F2400
+G1 X3.473 Y-19.696 E122.61724 F2400
+G1 X5.176 Y-19.319 E122.67482 F2400
+G1 X6.840 Y-18.794 E122.73239 F2400
+G1 X8.452 Y-18.126 E122.78997 F2400
+G1 X10.000 Y-17.321 E122.84755 F2400
+G1 X11.472 Y-16.383 E122.90513 F2400
+G1 X12.856 Y-15.321 E122.96270 F2400
+G1 X14.142 Y-14.142 E123.02028 F2400
+G1 X15.321 Y-12.856 E123.07786 F2400
+G1 X16.383 Y-11.472 E123.13544 F2400
+G1 X17.321 Y-10.000 E123.19301 F2400
+G1 X18.126 Y-8.452 E123.25059 F2400
+G1 X18.794 Y-6.840 E123.30817 F2400
+G1 X19.319 Y-5.176 E123.36575 F2400
+G1 X19.696 Y-3.473 E123.42332 F2400
+G1 X19.924 Y-1.743 E123.48090 F2400
+G1 X20.000 Y-0.000 E123.53848 F2400
+G1 X16.000 Y0.000 F9000
+G1 X15.939 Y1.394 E123.58454 F2400
+G1 X15.757 Y2.778 E123.63060 F2400
+G1 X15.455 Y4.141 E123.67667 F2400
+G1 X15.035 Y5.472 E123.72273 F2400
+G1 X14.501 Y6.762 E123.76879 F2400
+G1 X13.856 Y8.000 E123.81485 F2400
+G1 X13.106 Y9.177 E123.86091 F2400
+G1 X12.257 Y10.285 E123.90698 F2400
+G1 X11.314 Y11.314 E123.95304 F2400
+G1 X10.285 Y12.257 E123.99910 F2400
+G1 X9.177 Y13.106 E124.04516 F2400
+G1 X8.000 Y13.856 E124.09122 F2400
+G1 X6.762 Y14.501 E124.13729 F2400
+G1 X5.472 Y15.035 E124.18335 F2400
+G1 X4.141 Y15.455 E124.22941 F2400
+G1 X2.778 Y15.757 E124.27547 F2400
+G1 X1.394 Y15.939 E124.32154 F2400
+G1 X0.000 Y16.000 E124.36760 F2400
+G1 X-1.394 Y15.939 E124.41366 F2400
+G1 X-2.778 Y15.757 E124.45972 F2400
+G1 X-4.141 Y15.455 E124.50578 F2400
+G1 X-5.472 Y15.035 E124.55185 F2400
+G1 X-6.762 Y14.501 E124.59791 F2400
+G1 X-8.000 Y13.856 E124.64397 F2400
+G1 X-9.177 Y13.106 E124.69003 F2400
+G1 X-10.285 Y12.257 E124.73609 F2400
+G1 X-11.314 Y11.314 E124.78216 F2400
+G1 X-12.257 Y10.285 E124.82822 F2400
+G1 X-13.106 Y9.177 E124.87428 F2400
+G1 X-13.856 Y8.000 E124.92034 F2400
+G1 X-14.501 Y6.762 E124.96640 F2400
+G1 X-15.035 Y5.472 E125.01247 F2400
+G1 X-15.455 Y4.141 E125.05853 F2400
+G1 X-15.757 Y2.778 E125.10459 F2400
+G1 X-15.939 Y1.394 E125.15065 F2400
+G1 X-16.000 Y0.000 E125.19671 F2400
+G1 X-15.939 Y-1.394 E125.24278 F2400
+G1 X-15.757 Y-2.778 E125.28884 F2400
+G1 X-15.455 Y-4.141 E125.33490 F2400
+G1 X-15.035 Y-5.472 E125.38096 F2400
+G1 X-14.501 Y-6.762 E125.42702 F2400
+G1 X-13.856 Y-8.000 E125.47309 F2400
+G1 X-13.106 Y-9.177 E125.51915 F2400
+G1 X-12.257 Y-10.285 E125.56521 F2400
+G1 X-11.314 Y-11.314 E125.61127 F2400
+G1 X-10.285 Y-12.257 E125.65734 F2400
+G1 X-9.177 Y-13.106 E125.70340 F2400
+G1 X-8.000 Y-13.856 E125.74946 F2400
+G1 X-6.762 Y-14.501 E125.79552 F2400
+G1 X-5.472 Y-15.035 E125.84158 F2400
+G1 X-4.141 Y-15.455 E125.88765 F2400
+G1 X-2.778 Y-15.757 E125.93371 F2400
+G1 X-1.394 Y-15.939 E125.97977 F2400
+G1 X-0.000 Y-16.000 E126.02583 F2400
+G1 X1.394 Y-15.939 E126.07189 F2400
+G1 X2.778 Y-15.757 E126.11796 F2400
+G1 X4.141 Y-15.455 E126.16402 F2400
+G1 X5.472 Y-15.035 E126.21008 F2400
+G1 X6.762 Y-14.501 E126.25614 F2400
+G1 X8.000 Y-13.856 E126.30220 F2400
+G1 X9.177 Y-13.106 E126.34827 F2400
+G1 X10.285 Y-12.257 E126.39433 F2400
+G1 X11.314 Y-11.314 E126.44039 F2400
+G1 X12.257 Y-10.285 E126.48645 F2400
+G1 X13.106 Y-9.177 E126.53251 F2400
+G1 X13.856 Y-8.000 E126.57858 F2400
+G1 X14.501 Y-6.762 E126.62464 F2400
+G1 X15.035 Y-5.472 E126.67070 F2400
+G1 X15.455 Y-4.141 E126.71676 F2400
+G1 X15.757 Y-2.778 E126.76283 F2400
+G1 X15.939 Y-1.394 E126.80889 F2400
+G1 X16.000 Y-0.000 E126.85495 F2400
+G1 X12.000 Y0.000 F9000
+G1 X11.954 Y1.046 E126.88950 F2400
+G1 X11.818 Y2.084 E126.92404 F2400
+G1 X11.591 Y3.106 E126.95859 F2400
+G1 X11.276 Y4.104 E126.99314 F2400
+G1 X10.876 Y5.071 E127.02768 F2400
+G1 X10.392 Y6.000 E127.06223 F2400
+G1 X9.830 Y6.883 E127.09678 F2400
+G1 X9.193 Y7.713 E127.13132 F2400
+G1 X8.485 Y8.485 E127.16587 F2400
+G1 X7.713 Y9.193 E127.20041 F2400
+G1 X6.883 Y9.830 E127.23496 F2400
+G1 X6.000 Y10.392 E127.26951 F2400
+G1 X5.071 Y10.876 E127.30405 F2400
+G1 X4.104 Y11.276 E127.33860 F2400
+G1 X3.106 Y11.591 E127.37315 F2400
+G1 X2.084 Y11.818 E127.40769 F2400
+G1 X1.046 Y11.954 E127.44224 F2400
+G1 X0.000 Y12.000 E127.47679 F2400
+G1 X-1.046 Y11.954 E127.51133 F2400
+G1 X-2.084 Y11.818 E127.54588 F2400
+G1 X-3.106 Y11.591 E127.58043 F2400
+G1 X-4.104 Y11.276 E127.61497 F2400
+G1 X-5.071 Y10.876 E127.64952 F2400
+G1 X-6.000 Y10.392 E127.68407 F2400
+G1 X-6.883 Y9.830 E127.71861 F2400
+G1 X-7.713 Y9.193 E127.75316 F2400
+G1 X-8.485 Y8.485 E127.78771 F2400
+G1 X-9.193 Y7.713 E127.82225 F2400
+G1 X-9.830 Y6.883 E127.85680 F2400
+G1 X-10.392 Y6.000 E127.89135 F2400
+G1 X-10.876 Y5.071 E127.92589 F2400
+G1 X-11.276 Y4.104 E127.96044 F2400
+G1 X-11.591 Y3.106 E127.99499 F2400
+G1 X-11.818 Y2.084 E128.02953 F2400
+G1 X-11.954 Y1.046 E128.06408 F2400
+G1 X-12.000 Y0.000 E128.09863 F2400
+G1 X-11.954 Y-1.046 E128.13317 F2400
+G1 X-11.818 Y-2.084 E128.16772 F2400
+G1 X-11.591 Y-3.106 E128.20226 F2400
+G1 X-11.276 Y-4.104 E128.23681 F2400
+G1 X-10.876 Y-5.071 E128.27136 F2400
+G1 X-10.392 Y-6.000 E128.30590 F2400
+G1 X-9.830 Y-6.883 E128.34045 F2400
+G1 X-9.193 Y-7.713 E128.37500 F2400
+G1 X-8.485 Y-8.485 E128.40954 F2400
+G1 X-7.713 Y-9.193 E128.44409 F2400
+G1 X-6.883 Y-9.830 E128.47864 F2400
+G1 X-6.000 Y-10.392 E128.51318 F2400
+G1 X-5.071 Y-10.876 E128.54773 F2400
+G1 X-4.104 Y-11.276 E128.58228 F2400
+G1 X-3.106 Y-11.591 E128.61682 F2400
+G1 X-2.084 Y-11.818 E128.65137 F2400
+G1 X-1.046 Y-11.954 E128.68592 F2400
+G1 X-0.000 Y-12.000 E128.72046 F2400
+G1 X1.046 Y-11.954 E128.75501 F2400
+G1 X2.084 Y-11.818 E128.78956 F2400
+G1 X3.106 Y-11.591 E128.82410 F2400
+G1 X4.104 Y-11.276 E128.85865 F2400
+G1 X5.071 Y-10.876 E128.89320 F2400
+G1 X6.000 Y-10.392 E128.92774 F2400
+G1 X6.883 Y-9.830 E128.96229 F2400
+G1 X7.713 Y-9.193 E128.99684 F2400
+G1 X8.485 Y-8.485 E129.03138 F2400
+G1 X9.193 Y-7.713 E129.06593 F2400
+G1 X9.830 Y-6.883 E129.10048 F2400
+G1 X10.392 Y-6.000 E129.13502 F2400
+G1 X10.876 Y-5.071 E129.16957 F2400
+G1 X11.276 Y-4.104 E129.20411 F2400
+G1 X11.591 Y-3.106 E129.23866 F2400
+G1 X11.818 Y-2.084 E129.27321 F2400
+G1 X11.954 Y-1.046 E129.30775 F2400
+G1 X12.000 Y-0.000 E129.34230 F2400
+G1 Z20 F3000
+M84